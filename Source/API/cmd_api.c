@@ -8,8 +8,11 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdarg.h>
 #include <string.h>
 #include "debug_api.h"
+#include "span_api.h"
+#include "crc.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -17,6 +20,14 @@
 
 #define DEBUG_CMD_API
 
+#define CMD_HASH_OFFSET_BASIS 2166136261U
+#define CMD_HASH_PRIME 16777619U
+#define CMD_ARGUMENTS_SEPARATOR ':'
+#define CMD_ARGUMENT_SEPARATOR ','
+#define CMD_TRIPLET_LENGTH 3U
+#define CMD_FIXED_DIGITS_MAX 9U
+#define CMD_TRIPLET_COMPONENT_MASK 0xFFU
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -26,7 +37,7 @@
  *********************************************************************************************************************/
 
 #ifdef DEBUG_CMD_API
-CREATE_MODULE_NAME (CMD_API)
+CREATE_FRAMEWORK_MODULE_NAME (CMD_API)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
@@ -42,42 +53,745 @@ CREATE_MODULE_NAME_EMPTY
 /**********************************************************************************************************************
  * Prototypes of private functions
  *********************************************************************************************************************/
- 
+
+static uint32_t CMD_API_Hash (const char *token, const size_t token_length);
+static size_t CMD_API_TokenLength (const sMessage_t command);
+static size_t CMD_API_Index_Probe (const sCmdIndex_t *index, const char *token, const size_t token_length);
+static bool CMD_API_NextField (sMessage_t *cursor, bool *has_field, sMessage_t *field);
+static bool CMD_API_ParseDigits (const sMessage_t field, const uint32_t base, uint64_t *value);
+static bool CMD_API_ParseSigned (sMessage_t field, const uint8_t fraction_digits, int64_t *value);
+static bool CMD_API_ParseValue (sMessage_t field, const sCmdArgDesc_t *schema, int64_t *value);
+static bool CMD_API_ParseTriplet (sMessage_t *cursor, bool *has_field, const sCmdArgDesc_t *schema, uint32_t *value, sCmdWriter_t *response);
+static bool CMD_API_IsInRange (const uCmdArg_t value, const sCmdArgDesc_t *schema);
+static bool CMD_API_RunTextHandler (const sCmdDesc_t *command_desc, const sMessage_t arguments, sCmdWriter_t *response);
+#ifdef ENABLE_CLI_RPC
+static uint16_t CMD_API_ReadU16 (const uint8_t *data);
+#endif
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
- 
+
+/* FNV-1a */
+static uint32_t CMD_API_Hash (const char *token, const size_t token_length) {
+    uint32_t hash = CMD_HASH_OFFSET_BASIS;
+
+    for (size_t position = 0; position < token_length; position++) {
+        hash ^= (uint8_t) token[position];
+        hash *= CMD_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+/* The command token runs up to and including the ':' that starts the arguments, or to the end of the message */
+static size_t CMD_API_TokenLength (const sMessage_t command) {
+    const char *separator = memchr(command.data, CMD_ARGUMENTS_SEPARATOR, command.size);
+
+    if (separator == NULL) {
+        return command.size;
+    }
+
+    return (size_t) (separator - command.data) + 1U;
+}
+
+/* Linear probing, returns the slot holding the token or the empty slot where it would go */
+static size_t CMD_API_Index_Probe (const sCmdIndex_t *index, const char *token, const size_t token_length) {
+    size_t slot = CMD_API_Hash(token, token_length) % index->capacity;
+
+    while (index->slot[slot] != NULL) {
+        if ((index->slot[slot]->command_lenght == token_length) && (memcmp(index->slot[slot]->command, token, token_length) == 0)) {
+            break;
+        }
+
+        slot = (slot + 1U) % index->capacity;
+    }
+
+    return slot;
+}
+
+/* Splits off the text up to the next ',', has_field stays set after a trailing ',' so "1," has an empty second field */
+static bool CMD_API_NextField (sMessage_t *cursor, bool *has_field, sMessage_t *field) {
+    if (!*has_field) {
+        return false;
+    }
+
+    const char *separator = memchr(cursor->data, CMD_ARGUMENT_SEPARATOR, cursor->size);
+
+    field->data = cursor->data;
+
+    if (separator == NULL) {
+        field->size = cursor->size;
+        cursor->data += cursor->size;
+        cursor->size = 0;
+        *has_field = false;
+
+        return true;
+    }
+
+    field->size = (size_t) (separator - cursor->data);
+    cursor->data += field->size + 1U;
+    cursor->size -= field->size + 1U;
+
+    return true;
+}
+
+static bool CMD_API_ParseDigits (const sMessage_t field, const uint32_t base, uint64_t *value) {
+    if (field.size == 0) {
+        return false;
+    }
+
+    *value = 0;
+
+    for (size_t position = 0; position < field.size; position++) {
+        char character = field.data[position];
+        uint32_t digit = base;
+
+        if ((character >= '0') && (character <= '9')) {
+            digit = (uint32_t) (character - '0');
+        } else if ((character >= 'a') && (character <= 'f')) {
+            digit = (uint32_t) (character - 'a') + 10U;
+        } else if ((character >= 'A') && (character <= 'F')) {
+            digit = (uint32_t) (character - 'A') + 10U;
+        }
+
+        if (digit >= base) {
+            return false;
+        }
+
+        *value = (*value * base) + digit;
+
+        if (*value > UINT32_MAX) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Optional sign, integer digits and with fraction_digits > 0 an optional '.' followed by at most that many digits */
+static bool CMD_API_ParseSigned (sMessage_t field, const uint8_t fraction_digits, int64_t *value) {
+    bool is_negative = false;
+
+    if ((field.size > 0) && ((field.data[0] == '-') || (field.data[0] == '+'))) {
+        is_negative = (field.data[0] == '-');
+        field.data++;
+        field.size--;
+    }
+
+    sMessage_t integer = field;
+    sMessage_t fraction = {.data = NULL, .size = 0};
+    const char *point = memchr(field.data, '.', field.size);
+
+    if (point != NULL) {
+        integer.size = (size_t) (point - field.data);
+        fraction.data = (char *) point + 1;
+        fraction.size = field.size - integer.size - 1U;
+
+        if ((fraction.size == 0) || (fraction.size > fraction_digits)) {
+            return false;
+        }
+    }
+
+    uint64_t integer_value = 0;
+    uint64_t fraction_value = 0;
+
+    if (!CMD_API_ParseDigits(integer, 10U, &integer_value)) {
+        return false;
+    }
+
+    if ((fraction.size != 0) && !CMD_API_ParseDigits(fraction, 10U, &fraction_value)) {
+        return false;
+    }
+
+    for (size_t digit = 0; digit < fraction_digits; digit++) {
+        integer_value *= 10U;
+
+        if (digit >= fraction.size) {
+            fraction_value *= 10U;
+        }
+    }
+
+    *value = (int64_t) (integer_value + fraction_value);
+
+    if (is_negative) {
+        *value = -*value;
+    }
+
+    return true;
+}
+
+static bool CMD_API_ParseValue (sMessage_t field, const sCmdArgDesc_t *schema, int64_t *value) {
+    uint64_t unsigned_value = 0;
+
+    switch (schema->type) {
+        case eCmdArgType_UInt: {
+            if (!CMD_API_ParseDigits(field, 10U, &unsigned_value)) {
+                return false;
+            }
+
+            *value = (int64_t) unsigned_value;
+
+            return true;
+        }
+        case eCmdArgType_Hex: {
+            if ((field.size > 2) && (field.data[0] == '0') && ((field.data[1] == 'x') || (field.data[1] == 'X'))) {
+                field.data += 2;
+                field.size -= 2;
+            }
+
+            if (!CMD_API_ParseDigits(field, 16U, &unsigned_value)) {
+                return false;
+            }
+
+            *value = (int64_t) unsigned_value;
+
+            return true;
+        }
+        case eCmdArgType_Int: {
+            return CMD_API_ParseSigned(field, 0, value);
+        }
+        case eCmdArgType_Fixed: {
+            return (schema->fraction_digits <= CMD_FIXED_DIGITS_MAX) && CMD_API_ParseSigned(field, schema->fraction_digits, value);
+        }
+        case eCmdArgType_Enum: {
+            for (int64_t name = 0; name <= schema->max; name++) {
+                if ((strlen(schema->names[name]) == field.size) && (memcmp(schema->names[name], field.data, field.size) == 0)) {
+                    *value = name;
+
+                    return true;
+                }
+            }
+
+            /* The index is accepted as well */
+            if (!CMD_API_ParseDigits(field, 10U, &unsigned_value)) {
+                return false;
+            }
+
+            *value = (int64_t) unsigned_value;
+
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+/* Three 0 - 255 components packed into one word, most significant first */
+static bool CMD_API_ParseTriplet (sMessage_t *cursor, bool *has_field, const sCmdArgDesc_t *schema, uint32_t *value, sCmdWriter_t *response) {
+    *value = 0;
+
+    for (size_t component = 0; component < CMD_TRIPLET_LENGTH; component++) {
+        sMessage_t field = {0};
+        uint64_t component_value = 0;
+
+        if (!CMD_API_NextField(cursor, has_field, &field)) {
+            CMD_API_Writer_Printf(response, "Missing argument: %s\n", schema->name);
+
+            return false;
+        }
+
+        if (!CMD_API_ParseDigits(field, 10U, &component_value) || (component_value > (uint64_t) schema->max)) {
+            CMD_API_Writer_Printf(response, "%.*s: Invalid %s\n", (int) field.size, field.data, schema->name);
+
+            return false;
+        }
+
+        *value = (*value << 8) | (uint32_t) component_value;
+    }
+
+    return true;
+}
+
+static bool CMD_API_IsInRange (const uCmdArg_t value, const sCmdArgDesc_t *schema) {
+    switch (schema->type) {
+        case eCmdArgType_Int:
+        case eCmdArgType_Fixed: {
+            return (value.int_value >= schema->min) && (value.int_value <= schema->max);
+        }
+        case eCmdArgType_Rgb:
+        case eCmdArgType_Hsv: {
+            if (value.uint_value > 0x00FFFFFFU) {
+                return false;
+            }
+
+            for (size_t component = 0; component < CMD_TRIPLET_LENGTH; component++) {
+                if (((value.uint_value >> (8U * component)) & CMD_TRIPLET_COMPONENT_MASK) > schema->max) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        default: {
+            return (value.uint_value >= schema->min) && (value.uint_value <= schema->max);
+        }
+    }
+}
+
+/* Handlers that take the raw argument text write their reply into the free part of the writer buffer */
+static bool CMD_API_RunTextHandler (const sCmdDesc_t *command_desc, const sMessage_t arguments, sCmdWriter_t *response) {
+    if (response->sink != NULL) {
+        CMD_API_Writer_Flush(response);
+    }
+
+    sMessage_t text = {.data = &response->buffer[response->length], .size = response->capacity - response->length};
+
+    text.data[0] = '\0';
+
+    bool is_done = command_desc->handler(arguments, &text);
+
+    response->length += strnlen(text.data, text.size - 1U);
+    response->buffer[response->length] = '\0';
+
+    return is_done;
+}
+
+#ifdef ENABLE_CLI_RPC
+static uint16_t CMD_API_ReadU16 (const uint8_t *data) {
+    return (uint16_t) (data[0] | (data[1] << 8));
+}
+#endif
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
-bool CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size) {
-    if ((response == NULL) || (command_lut == NULL)) {
-        TRACE_ERR("Invalid data pointer\n");
+bool CMD_API_Writer_Init (sCmdWriter_t *writer, char *buffer, const size_t capacity, bool (*sink)(const char *data, const size_t size)) {
+    if ((writer == NULL) || (buffer == NULL) || (capacity < 2U)) {
+        return false;
+    }
 
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+    writer->sink = sink;
+
+    CMD_API_Writer_Reset(writer);
+
+    return true;
+}
+
+/**
+ * Text that does not fit into what is left of the buffer is formatted again after a flush. A single write longer
+ * than the whole buffer is cut to the buffer.
+ */
+bool CMD_API_Writer_Printf (sCmdWriter_t *writer, const char *format, ...) {
+    if ((writer == NULL) || (writer->buffer == NULL) || (format == NULL)) {
+        return false;
+    }
+
+    va_list arguments;
+
+    va_start(arguments, format);
+    int length = vsnprintf(&writer->buffer[writer->length], (writer->capacity - writer->length), format, arguments);
+    va_end(arguments);
+
+    if (length < 0) {
+        writer->buffer[writer->length] = '\0';
+
+        return false;
+    }
+
+    if ((size_t) length < (writer->capacity - writer->length)) {
+        writer->length += (size_t) length;
+
+        return true;
+    }
+
+    if ((writer->sink == NULL) || (writer->length == 0)) {
+        writer->length = writer->capacity - 1U;
+        writer->is_truncated = true;
+
+        return false;
+    }
+
+    writer->buffer[writer->length] = '\0';
+
+    if (!CMD_API_Writer_Flush(writer)) {
         return false;
     }
 
-    if (response->data == NULL) {
-        TRACE_ERR("Invalid response data pointer\n");
+    va_start(arguments, format);
+    length = vsnprintf(writer->buffer, writer->capacity, format, arguments);
+    va_end(arguments);
 
+    if (length < 0) {
+        writer->buffer[0] = '\0';
+
+        return false;
+    }
+
+    if ((size_t) length >= writer->capacity) {
+        writer->length = writer->capacity - 1U;
+        writer->is_truncated = true;
+
+        return false;
+    }
+
+    writer->length = (size_t) length;
+
+    return true;
+}
+
+bool CMD_API_Writer_Flush (sCmdWriter_t *writer) {
+    if ((writer == NULL) || (writer->buffer == NULL)) {
         return false;
     }
-    
+
+    if (writer->length == 0) {
+        return true;
+    }
+
+    if (writer->sink == NULL) {
+        return false;
+    }
+
+    bool is_sent = writer->sink(writer->buffer, writer->length);
+
+    writer->length = 0;
+    writer->buffer[0] = '\0';
+
+    return is_sent;
+}
+
+void CMD_API_Writer_Reset (sCmdWriter_t *writer) {
+    if ((writer == NULL) || (writer->buffer == NULL)) {
+        return;
+    }
+
+    writer->length = 0;
+    writer->is_truncated = false;
+    writer->buffer[0] = '\0';
+
+    return;
+}
+
+bool CMD_API_Index_Init (sCmdIndex_t *index, sCmdDesc_t **slot, const size_t capacity) {
+    if ((index == NULL) || (slot == NULL) || (capacity == 0)) {
+        return false;
+    }
+
+    for (size_t position = 0; position < capacity; position++) {
+        slot[position] = NULL;
+    }
+
+    index->slot = slot;
+    index->capacity = capacity;
+    index->count = 0;
+
+    return true;
+}
+
+/* Entry 0 of a command LUT is the unused eCli*Cmd_First, the same command string may only be registered once */
+bool CMD_API_Index_Add (sCmdIndex_t *index, sCmdDesc_t *command_lut, const size_t command_lut_size) {
+    if ((index == NULL) || (index->slot == NULL) || (command_lut == NULL)) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return false;
+    }
+
     for (size_t command_number = 1; command_number < command_lut_size; command_number++) {
-        if (strncmp(command.data, command_lut[command_number].command, command_lut[command_number].command_lenght) != 0) {
+        if ((command_lut[command_number].command == NULL) || ((command_lut[command_number].handler == NULL) && (command_lut[command_number].typed_handler == NULL))) {
+            continue;
+        }
+
+        if (((index->count + 1U) * 2U) >= index->capacity) {
+            TRACE_ERR("Command index full\n");
+
+            return false;
+        }
+
+        size_t slot = CMD_API_Index_Probe(index, command_lut[command_number].command, command_lut[command_number].command_lenght);
+
+        if (index->slot[slot] != NULL) {
+            TRACE_ERR("Duplicate command %s\n", command_lut[command_number].command);
+
+            return false;
+        }
+
+        index->slot[slot] = &command_lut[command_number];
+        index->count++;
+    }
+
+    return true;
+}
+
+bool CMD_API_FindCommand (sMessage_t command, sCmdWriter_t *response, const sCmdIndex_t *index) {
+    if ((response == NULL) || (index == NULL) || (index->slot == NULL)) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return false;
+    }
+
+    if (response->buffer == NULL) {
+        TRACE_ERR("Invalid response buffer pointer\n");
+
+        return false;
+    }
+
+    if ((command.data == NULL) || (command.size == 0)) {
+        CMD_API_Writer_Printf(response, "Invalid command\n");
+
+        return false;
+    }
+
+    size_t token_length = CMD_API_TokenLength(command);
+    sCmdDesc_t *command_desc = index->slot[CMD_API_Index_Probe(index, command.data, token_length)];
+
+    if (command_desc == NULL) {
+        CMD_API_Writer_Printf(response, "Invalid command\n");
+
+        return false;
+    }
+
+    command.data += token_length;
+    command.size -= token_length;
+
+    SPAN_SCOPE(command_desc->command);
+
+    if (command_desc->typed_handler == NULL) {
+        return CMD_API_RunTextHandler(command_desc, command, response);
+    }
+
+    sCmdArgs_t arguments = {0};
+
+    if (!CMD_API_ParseArguments(command, command_desc->arguments, command_desc->argument_count, &arguments, response)) {
+        return false;
+    }
+
+    return command_desc->typed_handler(&arguments, response);
+}
+
+/**
+ * Parses and range checks the whole argument text in one pass without modifying it. The response is only written
+ * when the arguments are rejected.
+ */
+bool CMD_API_ParseArguments (const sMessage_t arguments, const sCmdArgDesc_t *schema, const size_t schema_length, sCmdArgs_t *parsed, sCmdWriter_t *response) {
+    if ((parsed == NULL) || (response == NULL) || (response->buffer == NULL) || ((schema == NULL) && (schema_length != 0))) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return false;
+    }
+
+    if (schema_length > CMD_ARGUMENTS_MAX) {
+        TRACE_ERR("Too many schema arguments\n");
+
+        return false;
+    }
+
+    if ((arguments.data == NULL) && (arguments.size != 0)) {
+        TRACE_ERR("Invalid argument data pointer\n");
+
+        return false;
+    }
+
+    sMessage_t cursor = arguments;
+    bool has_field = (arguments.size != 0);
+
+    parsed->count = 0;
+
+    for (size_t argument = 0; argument < schema_length; argument++) {
+        if ((schema[argument].type == eCmdArgType_Rgb) || (schema[argument].type == eCmdArgType_Hsv)) {
+            if (!CMD_API_ParseTriplet(&cursor, &has_field, &schema[argument], &parsed->value[argument].uint_value, response)) {
+                return false;
+            }
+
+            parsed->count++;
+
             continue;
         }
 
-        command.data += command_lut[command_number].command_lenght;
-        command.size -= command_lut[command_number].command_lenght;
+        sMessage_t field = {0};
+        int64_t value = 0;
+
+        if (!CMD_API_NextField(&cursor, &has_field, &field)) {
+            CMD_API_Writer_Printf(response, "Missing argument: %s\n", schema[argument].name);
+
+            return false;
+        }
+
+        if (!CMD_API_ParseValue(field, &schema[argument], &value)) {
+            CMD_API_Writer_Printf(response, "%.*s: Invalid %s\n", (int) field.size, field.data, schema[argument].name);
+
+            return false;
+        }
+
+        if ((value < schema[argument].min) || (value > schema[argument].max)) {
+            CMD_API_Writer_Printf(response, "%.*s: %s out of range\n", (int) field.size, field.data, schema[argument].name);
 
-        return command_lut[command_number].handler(command, response);
+            return false;
+        }
+
+        if ((schema[argument].type == eCmdArgType_Int) || (schema[argument].type == eCmdArgType_Fixed)) {
+            parsed->value[argument].int_value = (int32_t) value;
+        } else {
+            parsed->value[argument].uint_value = (uint32_t) value;
+        }
+
+        parsed->count++;
+    }
+
+    if (has_field) {
+        CMD_API_Writer_Printf(response, "Too many arguments\n");
+
+        return false;
+    }
+
+    return true;
+}
+
+/* For values that did not come from CMD_API_ParseArguments, the response is only written when one is rejected */
+bool CMD_API_CheckArguments (const sCmdArgs_t *arguments, const sCmdArgDesc_t *schema, const size_t schema_length, sCmdWriter_t *response) {
+    if ((arguments == NULL) || (response == NULL) || (response->buffer == NULL) || ((schema == NULL) && (schema_length != 0))) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return false;
+    }
+
+    if (arguments->count < schema_length) {
+        CMD_API_Writer_Printf(response, "Missing argument: %s\n", schema[arguments->count].name);
+
+        return false;
+    }
+
+    if (arguments->count > schema_length) {
+        CMD_API_Writer_Printf(response, "Too many arguments\n");
+
+        return false;
+    }
+
+    for (size_t argument = 0; argument < schema_length; argument++) {
+        if (!CMD_API_IsInRange(arguments->value[argument], &schema[argument])) {
+            CMD_API_Writer_Printf(response, "%s out of range\n", schema[argument].name);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef ENABLE_CLI_RPC
+/* The sequence is filled in as soon as the frame is long enough, so even a rejected request can be answered */
+eCmdRpcStatus_t CMD_API_Rpc_Decode (const uint8_t *frame, const size_t frame_size, sCmdRpcRequest_t *request) {
+    if ((frame == NULL) || (request == NULL)) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eCmdRpcStatus_Frame;
+    }
+
+    if ((frame_size < (CMD_RPC_REQUEST_HEADER_SIZE + CMD_RPC_CRC_SIZE)) || (frame[0] != CMD_RPC_REQUEST_TAG)) {
+        return eCmdRpcStatus_Frame;
+    }
+
+    request->sequence = CMD_API_ReadU16(&frame[1]);
+    request->command_id = CMD_API_ReadU16(&frame[3]);
+    request->arguments.count = frame[5];
+
+    if (request->arguments.count > CMD_ARGUMENTS_MAX) {
+        return eCmdRpcStatus_Frame;
+    }
+
+    size_t arguments_end = CMD_RPC_REQUEST_HEADER_SIZE + (request->arguments.count * sizeof(uint32_t));
+
+    if (frame_size < (arguments_end + CMD_RPC_CRC_SIZE)) {
+        return eCmdRpcStatus_Frame;
+    }
+
+    size_t payload_size = frame_size - CMD_RPC_CRC_SIZE;
+
+    if (CRC16_Update(CRC16_INITIAL_VALUE, frame, payload_size) != CMD_API_ReadU16(&frame[payload_size])) {
+        return eCmdRpcStatus_Frame;
+    }
+
+    request->text.data = (char*) &frame[arguments_end];
+    request->text.size = payload_size - arguments_end;
+
+    for (size_t argument = 0; argument < request->arguments.count; argument++) {
+        const uint8_t *value = &frame[CMD_RPC_REQUEST_HEADER_SIZE + (argument * sizeof(uint32_t))];
+
+        request->arguments.value[argument].uint_value = (uint32_t) value[0] | ((uint32_t) value[1] << 8) | ((uint32_t) value[2] << 16) | ((uint32_t) value[3] << 24);
+    }
+
+    return eCmdRpcStatus_Ok;
+}
+
+/* Text handlers get the argument text, typed handlers the arguments checked against their schema */
+eCmdRpcStatus_t CMD_API_Rpc_Execute (const sCmdDesc_t *command_desc, const sCmdRpcRequest_t *request, sCmdWriter_t *response) {
+    if ((request == NULL) || (response == NULL) || (response->buffer == NULL)) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eCmdRpcStatus_Failed;
+    }
+
+    if ((command_desc == NULL) || ((command_desc->typed_handler == NULL) && (command_desc->handler == NULL))) {
+        CMD_API_Writer_Printf(response, "Invalid command\n");
+
+        return eCmdRpcStatus_Command;
+    }
+
+    SPAN_SCOPE(command_desc->command);
+
+    if (command_desc->typed_handler == NULL) {
+        if (request->arguments.count != 0) {
+            CMD_API_Writer_Printf(response, "Text command, no arguments allowed\n");
+
+            return eCmdRpcStatus_Arguments;
+        }
+
+        return CMD_API_RunTextHandler(command_desc, request->text, response) ? eCmdRpcStatus_Ok : eCmdRpcStatus_Failed;
     }
 
-    snprintf(response->data, response->size, "Invalid command\n");
+    if (request->text.size != 0) {
+        CMD_API_Writer_Printf(response, "Typed command, no argument text allowed\n");
 
-    return false;
+        return eCmdRpcStatus_Arguments;
+    }
+
+    if (!CMD_API_CheckArguments(&request->arguments, command_desc->arguments, command_desc->argument_count, response)) {
+        return eCmdRpcStatus_Arguments;
+    }
+
+    if (!command_desc->typed_handler(&request->arguments, response)) {
+        return eCmdRpcStatus_Failed;
+    }
+
+    return eCmdRpcStatus_Ok;
 }
 
+size_t CMD_API_Rpc_Encode (const uint16_t sequence, const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length, uint8_t *buffer, const size_t buffer_size) {
+    if ((status < eCmdRpcStatus_First) || (status >= eCmdRpcStatus_Last) || (buffer == NULL)) {
+        return 0;
+    }
+
+    if ((text == NULL) && (text_length != 0)) {
+        return 0;
+    }
+
+    size_t payload_size = CMD_RPC_RESPONSE_HEADER_SIZE + text_length;
+
+    if (buffer_size < (payload_size + CMD_RPC_CRC_SIZE)) {
+        return 0;
+    }
+
+    buffer[0] = CMD_RPC_RESPONSE_TAG;
+    buffer[1] = (uint8_t) sequence;
+    buffer[2] = (uint8_t) (sequence >> 8);
+    buffer[3] = (uint8_t) status;
+    buffer[4] = has_more ? CMD_RPC_FLAG_MORE : 0U;
+
+    if (text_length > 0) {
+        memcpy(&buffer[CMD_RPC_RESPONSE_HEADER_SIZE], text, text_length);
+    }
+
+    uint16_t crc = CRC16_Update(CRC16_INITIAL_VALUE, buffer, payload_size);
+
+    buffer[payload_size] = (uint8_t) crc;
+    buffer[payload_size + 1U] = (uint8_t) (crc >> 8);
+
+    return payload_size + CMD_RPC_CRC_SIZE;
+}
+#endif
+
 #endif
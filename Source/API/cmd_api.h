@@ -5,6 +5,7 @@
  *********************************************************************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stddef.h>
 #include "message.h"
 #include "framework_config.h"
@@ -13,16 +14,130 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+/// Index slots for a number of commands, the table is kept at most half full
+#define CMD_API_INDEX_CAPACITY(command_count) (((command_count) * 2U) + 1U)
+
+#define CMD_ARGUMENTS_MAX 4U
+
+/**
+ * Argument schema entries for sCmdDesc_t.arguments. Arguments are separated by ',', ranges are inclusive and
+ * fixed-point values are scaled by 10^fraction_digits ("1.5" with 2 digits parses to 150).
+ */
+#define CMD_ARG_UINT(arg_name, min_value, max_value) {.name = arg_name, .type = eCmdArgType_UInt, .min = (min_value), .max = (max_value)}
+#define CMD_ARG_INT(arg_name, min_value, max_value) {.name = arg_name, .type = eCmdArgType_Int, .min = (min_value), .max = (max_value)}
+#define CMD_ARG_HEX(arg_name, min_value, max_value) {.name = arg_name, .type = eCmdArgType_Hex, .min = (min_value), .max = (max_value)}
+#define CMD_ARG_FIXED(arg_name, digits, min_value, max_value) {.name = arg_name, .type = eCmdArgType_Fixed, .fraction_digits = (digits), .min = (min_value), .max = (max_value)}
+#define CMD_ARG_ENUM(arg_name, name_lut) {.name = arg_name, .type = eCmdArgType_Enum, .names = (name_lut), .max = (sizeof(name_lut) / sizeof((name_lut)[0])) - 1}
+#define CMD_ARG_RGB(arg_name) {.name = arg_name, .type = eCmdArgType_Rgb, .max = UINT8_MAX}
+#define CMD_ARG_HSV(arg_name) {.name = arg_name, .type = eCmdArgType_Hsv, .max = UINT8_MAX}
+
+#define CMD_ARGUMENTS(schema) .arguments = (schema), .argument_count = (sizeof(schema) / sizeof((schema)[0]))
+
+/**
+ * Binary RPC frames (ENABLE_CLI_RPC), little endian, CRC-16/CCITT-FALSE over all preceding bytes:
+ *   request:  'Q', sequence (u16), command id (u16), argument count (u8), arguments (u32 each), argument text, crc (u16)
+ *   response: 'R', sequence (u16), status (u8), flags (u8), reply text, crc (u16)
+ * Arguments carry the sCmdArgs_t values, they are range checked against the command schema like parsed text.
+ * Commands with a raw text handler take the argument text instead and no arguments, typed commands no text.
+ * A reply longer than one frame is split, every frame but the last has CMD_RPC_FLAG_MORE set and status Ok.
+ */
+#define CMD_RPC_REQUEST_TAG 'Q'
+#define CMD_RPC_RESPONSE_TAG 'R'
+#define CMD_RPC_CRC_SIZE 2U
+#define CMD_RPC_REQUEST_HEADER_SIZE 6U
+#define CMD_RPC_RESPONSE_HEADER_SIZE 5U
+#define CMD_RPC_REQUEST_MAX_SIZE (CMD_RPC_REQUEST_HEADER_SIZE + (CMD_ARGUMENTS_MAX * sizeof(uint32_t)) + CMD_RPC_CRC_SIZE)
+#define CMD_RPC_RESPONSE_MAX_SIZE(text_capacity) (CMD_RPC_RESPONSE_HEADER_SIZE + (text_capacity) + CMD_RPC_CRC_SIZE)
+#define CMD_RPC_FLAG_MORE 0x01U
+/// Command id 0 is the unused eCliFrameworkCmd_First, it is answered with Ok to check the link
+#define CMD_RPC_PING_ID 0x0000U
+#define CMD_RPC_EXIT_ID 0xFFFFU
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
 /* clang-format off */
+typedef enum eCmdArgType {
+    eCmdArgType_First = 0,
+    eCmdArgType_UInt = eCmdArgType_First,
+    eCmdArgType_Int,
+    eCmdArgType_Hex,
+    eCmdArgType_Fixed,
+    eCmdArgType_Enum,
+    eCmdArgType_Rgb,
+    eCmdArgType_Hsv,
+    eCmdArgType_Last
+} eCmdArgType_t;
+
+typedef struct sCmdArgDesc {
+    const char *name;
+    eCmdArgType_t type;
+    int64_t min;
+    int64_t max;
+    uint8_t fraction_digits;
+    const char * const *names;
+} sCmdArgDesc_t;
+
+/**
+ * Handlers stream their reply into the writer. A full buffer is handed to the sink and reused, so a reply of any
+ * length costs one buffer. Without a sink the writer keeps what fits and drops the rest. The text is NUL terminated.
+ */
+typedef struct sCmdWriter {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+    bool is_truncated;
+    bool (*sink)(const char *data, const size_t size);
+} sCmdWriter_t;
+
+/* UInt, Hex and the Enum index in uint_value, Int and Fixed in int_value, Rgb and Hsv packed as 0x00RRGGBB / 0x00HHSSVV */
+typedef union uCmdArg {
+    uint32_t uint_value;
+    int32_t int_value;
+} uCmdArg_t;
+
+typedef struct sCmdArgs {
+    size_t count;
+    uCmdArg_t value[CMD_ARGUMENTS_MAX];
+} sCmdArgs_t;
+
+/**
+ * Commands either declare an argument schema and a typed_handler, which gets called with the arguments parsed
+ * and range checked, or a handler that gets the raw argument text.
+ */
 typedef struct sCmdDesc {
     char *command;
     size_t command_lenght;
     bool (*handler)(sMessage_t arguments, sMessage_t *response);
+    bool (*typed_handler)(const sCmdArgs_t *arguments, sCmdWriter_t *response);
+    const sCmdArgDesc_t *arguments;
+    size_t argument_count;
 } sCmdDesc_t;
+
+typedef enum eCmdRpcStatus {
+    eCmdRpcStatus_First = 0,
+    eCmdRpcStatus_Ok = eCmdRpcStatus_First,
+    eCmdRpcStatus_Failed,
+    eCmdRpcStatus_Frame,
+    eCmdRpcStatus_Command,
+    eCmdRpcStatus_Arguments,
+    eCmdRpcStatus_Last
+} eCmdRpcStatus_t;
+
+typedef struct sCmdRpcRequest {
+    uint16_t sequence;
+    uint16_t command_id;
+    sCmdArgs_t arguments;
+    /* Points into the decoded frame */
+    sMessage_t text;
+} sCmdRpcRequest_t;
+
+typedef struct sCmdIndex {
+    sCmdDesc_t **slot;
+    size_t capacity;
+    size_t count;
+} sCmdIndex_t;
 /* clang-format on */
 
 /**********************************************************************************************************************
@@ -33,6 +148,18 @@ typedef struct sCmdDesc {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-bool CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size);
+bool CMD_API_Writer_Init (sCmdWriter_t *writer, char *buffer, const size_t capacity, bool (*sink)(const char *data, const size_t size));
+bool CMD_API_Writer_Printf (sCmdWriter_t *writer, const char *format, ...) __attribute__((format(printf, 2, 3)));
+bool CMD_API_Writer_Flush (sCmdWriter_t *writer);
+void CMD_API_Writer_Reset (sCmdWriter_t *writer);
+bool CMD_API_Index_Init (sCmdIndex_t *index, sCmdDesc_t **slot, const size_t capacity);
+bool CMD_API_Index_Add (sCmdIndex_t *index, sCmdDesc_t *command_lut, const size_t command_lut_size);
+bool CMD_API_FindCommand (sMessage_t command, sCmdWriter_t *response, const sCmdIndex_t *index);
+bool CMD_API_ParseArguments (const sMessage_t arguments, const sCmdArgDesc_t *schema, const size_t schema_length, sCmdArgs_t *parsed, sCmdWriter_t *response);
+bool CMD_API_CheckArguments (const sCmdArgs_t *arguments, const sCmdArgDesc_t *schema, const size_t schema_length, sCmdWriter_t *response);
+eCmdRpcStatus_t CMD_API_Rpc_Decode (const uint8_t *frame, const size_t frame_size, sCmdRpcRequest_t *request);
+eCmdRpcStatus_t CMD_API_Rpc_Execute (const sCmdDesc_t *command_desc, const sCmdRpcRequest_t *request, sCmdWriter_t *response);
+/// Returns the record length or 0 if the buffer is too small
+size_t CMD_API_Rpc_Encode (const uint16_t sequence, const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length, uint8_t *buffer, const size_t buffer_size);
 
 #endif /* SOURCE_API_CMD_API_H_ */
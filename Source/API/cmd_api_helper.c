@@ -29,7 +29,7 @@
  *********************************************************************************************************************/
 
 #ifdef DEBUG_CMD_API_HELPER
-CREATE_MODULE_NAME (CMD_API_HELPER)
+CREATE_FRAMEWORK_MODULE_NAME (CMD_API_HELPER)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
@@ -0,0 +1,323 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "cpu_api.h"
+
+#ifdef ENABLE_RUN_TIME_STATS
+
+#include <string.h>
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rtos_static.h"
+#include "debug_api.h"
+#include "stack_api.h"
+
+#if (configGENERATE_RUN_TIME_STATS != 1) || (configUSE_TRACE_FACILITY != 1)
+#error "ENABLE_RUN_TIME_STATS requires configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY set to 1 in FreeRTOSConfig.h."
+#endif
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define CPU_API_THREAD_STACK_SIZE (128 * 4)
+#define CPU_API_SLOT_PERIOD_MS (RUN_TIME_STATS_WINDOW_MS / RUN_TIME_STATS_WINDOW_SLOTS)
+#define CPU_API_SNAPSHOT_COUNT (RUN_TIME_STATS_WINDOW_SLOTS + 1)
+
+/* Kernels before V10.4.4 hard code the run time counter to uint32_t */
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sCpuThreadSample {
+    uint32_t number;
+    uint32_t run_time;
+    uint32_t switches;
+} sCpuThreadSample_t;
+
+typedef struct sCpuSnapshot {
+    uint32_t cycles;
+    uint32_t total_run_time;
+    size_t thread_count;
+    sCpuThreadSample_t thread[RUN_TIME_STATS_MAX_THREADS];
+    sRunTimeIsrStats_t isr[eRunTimeIsr_Last];
+} sCpuSnapshot_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+CREATE_FRAMEWORK_MODULE_NAME (CPU_API)
+
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_cpu_thread_cb;
+static uint64_t g_cpu_thread_stack[RTOS_STACK_LENGTH(CPU_API_THREAD_STACK_SIZE)];
+static StaticSemaphore_t g_cpu_mutex_cb;
+#endif
+
+const static osThreadAttr_t g_cpu_thread_attributes = {
+    .name = "CPU_API_Thread",
+    .cb_mem = RTOS_STATIC_MEM(g_cpu_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_cpu_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_cpu_thread_stack),
+    .stack_size = CPU_API_THREAD_STACK_SIZE,
+    .priority = (osPriority_t) osPriorityLow
+};
+
+const static osMutexAttr_t g_cpu_mutex_attributes = {
+    .name = "CPU_API_mutex",
+    .attr_bits = osMutexRecursive | osMutexPrioInherit,
+    .cb_mem = RTOS_STATIC_MEM(g_cpu_mutex_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_cpu_mutex_cb)
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static osThreadId_t g_cpu_thread_id = NULL;
+static osMutexId_t g_cpu_mutex = NULL;
+
+static TaskStatus_t g_cpu_task_status[RUN_TIME_STATS_MAX_THREADS];
+static char g_cpu_task_name[RUN_TIME_STATS_MAX_THREADS][CPU_API_THREAD_NAME_LENGTH];
+
+static sCpuSnapshot_t g_cpu_snapshot[CPU_API_SNAPSHOT_COUNT];
+static size_t g_cpu_snapshot_head = 0;
+static size_t g_cpu_snapshot_count = 0;
+
+static bool g_cpu_is_overflow_reported = false;
+
+/* Report over the current window, sorted by load, rebuilt by the sampler after every slot */
+static uint32_t g_cpu_window_ms = 0;
+static size_t g_cpu_thread_count = 0;
+static sCpuThreadStats_t g_cpu_thread_stats[RUN_TIME_STATS_MAX_THREADS];
+static sCpuIsrStats_t g_cpu_isr_stats[eRunTimeIsr_Last];
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void CPU_API_Thread (void *arg);
+static void CPU_API_Sample (sCpuSnapshot_t *snapshot);
+static void CPU_API_Report (const sCpuSnapshot_t *oldest, const sCpuSnapshot_t *newest);
+static uint32_t CPU_API_Permille (const uint32_t part, const uint32_t total);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Waking up once per slot also keeps getRunTimeCounterValue called often enough to catch every counter wrap */
+static void CPU_API_Thread (void *arg) {
+    while (true) {
+        if (osMutexAcquire(g_cpu_mutex, osWaitForever) == osOK) {
+            CPU_API_Sample(&g_cpu_snapshot[g_cpu_snapshot_head]);
+
+            size_t newest = g_cpu_snapshot_head;
+
+            g_cpu_snapshot_head = (g_cpu_snapshot_head + 1) % CPU_API_SNAPSHOT_COUNT;
+
+            if (g_cpu_snapshot_count < CPU_API_SNAPSHOT_COUNT) {
+                g_cpu_snapshot_count++;
+            }
+
+            if (g_cpu_snapshot_count > 1) {
+                size_t oldest = (g_cpu_snapshot_count < CPU_API_SNAPSHOT_COUNT) ? 0 : g_cpu_snapshot_head;
+
+                CPU_API_Report(&g_cpu_snapshot[oldest], &g_cpu_snapshot[newest]);
+            }
+
+            osMutexRelease(g_cpu_mutex);
+        }
+
+        osDelay(CPU_API_SLOT_PERIOD_MS);
+    }
+
+    osThreadYield();
+}
+
+static void CPU_API_Sample (sCpuSnapshot_t *snapshot) {
+    configRUN_TIME_COUNTER_TYPE total_run_time = 0;
+
+    UBaseType_t count = uxTaskGetSystemState(g_cpu_task_status, RUN_TIME_STATS_MAX_THREADS, &total_run_time);
+
+    if ((count == 0) && !g_cpu_is_overflow_reported) {
+        TRACE_WRN("More than %u threads, raise RUN_TIME_STATS_MAX_THREADS\n", (unsigned int) RUN_TIME_STATS_MAX_THREADS);
+
+        g_cpu_is_overflow_reported = true;
+    }
+
+    snapshot->cycles = Run_Time_Stats_GetCycles();
+    snapshot->total_run_time = (uint32_t) total_run_time;
+    snapshot->thread_count = count;
+
+    for (size_t thread = 0; thread < count; thread++) {
+        snapshot->thread[thread].number = (uint32_t) g_cpu_task_status[thread].xTaskNumber;
+        snapshot->thread[thread].run_time = (uint32_t) g_cpu_task_status[thread].ulRunTimeCounter;
+        snapshot->thread[thread].switches = Run_Time_Stats_GetSwitches(snapshot->thread[thread].number);
+
+        strncpy(g_cpu_task_name[thread], g_cpu_task_status[thread].pcTaskName, CPU_API_THREAD_NAME_LENGTH - 1U);
+        g_cpu_task_name[thread][CPU_API_THREAD_NAME_LENGTH - 1U] = '\0';
+    }
+
+    for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+        Run_Time_Stats_GetIsr(source, &snapshot->isr[source]);
+    }
+
+    return;
+}
+
+/* Counters are free running, unsigned differences stay correct across one wrap within the window */
+static void CPU_API_Report (const sCpuSnapshot_t *oldest, const sCpuSnapshot_t *newest) {
+    uint32_t cycles = newest->cycles - oldest->cycles;
+    uint32_t total_run_time = newest->total_run_time - oldest->total_run_time;
+
+    g_cpu_window_ms = cycles / SYSTEM_MS_TICS;
+    g_cpu_thread_count = 0;
+
+    for (size_t thread = 0; thread < newest->thread_count; thread++) {
+        sCpuThreadSample_t start = {0};
+
+        /* A thread created within the window is measured from zero */
+        for (size_t previous = 0; previous < oldest->thread_count; previous++) {
+            if (oldest->thread[previous].number == newest->thread[thread].number) {
+                start = oldest->thread[previous];
+
+                break;
+            }
+        }
+
+        sCpuThreadStats_t stats = {0};
+
+        memcpy(stats.name, g_cpu_task_name[thread], CPU_API_THREAD_NAME_LENGTH);
+        stats.load_permille = CPU_API_Permille(newest->thread[thread].run_time - start.run_time, total_run_time);
+        stats.switches = newest->thread[thread].switches - start.switches;
+
+        size_t position = g_cpu_thread_count;
+
+        while ((position > 0) && (g_cpu_thread_stats[position - 1].load_permille < stats.load_permille)) {
+            g_cpu_thread_stats[position] = g_cpu_thread_stats[position - 1];
+            position--;
+        }
+
+        g_cpu_thread_stats[position] = stats;
+        g_cpu_thread_count++;
+    }
+
+    for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+        uint32_t isr_cycles = newest->isr[source].cycles - oldest->isr[source].cycles;
+        uint32_t isr_count = newest->isr[source].count - oldest->isr[source].count;
+
+        g_cpu_isr_stats[source].name = Run_Time_Stats_GetIsrName(source);
+        g_cpu_isr_stats[source].load_permille = CPU_API_Permille(isr_cycles, cycles);
+        g_cpu_isr_stats[source].count = isr_count;
+        g_cpu_isr_stats[source].average_cycles = (isr_count != 0) ? (isr_cycles / isr_count) : 0;
+    }
+
+    return;
+}
+
+static uint32_t CPU_API_Permille (const uint32_t part, const uint32_t total) {
+    if (total == 0) {
+        return 0;
+    }
+
+    return (uint32_t) (((uint64_t) part * 1000U) / total);
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+bool CPU_API_Init (void) {
+    if (g_cpu_thread_id != NULL) {
+        return true;
+    }
+
+    if (g_cpu_mutex == NULL) {
+        g_cpu_mutex = osMutexNew(&g_cpu_mutex_attributes);
+    }
+
+    if (g_cpu_mutex == NULL) {
+        return false;
+    }
+
+    g_cpu_thread_id = osThreadNew(CPU_API_Thread, NULL, &g_cpu_thread_attributes);
+
+    Stack_API_Track(g_cpu_thread_id, CPU_API_THREAD_STACK_SIZE);
+
+    return g_cpu_thread_id != NULL;
+}
+
+/* Zero until the sampler has taken two snapshots, RUN_TIME_STATS_WINDOW_MS once the window is full */
+uint32_t CPU_API_GetWindowMs (void) {
+    if (osMutexAcquire(g_cpu_mutex, osWaitForever) != osOK) {
+        return 0;
+    }
+
+    uint32_t window_ms = g_cpu_window_ms;
+
+    osMutexRelease(g_cpu_mutex);
+
+    return window_ms;
+}
+
+size_t CPU_API_GetThreadCount (void) {
+    if (osMutexAcquire(g_cpu_mutex, osWaitForever) != osOK) {
+        return 0;
+    }
+
+    size_t count = g_cpu_thread_count;
+
+    osMutexRelease(g_cpu_mutex);
+
+    return count;
+}
+
+/* Threads are ordered by load, the order can change between two calls when the sampler runs in between */
+bool CPU_API_GetThreadStats (const size_t index, sCpuThreadStats_t *stats) {
+    if (stats == NULL) {
+        return false;
+    }
+
+    if (osMutexAcquire(g_cpu_mutex, osWaitForever) != osOK) {
+        return false;
+    }
+
+    bool is_valid = index < g_cpu_thread_count;
+
+    if (is_valid) {
+        *stats = g_cpu_thread_stats[index];
+    }
+
+    osMutexRelease(g_cpu_mutex);
+
+    return is_valid;
+}
+
+bool CPU_API_GetIsrStats (const eRunTimeIsr_t source, sCpuIsrStats_t *stats) {
+    if ((source < eRunTimeIsr_First) || (source >= eRunTimeIsr_Last) || (stats == NULL)) {
+        return false;
+    }
+
+    if (osMutexAcquire(g_cpu_mutex, osWaitForever) != osOK) {
+        return false;
+    }
+
+    *stats = g_cpu_isr_stats[source];
+
+    osMutexRelease(g_cpu_mutex);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SOURCE_API_CPU_API_H_
+#define SOURCE_API_CPU_API_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "framework_config.h"
+#include "run_time_stats.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#define CPU_API_THREAD_NAME_LENGTH 16U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sCpuThreadStats {
+    char name[CPU_API_THREAD_NAME_LENGTH];
+    uint32_t load_permille;
+    uint32_t switches;
+} sCpuThreadStats_t;
+
+typedef struct sCpuIsrStats {
+    const char *name;
+    uint32_t load_permille;
+    uint32_t count;
+    uint32_t average_cycles;
+} sCpuIsrStats_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool CPU_API_Init (void);
+uint32_t CPU_API_GetWindowMs (void);
+size_t CPU_API_GetThreadCount (void);
+bool CPU_API_GetThreadStats (const size_t index, sCpuThreadStats_t *stats);
+bool CPU_API_GetIsrStats (const eRunTimeIsr_t source, sCpuIsrStats_t *stats);
+
+#endif /* SOURCE_API_CPU_API_H_ */
@@ -7,8 +7,16 @@
 #ifdef ENABLE_DEBUG
 
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "uart_api.h"
 #include "message.h"
+#include <stdatomic.h>
+
+#ifdef ENABLE_DEBUG_DEFERRED
+#include "cobs.h"
+#include "stack_api.h"
+#include "dwt_driver.h"
+#endif
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -19,20 +27,99 @@
 #define DEBUG_MESSAGE_TIMEOUT 1000
 #define DEBUG_MUTEX_TIMEOUT 0U
 
+#ifdef ENABLE_DEBUG_DEFERRED
+#define LOG_RING_MASK (DEBUG_DEFERRED_RECORD_COUNT - 1U)
+/* format (4), module (4), timestamp (4), line (2), level (1) */
+#define LOG_HEADER_SIZE 15U
+#define LOG_RECORD_MAX_SIZE (LOG_HEADER_SIZE + DEBUG_DEFERRED_PAYLOAD_SIZE)
+#define LOG_FRAME_MAX_SIZE (COBS_ENCODED_MAX_SIZE(LOG_RECORD_MAX_SIZE) + 1U)
+#define LOG_TX_BUFFER_SIZE (LOG_FRAME_MAX_SIZE * 4U)
+#define LOG_ISR_RING_MASK (DEBUG_DEFERRED_ISR_RECORD_COUNT - 1U)
+/* A record with a NULL format carries the number of records lost since the last one */
+#define LOG_DROPPED_FORMAT 0U
+/* Timestamps are DWT cycles, every flush starts with a record pairing the cycle counter with the kernel tick */
+#define LOG_SYNC_FORMAT 1U
+/* Debug_API_Write text, the payload is printed as is */
+#define LOG_TEXT_FORMAT 2U
+#define LOG_LEVEL_ISR 3U
+#define LOG_THREAD_STACK_SIZE (128 * 4)
+#endif
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
 
+#ifdef ENABLE_DEBUG_DEFERRED
+typedef struct sLogSlot {
+    atomic_size_t sequence;
+    uint32_t format;
+    uint32_t module;
+    uint32_t timestamp;
+    uint16_t line;
+    uint8_t level;
+    uint8_t payload_length;
+    uint8_t payload[DEBUG_DEFERRED_PAYLOAD_SIZE];
+} sLogSlot_t;
+
+typedef struct sLogIsrSlot {
+    atomic_size_t sequence;
+    uint32_t format;
+    uint32_t module;
+    uint32_t timestamp;
+    uint32_t value;
+    uint16_t line;
+} sLogIsrSlot_t;
+#endif
+
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticSemaphore_t g_debug_api_mutex_cb;
+#endif
+
+/* clang-format off */
+const static char *g_debug_api_module_name[eTraceModule_Last] = {
+    [eTraceModule_None] = "NONE",
+    [eTraceModule_IO_API] = "IO_API",
+    [eTraceModule_I2C_API] = "I2C_API",
+    [eTraceModule_CMD_API] = "CMD_API",
+    [eTraceModule_CMD_API_HELPER] = "CMD_API_HELPER",
+    [eTraceModule_STACK_API] = "STACK_API",
+    [eTraceModule_CPU_API] = "CPU_API",
+    [eTraceModule_WS2812B_API] = "WS2812B_API",
+    [eTraceModule_VL53L0XV2_API] = "VL53L0XV2_API",
+    [eTraceModule_CLI_APP] = "CLI_APP",
+    [eTraceModule_CLI_CMD_HANDLERS] = "CLI_CMD_HANDLERS",
+    [eTraceModule_LED_APP] = "LED_APP",
+    [eTraceModule_Motor_APP] = "Motor_APP",
+    [eTraceModule_Project] = "PROJECT"
+};
+/* clang-format on */
+
 const static osMutexAttr_t g_debug_api_mutex_attributes = {
     .name = "Debug_API_mutex", 
     .attr_bits = osMutexRecursive | osMutexPrioInherit, 
-    .cb_mem = NULL, 
-    .cb_size = 0U
+    .cb_mem = RTOS_STATIC_MEM(g_debug_api_mutex_cb), 
+    .cb_size = RTOS_STATIC_SIZE(g_debug_api_mutex_cb)
+};
+
+#ifdef ENABLE_DEBUG_DEFERRED
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_log_thread_cb;
+static uint64_t g_log_thread_stack[RTOS_STACK_LENGTH(LOG_THREAD_STACK_SIZE)];
+#endif
+
+const static osThreadAttr_t g_log_thread_attributes = {
+    .name = "Debug_API_LogThread",
+    .cb_mem = RTOS_STATIC_MEM(g_log_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_log_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_log_thread_stack),
+    .stack_size = LOG_THREAD_STACK_SIZE,
+    .priority = (osPriority_t) osPriorityLow
 };
+#endif
 
 /**********************************************************************************************************************
  * Private variables
@@ -41,19 +128,342 @@ const static osMutexAttr_t g_debug_api_mutex_attributes = {
 static char g_debug_message_buffer[DEBUG_MESSAGE_SIZE] = {0};
 static bool g_is_initialized = false;
 static osMutexId_t g_debug_api_mutex = NULL;
+/* Names of the project module slots after eTraceModule_Project, claimed once and never given back */
+static _Atomic(const char *) g_debug_api_project_module_name[DEBUG_PROJECT_MODULE_COUNT] = {0};
+
+#ifdef ENABLE_DEBUG_DEFERRED
+/* Bounded MPSC queue, any thread or ISR produces and the log thread consumes */
+static sLogSlot_t g_log_ring[DEBUG_DEFERRED_RECORD_COUNT];
+static atomic_size_t g_log_head = 0;
+static size_t g_log_tail = 0;
+static atomic_uint_least32_t g_log_dropped = 0;
+static uint32_t g_log_dropped_total = 0;
+
+/* Overwrite oldest ring, writers never wait and the log thread detects torn slots by the sequence */
+static sLogIsrSlot_t g_log_isr_ring[DEBUG_DEFERRED_ISR_RECORD_COUNT];
+static atomic_size_t g_log_isr_head = 0;
+static size_t g_log_isr_tail = 0;
+
+static osThreadId_t g_log_thread_id = NULL;
+static uint8_t g_log_tx_buffer[LOG_TX_BUFFER_SIZE];
+static uint8_t g_log_text_record[LOG_RECORD_MAX_SIZE];
+static uint8_t g_log_text_frame[LOG_FRAME_MAX_SIZE];
+#endif
 
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
 
+/* Read directly by the TRACE macros, a byte store is atomic on the core */
+uint8_t g_debug_api_module_level[eTraceModule_Last] = {0};
+
 /**********************************************************************************************************************
  * Prototypes of private functions
  *********************************************************************************************************************/
- 
+
+#ifdef ENABLE_DEBUG_DEFERRED
+static bool Debug_API_PutUInt (uint8_t *buffer, const size_t capacity, size_t *length, const uint64_t value, const size_t size);
+static size_t Debug_API_PackArguments (uint8_t *payload, const char *format, va_list *arguments);
+static size_t Debug_API_LogHeader (uint8_t *record, const uint32_t format, const uint32_t module, const uint32_t timestamp, const uint16_t line, const uint8_t level);
+static size_t Debug_API_LogEncode (const uint8_t *record, const size_t record_length, size_t tx_length, bool *is_synced);
+static size_t Debug_API_LogFlushIsr (uint8_t *record, size_t tx_length, bool *is_synced);
+static void Debug_API_LogFlush (void);
+static void Debug_API_LogThread (void *arg);
+#endif
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
- 
+
+#ifdef ENABLE_DEBUG_DEFERRED
+/* Little endian, independent of the host the decoder runs on */
+static bool Debug_API_PutUInt (uint8_t *buffer, const size_t capacity, size_t *length, const uint64_t value, const size_t size) {
+    if ((capacity - *length) < size) {
+        return false;
+    }
+
+    for (size_t byte = 0; byte < size; byte++) {
+        buffer[*length] = (uint8_t) (value >> (byte * 8U));
+        (*length)++;
+    }
+
+    return true;
+}
+
+/**
+ * Walks the conversions the way printf does and stores each argument at its target size.
+ * Strings are copied, everything else is stored raw. Arguments that do not fit are dropped.
+ */
+static size_t Debug_API_PackArguments (uint8_t *payload, const char *format, va_list *arguments) {
+    size_t length = 0;
+
+    for (const char *character = format; *character != '\0'; character++) {
+        if (*character != '%') {
+            continue;
+        }
+
+        character++;
+
+        if (*character == '%') {
+            continue;
+        }
+
+        while ((*character == '-') || (*character == '+') || (*character == ' ') || (*character == '#') || (*character == '0')) {
+            character++;
+        }
+
+        if (*character == '*') {
+            if (!Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, (uint32_t) va_arg(*arguments, int), sizeof(uint32_t))) {
+                return length;
+            }
+
+            character++;
+        }
+
+        while ((*character >= '0') && (*character <= '9')) {
+            character++;
+        }
+
+        if (*character == '.') {
+            character++;
+
+            if (*character == '*') {
+                if (!Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, (uint32_t) va_arg(*arguments, int), sizeof(uint32_t))) {
+                    return length;
+                }
+
+                character++;
+            }
+
+            while ((*character >= '0') && (*character <= '9')) {
+                character++;
+            }
+        }
+
+        bool is_long_long = false;
+        bool is_long = false;
+        bool is_size = false;
+
+        while ((*character == 'h') || (*character == 'l') || (*character == 'z') || (*character == 't') || (*character == 'j') || (*character == 'L')) {
+            is_long_long = is_long_long || (*character == 'j') || (is_long && (*character == 'l'));
+            is_long = is_long || (*character == 'l');
+            is_size = is_size || (*character == 'z') || (*character == 't');
+            character++;
+        }
+
+        bool is_stored = true;
+
+        switch (*character) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c': {
+                if (is_long_long) {
+                    is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, va_arg(*arguments, unsigned long long), sizeof(uint64_t));
+                } else if (is_long) {
+                    is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, (uint32_t) va_arg(*arguments, unsigned long), sizeof(uint32_t));
+                } else if (is_size) {
+                    is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, (uint32_t) va_arg(*arguments, size_t), sizeof(uint32_t));
+                } else {
+                    is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, va_arg(*arguments, unsigned int), sizeof(uint32_t));
+                }
+            } break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double value = va_arg(*arguments, double);
+                uint64_t bits = 0;
+
+                memcpy(&bits, &value, sizeof(bits));
+
+                is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, bits, sizeof(uint64_t));
+            } break;
+            case 'p': {
+                is_stored = Debug_API_PutUInt(payload, DEBUG_DEFERRED_PAYLOAD_SIZE, &length, (uint32_t) (uintptr_t) va_arg(*arguments, void*), sizeof(uint32_t));
+            } break;
+            case 's': {
+                const char *string = va_arg(*arguments, const char*);
+
+                if (string == NULL) {
+                    string = "(null)";
+                }
+
+                size_t string_length = strnlen(string, DEBUG_DEFERRED_MAX_STRING);
+
+                if ((DEBUG_DEFERRED_PAYLOAD_SIZE - length) < (string_length + 1U)) {
+                    return length;
+                }
+
+                payload[length] = (uint8_t) string_length;
+                memcpy(&payload[length + 1U], string, string_length);
+                length += string_length + 1U;
+            } break;
+            case 'n': {
+                (void) va_arg(*arguments, void*);
+            } break;
+            case '\0': {
+                return length;
+            }
+            default: {
+            } break;
+        }
+
+        if (!is_stored) {
+            return length;
+        }
+    }
+
+    return length;
+}
+
+static size_t Debug_API_LogHeader (uint8_t *record, const uint32_t format, const uint32_t module, const uint32_t timestamp, const uint16_t line, const uint8_t level) {
+    size_t record_length = 0;
+
+    Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, format, sizeof(uint32_t));
+    Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, module, sizeof(uint32_t));
+    Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, timestamp, sizeof(uint32_t));
+    Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, line, sizeof(uint16_t));
+    Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, level, sizeof(uint8_t));
+
+    return record_length;
+}
+
+static size_t Debug_API_LogEncode (const uint8_t *record, const size_t record_length, size_t tx_length, bool *is_synced) {
+    if (!*is_synced) {
+        uint8_t sync[LOG_RECORD_MAX_SIZE];
+        size_t sync_length = Debug_API_LogHeader(sync, LOG_SYNC_FORMAT, 0, DWT_Driver_GetCycles(), 0, eTraceLevel_Info);
+
+        Debug_API_PutUInt(sync, LOG_RECORD_MAX_SIZE, &sync_length, osKernelGetTickCount(), sizeof(uint32_t));
+
+        *is_synced = true;
+        tx_length = Debug_API_LogEncode(sync, sync_length, tx_length, is_synced);
+    }
+
+    if ((LOG_TX_BUFFER_SIZE - tx_length) < LOG_FRAME_MAX_SIZE) {
+        UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_log_tx_buffer, .size = tx_length}, DEBUG_MESSAGE_TIMEOUT);
+
+        tx_length = 0;
+    }
+
+    tx_length += COBS_Encode(record, record_length, &g_log_tx_buffer[tx_length], (LOG_TX_BUFFER_SIZE - tx_length));
+    g_log_tx_buffer[tx_length] = COBS_DELIMITER;
+    tx_length++;
+
+    return tx_length;
+}
+
+static size_t Debug_API_LogFlushIsr (uint8_t *record, size_t tx_length, bool *is_synced) {
+    size_t head = atomic_load_explicit(&g_log_isr_head, memory_order_acquire);
+
+    if ((head - g_log_isr_tail) > DEBUG_DEFERRED_ISR_RECORD_COUNT) {
+        atomic_fetch_add_explicit(&g_log_dropped, (uint32_t) (head - g_log_isr_tail - DEBUG_DEFERRED_ISR_RECORD_COUNT), memory_order_relaxed);
+
+        g_log_isr_tail = head - DEBUG_DEFERRED_ISR_RECORD_COUNT;
+    }
+
+    while (g_log_isr_tail != head) {
+        size_t slot = g_log_isr_tail & LOG_ISR_RING_MASK;
+        size_t sequence = atomic_load_explicit(&g_log_isr_ring[slot].sequence, memory_order_acquire);
+
+        /* Zero or an older lap means an interrupted writer still owns the slot, pick it up on the next flush */
+        if ((sequence == 0) || (sequence < (g_log_isr_tail + 1U))) {
+            break;
+        }
+
+        sLogIsrSlot_t entry = {
+            .format = g_log_isr_ring[slot].format,
+            .module = g_log_isr_ring[slot].module,
+            .timestamp = g_log_isr_ring[slot].timestamp,
+            .value = g_log_isr_ring[slot].value,
+            .line = g_log_isr_ring[slot].line
+        };
+
+        atomic_thread_fence(memory_order_acquire);
+
+        if ((sequence != (g_log_isr_tail + 1U)) || (atomic_load_explicit(&g_log_isr_ring[slot].sequence, memory_order_relaxed) != sequence)) {
+            atomic_fetch_add_explicit(&g_log_dropped, 1, memory_order_relaxed);
+
+            g_log_isr_tail++;
+
+            continue;
+        }
+
+        size_t record_length = Debug_API_LogHeader(record, entry.format, entry.module, entry.timestamp, entry.line, LOG_LEVEL_ISR);
+
+        Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, entry.value, sizeof(uint32_t));
+
+        g_log_isr_tail++;
+
+        tx_length = Debug_API_LogEncode(record, record_length, tx_length, is_synced);
+    }
+
+    return tx_length;
+}
+
+static void Debug_API_LogFlush (void) {
+    uint8_t record[LOG_RECORD_MAX_SIZE];
+    size_t record_length = 0;
+    size_t tx_length = 0;
+    bool is_synced = false;
+
+    tx_length = Debug_API_LogFlushIsr(record, tx_length, &is_synced);
+
+    uint32_t dropped = atomic_exchange_explicit(&g_log_dropped, 0, memory_order_relaxed);
+
+    if (dropped != 0) {
+        g_log_dropped_total += dropped;
+
+        record_length = Debug_API_LogHeader(record, LOG_DROPPED_FORMAT, 0, DWT_Driver_GetCycles(), 0, eTraceLevel_Warning);
+
+        Debug_API_PutUInt(record, LOG_RECORD_MAX_SIZE, &record_length, dropped, sizeof(uint32_t));
+
+        tx_length = Debug_API_LogEncode(record, record_length, tx_length, &is_synced);
+    }
+
+    while (true) {
+        size_t slot = g_log_tail & LOG_RING_MASK;
+
+        if (atomic_load_explicit(&g_log_ring[slot].sequence, memory_order_acquire) != (g_log_tail + 1U)) {
+            break;
+        }
+
+        record_length = Debug_API_LogHeader(record, g_log_ring[slot].format, g_log_ring[slot].module, g_log_ring[slot].timestamp, g_log_ring[slot].line, g_log_ring[slot].level);
+
+        memcpy(&record[record_length], g_log_ring[slot].payload, g_log_ring[slot].payload_length);
+        record_length += g_log_ring[slot].payload_length;
+
+        atomic_store_explicit(&g_log_ring[slot].sequence, (g_log_tail + DEBUG_DEFERRED_RECORD_COUNT), memory_order_release);
+        g_log_tail++;
+
+        tx_length = Debug_API_LogEncode(record, record_length, tx_length, &is_synced);
+    }
+
+    if (tx_length > 0) {
+        UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_log_tx_buffer, .size = tx_length}, DEBUG_MESSAGE_TIMEOUT);
+    }
+
+    return;
+}
+
+static void Debug_API_LogThread (void *arg) {
+    while (true) {
+        osDelay(DEBUG_DEFERRED_FLUSH_PERIOD_MS);
+
+        Debug_API_LogFlush();
+    }
+
+    osThreadYield();
+}
+#endif
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -71,6 +481,28 @@ bool Debug_API_Init (const eUartBaudrate_t baudrate) {
         g_debug_api_mutex = osMutexNew(&g_debug_api_mutex_attributes);
     }
 
+    for (eTraceModule_t module = eTraceModule_First; module < eTraceModule_Last; module++) {
+        g_debug_api_module_level[module] = DEBUG_LEVEL_DEFAULT;
+    }
+
+    #ifdef ENABLE_DEBUG_DEFERRED
+    DWT_Driver_Init();
+
+    for (size_t slot = 0; slot < DEBUG_DEFERRED_RECORD_COUNT; slot++) {
+        atomic_store_explicit(&g_log_ring[slot].sequence, slot, memory_order_relaxed);
+    }
+
+    if (g_log_thread_id == NULL) {
+        g_log_thread_id = osThreadNew(Debug_API_LogThread, NULL, &g_log_thread_attributes);
+
+        Stack_API_Track(g_log_thread_id, LOG_THREAD_STACK_SIZE);
+    }
+
+    if (g_log_thread_id == NULL) {
+        return false;
+    }
+    #endif
+
     g_is_initialized = UART_API_Init(eUart_Debug, baudrate, DELIMITER);
 
     return g_is_initialized;
@@ -124,4 +556,212 @@ bool Debug_API_Print (const eTraceLevel_t trace_level, const char *file_trace, c
     return is_sent;
 }
 
+/**
+ * Raw text, without prefix and not subject to the trace levels. With ENABLE_DEBUG_DEFERRED it is sent at once as
+ * text records, ahead of traces that are still queued.
+ */
+bool Debug_API_Write (const char *data, const size_t size) {
+    if ((data == NULL) || (size == 0)) {
+        return false;
+    }
+
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    #ifdef ENABLE_DEBUG_DEFERRED
+    if (osMutexAcquire(g_debug_api_mutex, DEBUG_MESSAGE_TIMEOUT) != osOK) {
+        return false;
+    }
+
+    bool is_sent = true;
+
+    for (size_t offset = 0; is_sent && (offset < size); offset += DEBUG_DEFERRED_PAYLOAD_SIZE) {
+        size_t payload_length = ((size - offset) < DEBUG_DEFERRED_PAYLOAD_SIZE) ? (size - offset) : DEBUG_DEFERRED_PAYLOAD_SIZE;
+        size_t record_length = Debug_API_LogHeader(g_log_text_record, LOG_TEXT_FORMAT, 0, DWT_Driver_GetCycles(), 0, eTraceLevel_Info);
+
+        memcpy(&g_log_text_record[record_length], &data[offset], payload_length);
+        record_length += payload_length;
+
+        size_t frame_length = COBS_Encode(g_log_text_record, record_length, g_log_text_frame, (sizeof(g_log_text_frame) - 1U));
+
+        g_log_text_frame[frame_length++] = COBS_DELIMITER;
+
+        is_sent = UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_log_text_frame, .size = frame_length}, DEBUG_MESSAGE_TIMEOUT);
+    }
+
+    osMutexRelease(g_debug_api_mutex);
+
+    return is_sent;
+    #else
+    return UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) data, .size = size}, DEBUG_MESSAGE_TIMEOUT);
+    #endif
+}
+
+#ifdef ENABLE_DEBUG_DEFERRED
+/* Lock free and ISR safe, costs a format walk and a few stores instead of vsprintf and a UART transfer */
+bool Debug_API_Log (const eTraceLevel_t trace_level, const char *file_trace, const uint32_t line_number, const char *format, ...) {
+    if ((trace_level < eTraceLevel_First) || (trace_level >= eTraceLevel_Last)) {
+        return false;
+    }
+
+    if (format == NULL) {
+        return false;
+    }
+
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    size_t position = atomic_load_explicit(&g_log_head, memory_order_relaxed);
+
+    while (true) {
+        size_t sequence = atomic_load_explicit(&g_log_ring[position & LOG_RING_MASK].sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&g_log_head, &position, (position + 1U), memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            atomic_fetch_add_explicit(&g_log_dropped, 1, memory_order_relaxed);
+
+            return false;
+        } else {
+            position = atomic_load_explicit(&g_log_head, memory_order_relaxed);
+        }
+    }
+
+    size_t slot = position & LOG_RING_MASK;
+
+    g_log_ring[slot].format = (uint32_t) (uintptr_t) format;
+    g_log_ring[slot].module = (uint32_t) (uintptr_t) file_trace;
+    g_log_ring[slot].timestamp = DWT_Driver_GetCycles();
+    g_log_ring[slot].line = (uint16_t) line_number;
+    g_log_ring[slot].level = (uint8_t) trace_level;
+
+    va_list arguments;
+
+    va_start(arguments, format);
+
+    g_log_ring[slot].payload_length = (uint8_t) Debug_API_PackArguments(g_log_ring[slot].payload, format, &arguments);
+
+    va_end(arguments);
+
+    atomic_store_explicit(&g_log_ring[slot].sequence, (position + 1U), memory_order_release);
+
+    return true;
+}
+
+/* Wait free, a burst larger than the ring overwrites the oldest records and the flush reports them as dropped */
+void Debug_API_LogIsr (const char *file_trace, const uint32_t line_number, const char *format, const uint32_t value) {
+    if ((format == NULL) || !g_is_initialized) {
+        return;
+    }
+
+    size_t position = atomic_fetch_add_explicit(&g_log_isr_head, 1, memory_order_relaxed);
+    size_t slot = position & LOG_ISR_RING_MASK;
+
+    atomic_store_explicit(&g_log_isr_ring[slot].sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    g_log_isr_ring[slot].format = (uint32_t) (uintptr_t) format;
+    g_log_isr_ring[slot].module = (uint32_t) (uintptr_t) file_trace;
+    g_log_isr_ring[slot].timestamp = DWT_Driver_GetCycles();
+    g_log_isr_ring[slot].value = value;
+    g_log_isr_ring[slot].line = (uint16_t) line_number;
+
+    atomic_store_explicit(&g_log_isr_ring[slot].sequence, (position + 1U), memory_order_release);
+
+    return;
+}
+
+uint32_t Debug_API_GetDroppedLogs (void) {
+    return g_log_dropped_total + atomic_load_explicit(&g_log_dropped, memory_order_relaxed);
+}
+#endif
+
+bool Debug_API_SetModuleLevel (const eTraceModule_t module, const eTraceLevel_t trace_level) {
+    if ((module <= eTraceModule_None) || (module >= eTraceModule_Last)) {
+        return false;
+    }
+
+    if (Debug_API_GetModuleName(module) == NULL) {
+        return false;
+    }
+
+    if ((trace_level < eTraceLevel_First) || (trace_level > eTraceLevel_Last)) {
+        return false;
+    }
+
+    g_debug_api_module_level[module] = (uint8_t) trace_level;
+
+    return true;
+}
+
+bool Debug_API_GetModuleLevel (const eTraceModule_t module, eTraceLevel_t *trace_level) {
+    if ((module < eTraceModule_First) || (module >= eTraceModule_Last)) {
+        return false;
+    }
+
+    if (trace_level == NULL) {
+        return false;
+    }
+
+    *trace_level = (eTraceLevel_t) g_debug_api_module_level[module];
+
+    return true;
+}
+
+const char *Debug_API_GetModuleName (const eTraceModule_t module) {
+    if ((module < eTraceModule_First) || (module >= eTraceModule_Last)) {
+        return NULL;
+    }
+
+    if (module > eTraceModule_Project) {
+        return atomic_load_explicit(&g_debug_api_project_module_name[module - eTraceModule_Project - 1], memory_order_acquire);
+    }
+
+    return g_debug_api_module_name[module];
+}
+
+/* A name registered before gets its slot back, without a free slot the module stays on eTraceModule_Project */
+bool Debug_API_RegisterModule (const char *name, eTraceModule_t *module) {
+    if ((name == NULL) || (module == NULL)) {
+        return false;
+    }
+
+    for (size_t slot = 0; slot < DEBUG_PROJECT_MODULE_COUNT; slot++) {
+        const char *slot_name = NULL;
+
+        if (!atomic_compare_exchange_strong_explicit(&g_debug_api_project_module_name[slot], &slot_name, name, memory_order_acq_rel, memory_order_acquire) && (strcmp(slot_name, name) != 0)) {
+            continue;
+        }
+
+        *module = (eTraceModule_t) (eTraceModule_Project + 1 + slot);
+
+        return true;
+    }
+
+    return false;
+}
+
+/* Racing callers of one call site may both pass, a duplicate line is cheaper than a lock */
+bool Debug_API_IsRateAllowed (sTraceRateLimit_t *limit, const uint32_t period_ms) {
+    if (limit == NULL) {
+        return false;
+    }
+
+    uint32_t tick = osKernelGetTickCount();
+
+    if (limit->is_started && ((tick - limit->last_tick) < period_ms)) {
+        return false;
+    }
+
+    limit->last_tick = tick;
+    limit->is_started = true;
+
+    return true;
+}
+
 #endif
@@ -16,17 +16,56 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
-#define CREATE_MODULE_NAME(file_name) static const char *trace_module_name = #file_name;
-#define CREATE_MODULE_NAME_EMPTY static const char *trace_module_name = NULL;
+/**
+ * Project modules use CREATE_MODULE_NAME and share the eTraceModule_Project level until TRACE_REGISTER_MODULE,
+ * called once from the module init, gives them a slot of their own (DEBUG_PROJECT_MODULE_COUNT slots).
+ * Framework modules have a fixed eTraceModule_t entry.
+ */
+#define CREATE_MODULE_NAME(file_name) static const char *trace_module_name __attribute__((unused)) = #file_name; static eTraceModule_t trace_module __attribute__((unused)) = eTraceModule_Project;
+#define CREATE_FRAMEWORK_MODULE_NAME(file_name) static const char *trace_module_name __attribute__((unused)) = #file_name; static const eTraceModule_t trace_module __attribute__((unused)) = eTraceModule_##file_name;
+#define CREATE_MODULE_NAME_EMPTY static const char *trace_module_name __attribute__((unused)) = NULL; static const eTraceModule_t trace_module __attribute__((unused)) = eTraceModule_None;
 
+/* A file may define TRACE_LEVEL_FLOOR before including this header to strip its own lower level traces */
+#ifndef TRACE_LEVEL_FLOOR
+#define TRACE_LEVEL_FLOOR DEBUG_LEVEL_FLOOR
+#endif
+
+/**
+ * With ENABLE_DEBUG_DEFERRED the macros only queue the format address, a timestamp and the raw arguments.
+ * Tools/trace_decoder.py rebuilds the text from the ELF. The format must be a string literal.
+ * TRACE_ISR is wait free and takes exactly one integer argument, it is the only trace allowed in interrupt context.
+ */
+#if defined(ENABLE_DEBUG) && defined(ENABLE_DEBUG_DEFERRED)
+#define TRACE_EMIT(level, format, ...) Debug_API_Log(level, trace_module_name, __LINE__, format, ##__VA_ARGS__)
+#define TRACE_ISR(format, value) do { if (TRACE_IS_ENABLED(eTraceLevel_Error)) { Debug_API_LogIsr(trace_module_name, __LINE__, format, (uint32_t) (value)); } } while (0)
+#elif defined(ENABLE_DEBUG)
+#define TRACE_EMIT(level, format, ...) Debug_API_Print(level, trace_module_name, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#define TRACE_ISR(format, value)
+#endif
+
+/**
+ * The level is checked before the arguments are evaluated. A filtered trace costs one load and one compare,
+ * traces below TRACE_LEVEL_FLOOR and traces of CREATE_MODULE_NAME_EMPTY modules are removed by the compiler.
+ * The _LIMIT variants print at most once per period_ms from each call site.
+ */
 #ifdef ENABLE_DEBUG
-#define TRACE_INFO(format, ...) Debug_API_Print(eTraceLevel_Info, trace_module_name,__FILE__, __LINE__, format, ##__VA_ARGS__)
-#define TRACE_WRN(format, ...) Debug_API_Print(eTraceLevel_Warning, trace_module_name,__FILE__, __LINE__, format, ##__VA_ARGS__)
-#define TRACE_ERR(format, ...) Debug_API_Print(eTraceLevel_Error, trace_module_name, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#define TRACE_IS_ENABLED(level) (((level) >= TRACE_LEVEL_FLOOR) && (trace_module != eTraceModule_None) && ((level) >= g_debug_api_module_level[trace_module]))
+#define TRACE_AT(level, format, ...) do { if (TRACE_IS_ENABLED(level)) { TRACE_EMIT(level, format, ##__VA_ARGS__); } } while (0)
+#define TRACE_AT_LIMIT(level, period_ms, format, ...) do { static sTraceRateLimit_t trace_limit = {0}; if (TRACE_IS_ENABLED(level) && Debug_API_IsRateAllowed(&trace_limit, (period_ms))) { TRACE_EMIT(level, format, ##__VA_ARGS__); } } while (0)
+#define TRACE_INFO(format, ...) TRACE_AT(eTraceLevel_Info, format, ##__VA_ARGS__)
+#define TRACE_WRN(format, ...) TRACE_AT(eTraceLevel_Warning, format, ##__VA_ARGS__)
+#define TRACE_ERR(format, ...) TRACE_AT(eTraceLevel_Error, format, ##__VA_ARGS__)
+#define TRACE_WRN_LIMIT(period_ms, format, ...) TRACE_AT_LIMIT(eTraceLevel_Warning, period_ms, format, ##__VA_ARGS__)
+#define TRACE_ERR_LIMIT(period_ms, format, ...) TRACE_AT_LIMIT(eTraceLevel_Error, period_ms, format, ##__VA_ARGS__)
+#define TRACE_REGISTER_MODULE() Debug_API_RegisterModule(trace_module_name, &trace_module)
 #else
 #define TRACE_INFO(format, ...)
 #define TRACE_WRN(format, ...)
 #define TRACE_ERR(format, ...)
+#define TRACE_WRN_LIMIT(period_ms, format, ...)
+#define TRACE_ERR_LIMIT(period_ms, format, ...)
+#define TRACE_ISR(format, value)
+#define TRACE_REGISTER_MODULE() ((void) 0)
 #endif
 
 /**********************************************************************************************************************
@@ -41,17 +80,55 @@ typedef enum eTraceLevel {
     eTraceLevel_Error,
     eTraceLevel_Last
 } eTraceLevel_t;
+
+/* Setting a module to eTraceLevel_Last mutes it */
+typedef enum eTraceModule {
+    eTraceModule_First = 0,
+    eTraceModule_None = eTraceModule_First,
+    eTraceModule_IO_API,
+    eTraceModule_I2C_API,
+    eTraceModule_CMD_API,
+    eTraceModule_CMD_API_HELPER,
+    eTraceModule_STACK_API,
+    eTraceModule_CPU_API,
+    eTraceModule_WS2812B_API,
+    eTraceModule_VL53L0XV2_API,
+    eTraceModule_CLI_APP,
+    eTraceModule_CLI_CMD_HANDLERS,
+    eTraceModule_LED_APP,
+    eTraceModule_Motor_APP,
+    eTraceModule_Project,
+    eTraceModule_Last = eTraceModule_Project + 1 + DEBUG_PROJECT_MODULE_COUNT
+} eTraceModule_t;
+
+typedef struct sTraceRateLimit {
+    uint32_t last_tick;
+    bool is_started;
+} sTraceRateLimit_t;
 /* clang-format on */
 
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
 
+#ifdef ENABLE_DEBUG
+extern uint8_t g_debug_api_module_level[eTraceModule_Last];
+#endif
+
 /**********************************************************************************************************************
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
 bool Debug_API_Init (const eUartBaudrate_t baudrate);
 bool Debug_API_Print (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...);
+bool Debug_API_Write (const char *data, const size_t size);
+bool Debug_API_Log (const eTraceLevel_t trace_level, const char *file_trace, const uint32_t line_number, const char *format, ...);
+void Debug_API_LogIsr (const char *file_trace, const uint32_t line_number, const char *format, const uint32_t value);
+uint32_t Debug_API_GetDroppedLogs (void);
+bool Debug_API_SetModuleLevel (const eTraceModule_t module, const eTraceLevel_t trace_level);
+bool Debug_API_GetModuleLevel (const eTraceModule_t module, eTraceLevel_t *trace_level);
+const char *Debug_API_GetModuleName (const eTraceModule_t module);
+bool Debug_API_RegisterModule (const char *name, eTraceModule_t *module);
+bool Debug_API_IsRateAllowed (sTraceRateLimit_t *limit, const uint32_t period_ms);
 
 #endif /* SOURCE_API_DEBUG_API_H_ */
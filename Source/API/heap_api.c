@@ -4,35 +4,213 @@
 
 #include "heap_api.h"
 
+#include <stdatomic.h>
+#include <string.h>
+#include <malloc.h>
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
-#define MUTEX_TIMEOUT 0U
+#define MUTEX_TIMEOUT osWaitForever
+
+/* Free list head: block index + 1 in the low half (0 = empty), a tag against ABA in the high half */
+#define POOL_HEAD_INDEX_MASK 0xFFFFUL
+#define POOL_HEAD_TAG_STEP 0x10000UL
+#define POOL_MAX_BLOCKS 0xFFFFUL
+
+/* Core coupled memory of STM32F405/407/415/417/42x/43x, only the CPU can reach it */
+#define CCM_RAM_START 0x10000000UL
+#define CCM_RAM_END 0x10010000UL
 
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
- 
+
+typedef struct sHeapPoolDesc {
+    uint8_t *storage;
+    uint16_t *next;
+    size_t block_size;
+    size_t block_count;
+} sHeapPoolDesc_t;
+
+typedef struct sHeapPoolDynamic {
+    atomic_uint_least32_t free_head;
+    atomic_size_t unused_index;
+    atomic_size_t in_use;
+    size_t high_water_mark;
+} sHeapPoolDynamic_t;
+
+#ifdef ENABLE_HEAP_TRACKING
+typedef struct sHeapRecord {
+    void *pointer;
+    size_t size;
+    uint16_t call_site;
+} sHeapRecord_t;
+#endif
+
+#if HEAP_POOL_16_BLOCKS > 0
+_Static_assert(HEAP_POOL_16_BLOCKS <= POOL_MAX_BLOCKS, "HEAP_POOL_16_BLOCKS is too large");
+static uint8_t g_heap_pool_16_storage[HEAP_POOL_16_BLOCKS][16] __attribute__((aligned(16)));
+static uint16_t g_heap_pool_16_next[HEAP_POOL_16_BLOCKS];
+#endif
+
+#if HEAP_POOL_32_BLOCKS > 0
+_Static_assert(HEAP_POOL_32_BLOCKS <= POOL_MAX_BLOCKS, "HEAP_POOL_32_BLOCKS is too large");
+static uint8_t g_heap_pool_32_storage[HEAP_POOL_32_BLOCKS][32] __attribute__((aligned(32)));
+static uint16_t g_heap_pool_32_next[HEAP_POOL_32_BLOCKS];
+#endif
+
+#if HEAP_POOL_64_BLOCKS > 0
+_Static_assert(HEAP_POOL_64_BLOCKS <= POOL_MAX_BLOCKS, "HEAP_POOL_64_BLOCKS is too large");
+static uint8_t g_heap_pool_64_storage[HEAP_POOL_64_BLOCKS][64] __attribute__((aligned(64)));
+static uint16_t g_heap_pool_64_next[HEAP_POOL_64_BLOCKS];
+#endif
+
+#if HEAP_POOL_128_BLOCKS > 0
+_Static_assert(HEAP_POOL_128_BLOCKS <= POOL_MAX_BLOCKS, "HEAP_POOL_128_BLOCKS is too large");
+static uint8_t g_heap_pool_128_storage[HEAP_POOL_128_BLOCKS][128] __attribute__((aligned(128)));
+static uint16_t g_heap_pool_128_next[HEAP_POOL_128_BLOCKS];
+#endif
+
+#if HEAP_POOL_256_BLOCKS > 0
+_Static_assert(HEAP_POOL_256_BLOCKS <= POOL_MAX_BLOCKS, "HEAP_POOL_256_BLOCKS is too large");
+static uint8_t g_heap_pool_256_storage[HEAP_POOL_256_BLOCKS][256] __attribute__((aligned(256)));
+static uint16_t g_heap_pool_256_next[HEAP_POOL_256_BLOCKS];
+#endif
+
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticSemaphore_t g_heap_mutex_cb;
+#endif
+
 const static osMutexAttr_t g_heap_mutex_attributes = {
     .name = "Heap_mutex", 
     .attr_bits = osMutexRecursive | osMutexPrioInherit, 
-    .cb_mem = NULL, 
-    .cb_size = 0U
+    .cb_mem = RTOS_STATIC_MEM(g_heap_mutex_cb), 
+    .cb_size = RTOS_STATIC_SIZE(g_heap_mutex_cb)
 };
 
+/* clang-format off */
+const static sHeapPoolDesc_t g_static_heap_pool_lut[eHeapPool_Last] = {
+    #if HEAP_POOL_16_BLOCKS > 0
+    [eHeapPool_16] = {
+        .storage = &g_heap_pool_16_storage[0][0],
+        .next = g_heap_pool_16_next,
+        .block_size = 16,
+        .block_count = HEAP_POOL_16_BLOCKS
+    },
+    #endif
+
+    #if HEAP_POOL_32_BLOCKS > 0
+    [eHeapPool_32] = {
+        .storage = &g_heap_pool_32_storage[0][0],
+        .next = g_heap_pool_32_next,
+        .block_size = 32,
+        .block_count = HEAP_POOL_32_BLOCKS
+    },
+    #endif
+
+    #if HEAP_POOL_64_BLOCKS > 0
+    [eHeapPool_64] = {
+        .storage = &g_heap_pool_64_storage[0][0],
+        .next = g_heap_pool_64_next,
+        .block_size = 64,
+        .block_count = HEAP_POOL_64_BLOCKS
+    },
+    #endif
+
+    #if HEAP_POOL_128_BLOCKS > 0
+    [eHeapPool_128] = {
+        .storage = &g_heap_pool_128_storage[0][0],
+        .next = g_heap_pool_128_next,
+        .block_size = 128,
+        .block_count = HEAP_POOL_128_BLOCKS
+    },
+    #endif
+
+    #if HEAP_POOL_256_BLOCKS > 0
+    [eHeapPool_256] = {
+        .storage = &g_heap_pool_256_storage[0][0],
+        .next = g_heap_pool_256_next,
+        .block_size = 256,
+        .block_count = HEAP_POOL_256_BLOCKS
+    },
+    #endif
+};
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 
 static osMutexId_t g_heap_mutex = NULL;
 
+#ifdef ENABLE_HEAP_TRACKING
+static sHeapStats_t g_heap_stats = {0};
+static sHeapCallSite_t g_heap_call_sites[HEAP_TRACKING_MAX_CALL_SITES] = {0};
+static size_t g_heap_call_site_count = 0;
+static sHeapRecord_t g_heap_records[HEAP_TRACKING_MAX_ALLOCATIONS] = {0};
+/* Bumped without the lock, so from ISRs too */
+static atomic_uint_least32_t g_heap_failed_allocations = 0;
+static atomic_uint_least32_t g_heap_untracked_allocations = 0;
+static atomic_uint_least32_t g_heap_untracked_frees = 0;
+#endif
+
+/* clang-format off */
+static sHeapPoolDynamic_t g_dynamic_heap_pool_lut[eHeapPool_Last] = {
+    #if HEAP_POOL_16_BLOCKS > 0
+    [eHeapPool_16] = {
+        .free_head = 0,
+        .unused_index = 0,
+        .in_use = 0,
+        .high_water_mark = 0
+    },
+    #endif
+
+    #if HEAP_POOL_32_BLOCKS > 0
+    [eHeapPool_32] = {
+        .free_head = 0,
+        .unused_index = 0,
+        .in_use = 0,
+        .high_water_mark = 0
+    },
+    #endif
+
+    #if HEAP_POOL_64_BLOCKS > 0
+    [eHeapPool_64] = {
+        .free_head = 0,
+        .unused_index = 0,
+        .in_use = 0,
+        .high_water_mark = 0
+    },
+    #endif
+
+    #if HEAP_POOL_128_BLOCKS > 0
+    [eHeapPool_128] = {
+        .free_head = 0,
+        .unused_index = 0,
+        .in_use = 0,
+        .high_water_mark = 0
+    },
+    #endif
+
+    #if HEAP_POOL_256_BLOCKS > 0
+    [eHeapPool_256] = {
+        .free_head = 0,
+        .unused_index = 0,
+        .in_use = 0,
+        .high_water_mark = 0
+    },
+    #endif
+};
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
@@ -41,10 +219,220 @@ static osMutexId_t g_heap_mutex = NULL;
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static void *Heap_API_PoolAllocate (const size_t size, const size_t alignment);
+static void *Heap_API_HeapAllocate (const size_t size, const size_t alignment);
+static bool Heap_API_PoolFree (void *pointer_to_memory);
+#ifdef ENABLE_HEAP_TRACKING
+static size_t Heap_API_FindRecord (const void *pointer_to_memory);
+static void Heap_API_RetireRecord (const size_t slot);
+static void Heap_API_TrackAllocate (void *pointer_to_memory, const size_t size, const char *file, const uint32_t line);
+static void Heap_API_TrackFree (void *pointer_to_memory);
+#endif
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+/**
+ * Lock free and O(1), usable from ISRs. Blocks come from the free list first, untouched blocks are handed out in order.
+ * Pool storage is aligned to the block size, so every block is aligned to its own size.
+ */
+static void *Heap_API_PoolAllocate (const size_t size, const size_t alignment) {
+    for (eHeapPool_t pool = (eHeapPool_First + 1); pool < eHeapPool_Last; pool++) {
+        if ((size > g_static_heap_pool_lut[pool].block_size) || (alignment > g_static_heap_pool_lut[pool].block_size)) {
+            continue;
+        }
+
+        size_t index = 0;
+        bool is_found = false;
+        uint_least32_t head = atomic_load_explicit(&g_dynamic_heap_pool_lut[pool].free_head, memory_order_acquire);
+
+        while (!is_found && ((head & POOL_HEAD_INDEX_MASK) != 0)) {
+            index = (head & POOL_HEAD_INDEX_MASK) - 1;
+
+            uint_least32_t next_head = ((head & ~POOL_HEAD_INDEX_MASK) + POOL_HEAD_TAG_STEP) | g_static_heap_pool_lut[pool].next[index];
+
+            is_found = atomic_compare_exchange_weak_explicit(&g_dynamic_heap_pool_lut[pool].free_head, &head, next_head, memory_order_acq_rel, memory_order_acquire);
+        }
+
+        if (!is_found) {
+            index = atomic_load_explicit(&g_dynamic_heap_pool_lut[pool].unused_index, memory_order_relaxed);
+
+            while (!is_found && (index < g_static_heap_pool_lut[pool].block_count)) {
+                is_found = atomic_compare_exchange_weak_explicit(&g_dynamic_heap_pool_lut[pool].unused_index, &index, index + 1, memory_order_relaxed, memory_order_relaxed);
+            }
+        }
+
+        /* A full pool falls through to the next size class */
+        if (!is_found) {
+            continue;
+        }
+
+        size_t in_use = atomic_fetch_add_explicit(&g_dynamic_heap_pool_lut[pool].in_use, 1, memory_order_relaxed) + 1;
+
+        if (in_use > g_dynamic_heap_pool_lut[pool].high_water_mark) {
+            g_dynamic_heap_pool_lut[pool].high_water_mark = in_use;
+        }
+
+        return &g_static_heap_pool_lut[pool].storage[index * g_static_heap_pool_lut[pool].block_size];
+    }
+
+    return NULL;
+}
+
+/* Oversized requests and exhausted pools fall back to the general heap, which is not available from ISRs */
+static void *Heap_API_HeapAllocate (const size_t size, const size_t alignment) {
+    if (g_heap_mutex == NULL) {
+        return NULL;
+    }
+    
+    if (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK) {
+        return NULL;
+    }
+
+    void *allocated_memory = NULL;
+
+    if (alignment <= HEAP_API_DEFAULT_ALIGNMENT) {
+        allocated_memory = malloc(size);
+    } else {
+        allocated_memory = memalign(alignment, size);
+    }
+
+    osMutexRelease(g_heap_mutex);
+
+    return allocated_memory;
+}
+
+static bool Heap_API_PoolFree (void *pointer_to_memory) {
+    uint8_t *block = pointer_to_memory;
+
+    for (eHeapPool_t pool = (eHeapPool_First + 1); pool < eHeapPool_Last; pool++) {
+        if ((block < g_static_heap_pool_lut[pool].storage) || (block >= (g_static_heap_pool_lut[pool].storage + (g_static_heap_pool_lut[pool].block_count * g_static_heap_pool_lut[pool].block_size)))) {
+            continue;
+        }
+
+        size_t offset = block - g_static_heap_pool_lut[pool].storage;
+
+        if ((offset % g_static_heap_pool_lut[pool].block_size) != 0) {
+            return false;
+        }
+
+        size_t index = offset / g_static_heap_pool_lut[pool].block_size;
+        uint_least32_t head = atomic_load_explicit(&g_dynamic_heap_pool_lut[pool].free_head, memory_order_relaxed);
+        uint_least32_t new_head = 0;
+
+        do {
+            g_static_heap_pool_lut[pool].next[index] = head & POOL_HEAD_INDEX_MASK;
+            new_head = ((head & ~POOL_HEAD_INDEX_MASK) + POOL_HEAD_TAG_STEP) | (index + 1);
+        } while (!atomic_compare_exchange_weak_explicit(&g_dynamic_heap_pool_lut[pool].free_head, &head, new_head, memory_order_release, memory_order_relaxed));
+
+        atomic_fetch_sub_explicit(&g_dynamic_heap_pool_lut[pool].in_use, 1, memory_order_relaxed);
+
+        return true;
+    }
+
+    return false;
+}
+
+#ifdef ENABLE_HEAP_TRACKING
+static size_t Heap_API_FindRecord (const void *pointer_to_memory) {
+    size_t slot = 0;
+
+    while ((slot < HEAP_TRACKING_MAX_ALLOCATIONS) && (g_heap_records[slot].pointer != pointer_to_memory)) {
+        slot++;
+    }
+
+    return slot;
+}
+
+static void Heap_API_RetireRecord (const size_t slot) {
+    g_heap_call_sites[g_heap_records[slot].call_site].live_allocations--;
+    g_heap_call_sites[g_heap_records[slot].call_site].live_bytes -= g_heap_records[slot].size;
+
+    g_heap_stats.live_allocations--;
+    g_heap_stats.live_bytes -= g_heap_records[slot].size;
+
+    g_heap_records[slot].pointer = NULL;
+
+    return;
+}
+
+static void Heap_API_TrackAllocate (void *pointer_to_memory, const size_t size, const char *file, const uint32_t line) {
+    if ((g_heap_mutex == NULL) || (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK)) {
+        atomic_fetch_add_explicit(&g_heap_untracked_allocations, 1, memory_order_relaxed);
+
+        return;
+    }
+
+    size_t call_site = 0;
+
+    while ((call_site < g_heap_call_site_count) && ((g_heap_call_sites[call_site].line != line) || (g_heap_call_sites[call_site].file != file))) {
+        call_site++;
+    }
+
+    if ((call_site == g_heap_call_site_count) && (g_heap_call_site_count < HEAP_TRACKING_MAX_CALL_SITES)) {
+        g_heap_call_sites[call_site].file = file;
+        g_heap_call_sites[call_site].line = line;
+        g_heap_call_site_count++;
+    }
+
+    /* A record still holding this pointer was left behind by an untracked free */
+    size_t slot = Heap_API_FindRecord(pointer_to_memory);
+
+    if (slot < HEAP_TRACKING_MAX_ALLOCATIONS) {
+        Heap_API_RetireRecord(slot);
+    } else {
+        slot = Heap_API_FindRecord(NULL);
+    }
+
+    if ((call_site == g_heap_call_site_count) || (slot == HEAP_TRACKING_MAX_ALLOCATIONS)) {
+        atomic_fetch_add_explicit(&g_heap_untracked_allocations, 1, memory_order_relaxed);
+
+        osMutexRelease(g_heap_mutex);
+
+        return;
+    }
+
+    g_heap_records[slot].pointer = pointer_to_memory;
+    g_heap_records[slot].size = size;
+    g_heap_records[slot].call_site = call_site;
+
+    g_heap_call_sites[call_site].total_allocations++;
+    g_heap_call_sites[call_site].live_allocations++;
+    g_heap_call_sites[call_site].live_bytes += size;
+
+    g_heap_stats.live_allocations++;
+    g_heap_stats.live_bytes += size;
+
+    if (g_heap_stats.live_bytes > g_heap_stats.peak_bytes) {
+        g_heap_stats.peak_bytes = g_heap_stats.live_bytes;
+    }
+
+    osMutexRelease(g_heap_mutex);
+
+    return;
+}
+
+/* Frees from an ISR can not take the lock, their record stays live until the pointer is handed out again */
+static void Heap_API_TrackFree (void *pointer_to_memory) {
+    if ((g_heap_mutex == NULL) || (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK)) {
+        atomic_fetch_add_explicit(&g_heap_untracked_frees, 1, memory_order_relaxed);
+
+        return;
+    }
+
+    size_t slot = Heap_API_FindRecord(pointer_to_memory);
+
+    if (slot < HEAP_TRACKING_MAX_ALLOCATIONS) {
+        Heap_API_RetireRecord(slot);
+    }
+
+    osMutexRelease(g_heap_mutex);
+
+    return;
+}
+#endif
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -66,27 +454,73 @@ void* Heap_API_MemoryAllocate(const size_t number_of_elements, const size_t size
         return NULL;
     }
 
-    if (g_heap_mutex == NULL) {
+    if (size > (SIZE_MAX / number_of_elements)) {
         return NULL;
     }
-    
-    if (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK) {
+
+    return Heap_API_MemoryAllocateEx(number_of_elements * size, HEAP_API_DEFAULT_ALIGNMENT, HEAP_API_FLAG_ZERO);
+}
+
+/* alignment must be a power of two, memory is only cleared with HEAP_API_FLAG_ZERO */
+void* Heap_API_MemoryAllocateEx (const size_t size, const size_t alignment, const uint32_t flags) {
+    if (size == 0) {
         return NULL;
     }
 
-    void *allocated_memory = NULL;
+    if ((alignment == 0) || ((alignment & (alignment - 1)) != 0)) {
+        return NULL;
+    }
 
-    allocated_memory = calloc(number_of_elements, size);
+    void *allocated_memory = Heap_API_PoolAllocate(size, alignment);
 
-    osMutexRelease(g_heap_mutex);
+    if (allocated_memory == NULL) {
+        allocated_memory = Heap_API_HeapAllocate(size, alignment);
+    }
+
+    if (allocated_memory == NULL) {
+        return NULL;
+    }
+
+    if (((flags & HEAP_API_FLAG_DMA) != 0) && !Heap_API_IsDmaCapable(allocated_memory, size)) {
+        Heap_API_Free(allocated_memory);
+
+        return NULL;
+    }
+
+    if ((flags & HEAP_API_FLAG_ZERO) != 0) {
+        memset(allocated_memory, 0, size);
+    }
 
     return allocated_memory;
 }
 
+bool Heap_API_IsDmaCapable (const void *pointer_to_memory, const size_t size) {
+    if ((pointer_to_memory == NULL) || (size == 0)) {
+        return false;
+    }
+
+    uintptr_t start = (uintptr_t) pointer_to_memory;
+    uintptr_t end = start + size;
+
+    return ((end <= CCM_RAM_START) || (start >= CCM_RAM_END));
+}
+
 bool Heap_API_Free (void *pointer_to_memory) {
     if (pointer_to_memory == NULL) {
         return false;
     }
+
+    #ifdef ENABLE_HEAP_TRACKING
+    Heap_API_TrackFree(pointer_to_memory);
+    #endif
+
+    if (Heap_API_PoolFree(pointer_to_memory)) {
+        return true;
+    }
+
+    if (g_heap_mutex == NULL) {
+        return false;
+    }
     
     if (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK) {
         return false;
@@ -98,3 +532,139 @@ bool Heap_API_Free (void *pointer_to_memory) {
 
     return true;
 }
+
+bool Heap_API_GetPoolStats (const eHeapPool_t pool, sHeapPoolStats_t *stats) {
+    if ((pool <= eHeapPool_First) || (pool >= eHeapPool_Last)) {
+        return false;
+    }
+
+    if (stats == NULL) {
+        return false;
+    }
+
+    stats->block_size = g_static_heap_pool_lut[pool].block_size;
+    stats->block_count = g_static_heap_pool_lut[pool].block_count;
+    stats->in_use = atomic_load(&g_dynamic_heap_pool_lut[pool].in_use);
+    stats->high_water_mark = g_dynamic_heap_pool_lut[pool].high_water_mark;
+
+    return true;
+}
+
+#ifdef ENABLE_HEAP_TRACKING
+void* Heap_API_MemoryAllocateTracked (const size_t number_of_elements, const size_t size, const char *file, const uint32_t line) {
+    void *allocated_memory = Heap_API_MemoryAllocate(number_of_elements, size);
+
+    if (allocated_memory == NULL) {
+        atomic_fetch_add_explicit(&g_heap_failed_allocations, 1, memory_order_relaxed);
+
+        return NULL;
+    }
+
+    Heap_API_TrackAllocate(allocated_memory, number_of_elements * size, file, line);
+
+    return allocated_memory;
+}
+
+void* Heap_API_MemoryAllocateExTracked (const size_t size, const size_t alignment, const uint32_t flags, const char *file, const uint32_t line) {
+    void *allocated_memory = Heap_API_MemoryAllocateEx(size, alignment, flags);
+
+    if (allocated_memory == NULL) {
+        atomic_fetch_add_explicit(&g_heap_failed_allocations, 1, memory_order_relaxed);
+
+        return NULL;
+    }
+
+    Heap_API_TrackAllocate(allocated_memory, size, file, line);
+
+    return allocated_memory;
+}
+
+bool Heap_API_GetStats (sHeapStats_t *stats) {
+    if (stats == NULL) {
+        return false;
+    }
+
+    if ((g_heap_mutex == NULL) || (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK)) {
+        return false;
+    }
+
+    /* arena is what sbrk handed to malloc, fordblks is the part of it sitting in free blocks */
+    struct mallinfo heap_info = mallinfo();
+
+    *stats = g_heap_stats;
+    stats->failed_allocations = atomic_load_explicit(&g_heap_failed_allocations, memory_order_relaxed);
+    stats->untracked_allocations = atomic_load_explicit(&g_heap_untracked_allocations, memory_order_relaxed);
+    stats->untracked_frees = atomic_load_explicit(&g_heap_untracked_frees, memory_order_relaxed);
+    stats->heap_arena_bytes = heap_info.arena;
+    stats->heap_free_bytes = heap_info.fordblks;
+
+    osMutexRelease(g_heap_mutex);
+
+    return true;
+}
+
+/* Ordered by live bytes, largest first */
+size_t Heap_API_GetTopCallSites (sHeapCallSite_t *call_sites, const size_t capacity) {
+    if ((call_sites == NULL) || (capacity == 0)) {
+        return 0;
+    }
+
+    if ((g_heap_mutex == NULL) || (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK)) {
+        return 0;
+    }
+
+    size_t count = 0;
+
+    for (size_t call_site = 0; call_site < g_heap_call_site_count; call_site++) {
+        size_t position = count;
+
+        while ((position > 0) && (call_sites[position - 1].live_bytes < g_heap_call_sites[call_site].live_bytes)) {
+            if (position < capacity) {
+                call_sites[position] = call_sites[position - 1];
+            }
+
+            position--;
+        }
+
+        if (position < capacity) {
+            call_sites[position] = g_heap_call_sites[call_site];
+        }
+
+        if (count < capacity) {
+            count++;
+        }
+    }
+
+    osMutexRelease(g_heap_mutex);
+
+    return count;
+}
+
+size_t Heap_API_GetAllocations (sHeapAllocation_t *allocations, const size_t capacity) {
+    if ((allocations == NULL) || (capacity == 0)) {
+        return 0;
+    }
+
+    if ((g_heap_mutex == NULL) || (osMutexAcquire(g_heap_mutex, MUTEX_TIMEOUT) != osOK)) {
+        return 0;
+    }
+
+    size_t count = 0;
+
+    for (size_t slot = 0; (slot < HEAP_TRACKING_MAX_ALLOCATIONS) && (count < capacity); slot++) {
+        if (g_heap_records[slot].pointer == NULL) {
+            continue;
+        }
+
+        allocations[count].pointer = g_heap_records[slot].pointer;
+        allocations[count].size = g_heap_records[slot].size;
+        allocations[count].file = g_heap_call_sites[g_heap_records[slot].call_site].file;
+        allocations[count].line = g_heap_call_sites[g_heap_records[slot].call_site].line;
+        count++;
+    }
+
+    osMutexRelease(g_heap_mutex);
+
+    return count;
+}
+#endif
@@ -7,18 +7,105 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include "framework_config.h"
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 
-#define Heap_API_Malloc(size) Heap_API_MemoryAllocate(1 ,size)
+#define HEAP_API_DEFAULT_ALIGNMENT 8U
+/* Word aligned so any DMA data width can be used */
+#define HEAP_API_DMA_ALIGNMENT 4U
+
+#define HEAP_API_FLAG_NONE 0x00U
+#define HEAP_API_FLAG_ZERO 0x01U
+#define HEAP_API_FLAG_DMA 0x02U
+
+/**
+ * Heap_API_Malloc does not clear the memory, Heap_API_Calloc does.
+ * Heap_API_MallocDma only returns memory the DMA controllers can reach (not CCM RAM).
+ */
+#ifdef ENABLE_HEAP_TRACKING
+#define Heap_API_Malloc(size) Heap_API_MemoryAllocateExTracked(size, HEAP_API_DEFAULT_ALIGNMENT, HEAP_API_FLAG_NONE, __FILE__, __LINE__)
+#define Heap_API_Calloc(number_of_elements, size) Heap_API_MemoryAllocateTracked(number_of_elements, size, __FILE__, __LINE__)
+#define Heap_API_MallocAligned(size, alignment) Heap_API_MemoryAllocateExTracked(size, alignment, HEAP_API_FLAG_NONE, __FILE__, __LINE__)
+#define Heap_API_MallocDma(size) Heap_API_MemoryAllocateExTracked(size, HEAP_API_DMA_ALIGNMENT, HEAP_API_FLAG_DMA, __FILE__, __LINE__)
+#else
+#define Heap_API_Malloc(size) Heap_API_MemoryAllocateEx(size, HEAP_API_DEFAULT_ALIGNMENT, HEAP_API_FLAG_NONE)
 #define Heap_API_Calloc(number_of_elements, size) Heap_API_MemoryAllocate(number_of_elements, size)
+#define Heap_API_MallocAligned(size, alignment) Heap_API_MemoryAllocateEx(size, alignment, HEAP_API_FLAG_NONE)
+#define Heap_API_MallocDma(size) Heap_API_MemoryAllocateEx(size, HEAP_API_DMA_ALIGNMENT, HEAP_API_FLAG_DMA)
+#endif
 
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef enum eHeapPool {
+    eHeapPool_First = 0,
+
+    #if HEAP_POOL_16_BLOCKS > 0
+    eHeapPool_16,
+    #endif
+
+    #if HEAP_POOL_32_BLOCKS > 0
+    eHeapPool_32,
+    #endif
+
+    #if HEAP_POOL_64_BLOCKS > 0
+    eHeapPool_64,
+    #endif
+
+    #if HEAP_POOL_128_BLOCKS > 0
+    eHeapPool_128,
+    #endif
+
+    #if HEAP_POOL_256_BLOCKS > 0
+    eHeapPool_256,
+    #endif
+
+    eHeapPool_Last
+} eHeapPool_t;
+/* clang-format on */
+
+typedef struct sHeapPoolStats {
+    size_t block_size;
+    size_t block_count;
+    size_t in_use;
+    size_t high_water_mark;
+} sHeapPoolStats_t;
+
+#ifdef ENABLE_HEAP_TRACKING
+/* Allocations and frees made from an ISR can not take the lock and are only counted as untracked */
+typedef struct sHeapStats {
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t live_allocations;
+    uint32_t failed_allocations;
+    uint32_t untracked_allocations;
+    uint32_t untracked_frees;
+    size_t heap_arena_bytes;
+    size_t heap_free_bytes;
+} sHeapStats_t;
+
+typedef struct sHeapCallSite {
+    const char *file;
+    uint32_t line;
+    uint32_t total_allocations;
+    uint32_t live_allocations;
+    size_t live_bytes;
+} sHeapCallSite_t;
+
+typedef struct sHeapAllocation {
+    void *pointer;
+    size_t size;
+    const char *file;
+    uint32_t line;
+} sHeapAllocation_t;
+#endif
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -29,6 +116,16 @@
 
 bool Heap_API_Init (void);
 void* Heap_API_MemoryAllocate(const size_t number_of_elements, const size_t size);
+void* Heap_API_MemoryAllocateEx (const size_t size, const size_t alignment, const uint32_t flags);
+bool Heap_API_IsDmaCapable (const void *pointer_to_memory, const size_t size);
 bool Heap_API_Free (void *pointer_to_memory);
+bool Heap_API_GetPoolStats (const eHeapPool_t pool, sHeapPoolStats_t *stats);
+#ifdef ENABLE_HEAP_TRACKING
+void* Heap_API_MemoryAllocateTracked (const size_t number_of_elements, const size_t size, const char *file, const uint32_t line);
+void* Heap_API_MemoryAllocateExTracked (const size_t size, const size_t alignment, const uint32_t flags, const char *file, const uint32_t line);
+bool Heap_API_GetStats (sHeapStats_t *stats);
+size_t Heap_API_GetTopCallSites (sHeapCallSite_t *call_sites, const size_t capacity);
+size_t Heap_API_GetAllocations (sHeapAllocation_t *allocations, const size_t capacity);
+#endif
 
 #endif /* SOURCE_API_HEAP_API_H_ */
@@ -7,8 +7,10 @@
 #ifdef USE_I2C1
 
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "i2c_driver.h"
 #include "debug_api.h"
+#include "span_api.h"
 #include "framework_config.h"
 
 /**********************************************************************************************************************
@@ -19,6 +21,7 @@
 
 #define MUTEX_TIMEOUT 0U
 #define BUS_RESET_TIMEOUT 1U
+#define ERROR_TRACE_PERIOD_MS 1000U
 
 #define I2C_FLAG_SUCCESS 0x01U
 #define I2C_FLAG_ERROR 0x02U
@@ -69,18 +72,23 @@ typedef struct sI2cDynamicDesc {
  *********************************************************************************************************************/
 
 #ifdef DEBUG_I2C_API
-CREATE_MODULE_NAME (I2C_API)
+CREATE_FRAMEWORK_MODULE_NAME (I2C_API)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticEventGroup_t g_i2c_flag_cb[eI2c_Last];
+static StaticSemaphore_t g_i2c_mutex_cb[eI2c_Last];
+#endif
+
 /* clang-format off */
 static const sI2cStaticDesc_t g_static_i2c_lut[eI2c_Last] = {
     #ifdef USE_I2C1
     [eI2c_1] = {
         .i2c_driver = eI2cDriver_1,
-        .flag_attributes = {.name = "I2C_API_1_EventFlag", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U},
-        .mutex_attributes = {.name = "I2C_API_1_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U}
+        .flag_attributes = {.name = "I2C_API_1_EventFlag", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_i2c_flag_cb[eI2c_1]), .cb_size = RTOS_STATIC_SIZE(g_i2c_flag_cb[eI2c_1])},
+        .mutex_attributes = {.name = "I2C_API_1_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_i2c_mutex_cb[eI2c_1]), .cb_size = RTOS_STATIC_SIZE(g_i2c_mutex_cb[eI2c_1])}
     }
     #endif
 };
@@ -201,7 +209,7 @@ static void I2C_API_IrsCallback (const eI2cDriver_Flags_t flag, void *context) {
 
     if (opperation != NULL) {
         if (!opperation(i2c->device)) {
-            TRACE_ERR("Invalid FSM State [%s]\n", I2C_API_GetStateString(i2c->state));
+            TRACE_ISR("Invalid FSM State [%u]\n", i2c->state);
 
             i2c->state = eI2cState_Error;
 
@@ -481,6 +489,8 @@ bool I2C_API_Init (const eI2c_t i2c) {
 }
 
 bool I2C_API_Write (const eI2c_t i2c, const uint8_t device_address, uint8_t *data, const size_t data_size, const uint16_t mem_address, const uint8_t mem_address_size, const uint32_t timeout) {
+    SPAN_SCOPE("i2c_write");
+
     if (!I2C_API_IsCorrectDevice(i2c)) {
         return false;
     }
@@ -537,14 +547,14 @@ bool I2C_API_Write (const eI2c_t i2c, const uint8_t device_address, uint8_t *dat
     if (g_dynamic_i2c[i2c].state == eI2cState_Error) {
         I2C_Driver_DisableIt(i2c);
 
-        TRACE_ERR("I2C Write: Error event flag [%d], I2C state: [%s]\n", (int32_t) flag, I2C_API_GetStateString(g_dynamic_i2c[i2c].previous_state));
+        TRACE_ERR_LIMIT(ERROR_TRACE_PERIOD_MS, "I2C Write: Error event flag [%d], I2C state: [%s]\n", (int32_t) flag, I2C_API_GetStateString(g_dynamic_i2c[i2c].previous_state));
 
         I2C_API_HandleError(i2c);
 
         flag = osEventFlagsWait(g_dynamic_i2c[i2c].flag, I2C_FLAG_BUS_RESET, osFlagsWaitAny, BUS_RESET_TIMEOUT);
 
         if (flag != (I2C_FLAG_BUS_RESET | I2C_FLAG_ERROR)) {
-            TRACE_ERR("I2C Read: Failed reset bus, received flag [%d]\n", (int32_t) flag);
+            TRACE_ERR_LIMIT(ERROR_TRACE_PERIOD_MS, "I2C Read: Failed reset bus, received flag [%d]\n", (int32_t) flag);
         }
 
         osEventFlagsClear(g_dynamic_i2c[i2c].flag, I2C_FLAG_ERROR);
@@ -564,6 +574,8 @@ bool I2C_API_Write (const eI2c_t i2c, const uint8_t device_address, uint8_t *dat
 }
 
 bool I2C_API_Read (const eI2c_t i2c, const uint8_t device_address, uint8_t *data, const size_t data_size, const uint16_t mem_address, const uint8_t mem_address_size, uint32_t timeout) {
+    SPAN_SCOPE("i2c_read");
+
     if (!I2C_API_IsCorrectDevice(i2c)) {
         return false;
     }
@@ -624,14 +636,14 @@ bool I2C_API_Read (const eI2c_t i2c, const uint8_t device_address, uint8_t *data
         
         I2C_Driver_DisableIt(i2c);
 
-        TRACE_ERR("I2C Read: Error event flag [%d], I2C state: [%s]\n", (int32_t) flag, I2C_API_GetStateString(g_dynamic_i2c[i2c].previous_state));
+        TRACE_ERR_LIMIT(ERROR_TRACE_PERIOD_MS, "I2C Read: Error event flag [%d], I2C state: [%s]\n", (int32_t) flag, I2C_API_GetStateString(g_dynamic_i2c[i2c].previous_state));
 
         I2C_API_HandleError(i2c);
 
         flag = osEventFlagsWait(g_dynamic_i2c[i2c].flag, I2C_FLAG_BUS_RESET, osFlagsWaitAny, BUS_RESET_TIMEOUT);
         
         if (flag != (I2C_FLAG_BUS_RESET | I2C_FLAG_ERROR)) {
-            TRACE_ERR("I2C Read: Failed reset bus, received flag [%d]\n", (int32_t) flag);
+            TRACE_ERR_LIMIT(ERROR_TRACE_PERIOD_MS, "I2C Read: Failed reset bus, received flag [%d]\n", (int32_t) flag);
         }
 
         osEventFlagsClear(g_dynamic_i2c[i2c].flag, I2C_FLAG_ERROR);
@@ -10,6 +10,8 @@
 #include "debug_api.h"
 #include "exti_driver.h"
 #include "gpio_driver.h"
+#include "rtos_static.h"
+#include "stack_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -21,6 +23,7 @@
 #define MESSAGE_QUEUE_TIMEOUT 5U
 #define MUTEX_TIMEOUT 0U
 #define IO_MESSAGE_CAPACITY 10
+#define IO_THREAD_STACK_SIZE (128 * 4)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -68,24 +71,36 @@ typedef struct sIoDynamic {
  *********************************************************************************************************************/
 
 #ifdef DEBUG_IO_API
-CREATE_MODULE_NAME (IO_API)
+CREATE_FRAMEWORK_MODULE_NAME (IO_API)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_io_thread_cb;
+static uint64_t g_io_thread_stack[RTOS_STACK_LENGTH(IO_THREAD_STACK_SIZE)];
+static StaticQueue_t g_io_message_queue_cb;
+static uint8_t g_io_message_queue_storage[IO_MESSAGE_CAPACITY * sizeof(eIo_t)];
+static StaticSemaphore_t g_io_mutex_cb[eIo_Last];
+static StaticTimer_t g_io_debounce_timer_cb[eIo_Last];
+#endif
+
 const static osThreadAttr_t g_io_thread_attributes = {
     .name = "IO_Thread",
-    .stack_size = 128 * 4,
+    .cb_mem = RTOS_STATIC_MEM(g_io_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_io_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_io_thread_stack),
+    .stack_size = IO_THREAD_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
 const static osMessageQueueAttr_t g_io_message_queue_attributes = {
     .name = "IO_API_MessageQueue", 
     .attr_bits = 0, 
-    .cb_mem = NULL, 
-    .cb_size = 0, 
-    .mq_mem = NULL, 
-    .mq_size = 0
+    .cb_mem = RTOS_STATIC_MEM(g_io_message_queue_cb), 
+    .cb_size = RTOS_STATIC_SIZE(g_io_message_queue_cb), 
+    .mq_mem = RTOS_STATIC_MEM(g_io_message_queue_storage), 
+    .mq_size = RTOS_STATIC_SIZE(g_io_message_queue_storage)
 };
 
 /* clang-format off */
@@ -99,8 +114,8 @@ const static sIoDesc_t g_static_io_desc_lut[eIo_Last] = {
         #ifdef START_BUTTON_ENABLE_DEBOUNCE
         .debounce_period = STARTSTOP_BUTTON_DEBOUNCE_PERIOD,
         #endif
-        .mutex_attributes = {.name = "StartStop_Button_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .debouce_timer_attributes = {.name = "StartStop_Button_Debounce_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0},
+        .mutex_attributes = {.name = "StartStop_Button_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_io_mutex_cb[eIo_StartStopButton]), .cb_size = RTOS_STATIC_SIZE(g_io_mutex_cb[eIo_StartStopButton])},
+        .debouce_timer_attributes = {.name = "StartStop_Button_Debounce_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_io_debounce_timer_cb[eIo_StartStopButton]), .cb_size = RTOS_STATIC_SIZE(g_io_debounce_timer_cb[eIo_StartStopButton])},
         .is_exti = START_BUTTON_EXTI,
         #ifdef START_BUTTON_EXTI
         .exti_device = eExtiDriver_StartButton
@@ -117,8 +132,8 @@ const static sIoDesc_t g_static_io_desc_lut[eIo_Last] = {
         #ifdef TCRT_RIGHT_ENABLE_DEBOUNCE
         .debounce_period = TCRT5000_DEBOUNCE_PERIOD,
         #endif
-        .mutex_attributes = {.name = "Tcrt5000_Right_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .debouce_timer_attributes = {.name = "Tcrt5000_Right_Debounce_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0},
+        .mutex_attributes = {.name = "Tcrt5000_Right_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_io_mutex_cb[eIo_Tcrt5000_Right]), .cb_size = RTOS_STATIC_SIZE(g_io_mutex_cb[eIo_Tcrt5000_Right])},
+        .debouce_timer_attributes = {.name = "Tcrt5000_Right_Debounce_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_io_debounce_timer_cb[eIo_Tcrt5000_Right]), .cb_size = RTOS_STATIC_SIZE(g_io_debounce_timer_cb[eIo_Tcrt5000_Right])},
         .is_exti = TCRT_RIGHT_EXTI,
         #ifdef TCRT_RIGHT_EXTI
         .exti_device = eExtiDriver_Tcrt5000_Right
@@ -135,8 +150,8 @@ const static sIoDesc_t g_static_io_desc_lut[eIo_Last] = {
         #ifdef TCRT_LEFT_ENABLE_DEBOUNCE
         .debounce_period = TCRT5000_DEBOUNCE_PERIOD,
         #endif
-        .mutex_attributes = {.name = "Tcrt5000_Left_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .debouce_timer_attributes = {.name = "Tcrt5000_Left_Debounce_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0},
+        .mutex_attributes = {.name = "Tcrt5000_Left_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_io_mutex_cb[eIo_Tcrt5000_Left]), .cb_size = RTOS_STATIC_SIZE(g_io_mutex_cb[eIo_Tcrt5000_Left])},
+        .debouce_timer_attributes = {.name = "Tcrt5000_Left_Debounce_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_io_debounce_timer_cb[eIo_Tcrt5000_Left]), .cb_size = RTOS_STATIC_SIZE(g_io_debounce_timer_cb[eIo_Tcrt5000_Left])},
         .is_exti = TCRT_LEFT_EXTI,
         #ifdef TCRT_LEFT_EXTI
         .exti_device = eExtiDriver_Tcrt5000_Left
@@ -387,6 +402,8 @@ bool IO_API_Init (eIo_t device, osEventFlagsId_t event_flags_id) {
 
     if (g_io_thread_id == NULL) {
         g_io_thread_id = osThreadNew(IO_API_Thread, NULL, &g_io_thread_attributes);
+
+        Stack_API_Track(g_io_thread_id, IO_THREAD_STACK_SIZE);
     }
 
     if (g_io_message_queue_id == NULL) {
@@ -7,6 +7,7 @@
 #if defined(USE_LED) || defined(USE_PWM_LED)
 
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "gpio_driver.h"
 #include "pwm_driver.h"
 #include "timer_driver.h"
@@ -67,6 +68,16 @@ typedef struct sLedPulseDesc {
  * Private constants
  *********************************************************************************************************************/
 
+#if defined(USE_STATIC_RTOS_OBJECTS) && defined(USE_LED)
+static StaticTimer_t g_led_blink_timer_cb[eLed_Last];
+static StaticSemaphore_t g_led_blink_mutex_cb[eLed_Last];
+#endif
+
+#if defined(USE_STATIC_RTOS_OBJECTS) && defined(USE_PWM_LED)
+static StaticTimer_t g_led_pulse_timer_cb[eLedPwm_Last];
+static StaticSemaphore_t g_led_pulse_mutex_cb[eLedPwm_Last];
+#endif
+
 /* clang-format off */
 #ifdef USE_LED
 const static sLedControlDesc_t g_basic_led_control_static_lut[eLed_Last] = {
@@ -74,8 +85,8 @@ const static sLedControlDesc_t g_basic_led_control_static_lut[eLed_Last] = {
     [eLed_OnboardLed] = {
         .led_pin = eGpioPin_OnboardLed,
         .is_inverted = USE_ONBOARD_LED_INVERTED,
-        .blink_timer_attributes = {.name = "LED_API_Onboard_LED_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0},
-        .blink_mutex_attributes = {.name = "LED_API_Onboard_LED_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
+        .blink_timer_attributes = {.name = "LED_API_Onboard_LED_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_led_blink_timer_cb[eLed_OnboardLed]), .cb_size = RTOS_STATIC_SIZE(g_led_blink_timer_cb[eLed_OnboardLed])},
+        .blink_mutex_attributes = {.name = "LED_API_Onboard_LED_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_led_blink_mutex_cb[eLed_OnboardLed]), .cb_size = RTOS_STATIC_SIZE(g_led_blink_mutex_cb[eLed_OnboardLed])},
     }
     #endif
 };
@@ -86,8 +97,8 @@ const static sLedPwmControlDesc_t g_pwm_led_control_static_lut[eLedPwm_Last] = {
     #ifdef USE_PULSE_LED
     [eLedPwm_PulseLed] = {
         .pwm_device = ePwmDevice_PulseLed,
-        .pulse_timer_attributes = {.name = "LED_API_Pulse_LED_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0},
-        .pulse_mutex_attributes = {.name = "LED_API_Pulse_LED_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
+        .pulse_timer_attributes = {.name = "LED_API_Pulse_LED_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_led_pulse_timer_cb[eLedPwm_PulseLed]), .cb_size = RTOS_STATIC_SIZE(g_led_pulse_timer_cb[eLedPwm_PulseLed])},
+        .pulse_mutex_attributes = {.name = "LED_API_Pulse_LED_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_led_pulse_mutex_cb[eLedPwm_PulseLed]), .cb_size = RTOS_STATIC_SIZE(g_led_pulse_mutex_cb[eLedPwm_PulseLed])},
     }
     #endif
 };
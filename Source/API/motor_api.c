@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "motor_driver.h"
 #include "pwm_driver.h"
 #include "timer_driver.h"
@@ -62,6 +63,11 @@ static void Motor_API_Statup_TimerCallback (void *arg);
  * Private constants
  *********************************************************************************************************************/
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticSemaphore_t g_motor_mutex_cb[eMotor_Last];
+static StaticTimer_t g_motor_timer_cb[eMotor_Last];
+#endif
+
 /* clang-format off */
 const static sMotorsRotation_t g_static_motor_rotation_lut[eMotor_Last] = {
     #ifdef USE_MOTOR_A
@@ -95,8 +101,8 @@ const static sMotorsRotation_t g_static_motor_rotation_lut[eMotor_Last] = {
 const static sMotorConst_t g_static_motor_lut[eMotor_Last] = {
     #ifdef USE_MOTOR_A
     [eMotor_Right] = {
-        .mutex_attributes = {.name = "Motor_A_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .timer_attributes = {.name = "Motor_A_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U},
+        .mutex_attributes = {.name = "Motor_A_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_motor_mutex_cb[eMotor_Right]), .cb_size = RTOS_STATIC_SIZE(g_motor_mutex_cb[eMotor_Right])},
+        .timer_attributes = {.name = "Motor_A_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_motor_timer_cb[eMotor_Right]), .cb_size = RTOS_STATIC_SIZE(g_motor_timer_cb[eMotor_Right])},
         .timer_callback = Motor_API_Statup_TimerCallback,
         .motor_speed_offset = MOTOR_RIGHT_SPEED_OFFSET
     },
@@ -104,8 +110,8 @@ const static sMotorConst_t g_static_motor_lut[eMotor_Last] = {
 
     #ifdef USE_MOTOR_B
     [eMotor_Left] = {
-        .mutex_attributes = {.name = "Motor_B_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .timer_attributes = {.name = "Motor_B_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U},
+        .mutex_attributes = {.name = "Motor_B_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_motor_mutex_cb[eMotor_Left]), .cb_size = RTOS_STATIC_SIZE(g_motor_mutex_cb[eMotor_Left])},
+        .timer_attributes = {.name = "Motor_B_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_motor_timer_cb[eMotor_Left]), .cb_size = RTOS_STATIC_SIZE(g_motor_timer_cb[eMotor_Left])},
         .timer_callback = Motor_API_Statup_TimerCallback,
         .motor_speed_offset = MOTOR_LEFT_SPEED_OFFSET
     }
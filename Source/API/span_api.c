@@ -0,0 +1,248 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "span_api.h"
+
+#ifdef ENABLE_SPAN_TRACE
+
+#include <stdatomic.h>
+#include <string.h>
+#include "cmsis_os2.h"
+#include "uart_api.h"
+#include "message.h"
+#include "cobs.h"
+#include "dwt_driver.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define SPAN_RING_MASK (SPAN_TRACE_EVENT_COUNT - 1U)
+#define SPAN_THREAD_NAME_SIZE 16U
+/* Header and thread frames are the largest, an event frame takes 18 bytes */
+#define SPAN_RECORD_MAX_SIZE (5U + SPAN_THREAD_NAME_SIZE)
+#define SPAN_FRAME_MAX_SIZE (COBS_ENCODED_MAX_SIZE(SPAN_RECORD_MAX_SIZE) + 1U)
+#define SPAN_MAX_THREADS 16U
+#define SPAN_TX_BUFFER_SIZE (SPAN_FRAME_MAX_SIZE * 8U)
+#define SPAN_HEADER_TAG 'H'
+#define SPAN_EVENT_TAG 'S'
+#define SPAN_THREAD_TAG 'T'
+#define SPAN_MAGIC 0x4E415053U
+#define SPAN_SEND_TIMEOUT 1000U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sSpanSlot {
+    uint32_t timestamp;
+    uint32_t name;
+    uint32_t thread;
+    uint32_t value;
+    uint8_t event;
+} sSpanSlot_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/* Flight recorder, the newest SPAN_TRACE_EVENT_COUNT events survive */
+static sSpanSlot_t g_span_ring[SPAN_TRACE_EVENT_COUNT];
+static atomic_size_t g_span_head = 0;
+static atomic_bool g_span_is_recording = false;
+static atomic_size_t g_span_writers = 0;
+
+static uint8_t g_span_tx_buffer[SPAN_TX_BUFFER_SIZE];
+static osThreadId_t g_span_threads[SPAN_MAX_THREADS];
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Span_API_PutUInt32 (uint8_t *buffer, size_t *length, const uint32_t value);
+static size_t Span_API_Encode (const uint8_t *frame, const size_t frame_length, size_t tx_length);
+static size_t Span_API_AddThread (const osThreadId_t thread, size_t thread_count);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Span_API_PutUInt32 (uint8_t *buffer, size_t *length, const uint32_t value) {
+    for (size_t byte = 0; byte < sizeof(uint32_t); byte++) {
+        buffer[*length] = (uint8_t) (value >> (byte * 8U));
+        (*length)++;
+    }
+
+    return;
+}
+
+static size_t Span_API_Encode (const uint8_t *frame, const size_t frame_length, size_t tx_length) {
+    if ((SPAN_TX_BUFFER_SIZE - tx_length) < SPAN_FRAME_MAX_SIZE) {
+        UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_span_tx_buffer, .size = tx_length}, SPAN_SEND_TIMEOUT);
+
+        tx_length = 0;
+    }
+
+    tx_length += COBS_Encode(frame, frame_length, &g_span_tx_buffer[tx_length], (SPAN_TX_BUFFER_SIZE - tx_length));
+    g_span_tx_buffer[tx_length] = COBS_DELIMITER;
+    tx_length++;
+
+    return tx_length;
+}
+
+static size_t Span_API_AddThread (const osThreadId_t thread, size_t thread_count) {
+    if (thread == NULL) {
+        return thread_count;
+    }
+
+    for (size_t index = 0; index < thread_count; index++) {
+        if (g_span_threads[index] == thread) {
+            return thread_count;
+        }
+    }
+
+    if (thread_count >= SPAN_MAX_THREADS) {
+        return thread_count;
+    }
+
+    g_span_threads[thread_count] = thread;
+
+    return thread_count + 1U;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+bool Span_API_Init (void) {
+    if (!DWT_Driver_Init()) {
+        return false;
+    }
+
+    atomic_store_explicit(&g_span_is_recording, true, memory_order_release);
+
+    return true;
+}
+
+/* Wait free and ISR safe, an event recorded in an ISR lands on the track of the interrupted thread */
+void Span_API_Record (const eSpanEvent_t event, const char *name, const uint32_t value) {
+    /* Sequentially consistent, pairs with the exchange in Span_API_Dump so no writer is missed */
+    atomic_fetch_add(&g_span_writers, 1);
+
+    if (!atomic_load(&g_span_is_recording)) {
+        atomic_fetch_sub_explicit(&g_span_writers, 1, memory_order_release);
+
+        return;
+    }
+
+    size_t slot = atomic_fetch_add_explicit(&g_span_head, 1, memory_order_relaxed) & SPAN_RING_MASK;
+
+    g_span_ring[slot].timestamp = DWT_Driver_GetCycles();
+    g_span_ring[slot].name = (uint32_t) (uintptr_t) name;
+    g_span_ring[slot].thread = (uint32_t) (uintptr_t) osThreadGetId();
+    g_span_ring[slot].value = value;
+    g_span_ring[slot].event = (uint8_t) event;
+
+    atomic_fetch_sub_explicit(&g_span_writers, 1, memory_order_release);
+
+    return;
+}
+
+const char *Span_API_BeginScope (const char *name) {
+    Span_API_Record(eSpanEvent_Begin, name, 0);
+
+    return name;
+}
+
+void Span_API_EndScope (const char **name) {
+    Span_API_Record(eSpanEvent_End, *name, 0);
+
+    return;
+}
+
+/* Pauses recording, streams the ring as COBS frames on the debug UART and starts a new recording */
+bool Span_API_Dump (void) {
+    if (!atomic_exchange(&g_span_is_recording, false)) {
+        return false;
+    }
+
+    while (atomic_load(&g_span_writers) != 0) {
+        osDelay(1);
+    }
+
+    size_t head = atomic_load_explicit(&g_span_head, memory_order_relaxed);
+    size_t count = (head > SPAN_TRACE_EVENT_COUNT) ? SPAN_TRACE_EVENT_COUNT : head;
+    uint8_t frame[SPAN_RECORD_MAX_SIZE];
+    size_t frame_length = 0;
+    size_t thread_count = 0;
+
+    for (size_t position = (head - count); position != head; position++) {
+        thread_count = Span_API_AddThread((osThreadId_t) (uintptr_t) g_span_ring[position & SPAN_RING_MASK].thread, thread_count);
+    }
+
+    /* A leading delimiter closes any partial text line so the converter sees the header as its own frame */
+    g_span_tx_buffer[0] = COBS_DELIMITER;
+    size_t tx_length = 1;
+
+    /* tag (1), magic (4), clock (4), thread count (4), event count (4), overwritten (4) */
+    frame[frame_length++] = SPAN_HEADER_TAG;
+    Span_API_PutUInt32(frame, &frame_length, SPAN_MAGIC);
+    Span_API_PutUInt32(frame, &frame_length, SYSTEM_CLOCK_HZ);
+    Span_API_PutUInt32(frame, &frame_length, (uint32_t) thread_count);
+    Span_API_PutUInt32(frame, &frame_length, (uint32_t) count);
+    Span_API_PutUInt32(frame, &frame_length, (uint32_t) (head - count));
+
+    tx_length = Span_API_Encode(frame, frame_length, tx_length);
+
+    /* FreeRTOS keeps thread names in the TCB, so they are sent as text instead of flash addresses */
+    for (size_t index = 0; index < thread_count; index++) {
+        const char *name = osThreadGetName(g_span_threads[index]);
+
+        /* tag (1), thread (4), name */
+        frame_length = 0;
+        frame[frame_length++] = SPAN_THREAD_TAG;
+        Span_API_PutUInt32(frame, &frame_length, (uint32_t) (uintptr_t) g_span_threads[index]);
+
+        if (name != NULL) {
+            size_t name_length = strnlen(name, SPAN_THREAD_NAME_SIZE);
+
+            memcpy(&frame[frame_length], name, name_length);
+            frame_length += name_length;
+        }
+
+        tx_length = Span_API_Encode(frame, frame_length, tx_length);
+    }
+
+    for (size_t position = (head - count); position != head; position++) {
+        size_t slot = position & SPAN_RING_MASK;
+
+        frame_length = 0;
+        /* tag (1), event (1), timestamp (4), name (4), thread (4), value (4) */
+        frame[frame_length++] = SPAN_EVENT_TAG;
+        frame[frame_length++] = g_span_ring[slot].event;
+        Span_API_PutUInt32(frame, &frame_length, g_span_ring[slot].timestamp);
+        Span_API_PutUInt32(frame, &frame_length, g_span_ring[slot].name);
+        Span_API_PutUInt32(frame, &frame_length, g_span_ring[slot].thread);
+        Span_API_PutUInt32(frame, &frame_length, g_span_ring[slot].value);
+
+        tx_length = Span_API_Encode(frame, frame_length, tx_length);
+    }
+
+    bool is_sent = UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_span_tx_buffer, .size = tx_length}, SPAN_SEND_TIMEOUT);
+
+    atomic_store_explicit(&g_span_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_span_is_recording, true, memory_order_release);
+
+    return is_sent;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SOURCE_API_SPAN_API_H_
+#define SOURCE_API_SPAN_API_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "framework_config.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**
+ * Timeline instrumentation, compiles out without ENABLE_SPAN_TRACE. Names must be string literals,
+ * Tools/span_to_chrome.py resolves them from the ELF. SPAN_SCOPE closes the span on every return path
+ * of the enclosing block, the ASYNC pair may begin and end in different threads or in an ISR.
+ */
+#ifdef ENABLE_SPAN_TRACE
+#define SPAN_BEGIN(name) Span_API_Record(eSpanEvent_Begin, name, 0)
+#define SPAN_END(name) Span_API_Record(eSpanEvent_End, name, 0)
+#define SPAN_SCOPE(name) const char *span_scope __attribute__((cleanup(Span_API_EndScope))) = Span_API_BeginScope(name)
+#define SPAN_COUNTER(name, value) Span_API_Record(eSpanEvent_Counter, name, (uint32_t) (value))
+#define SPAN_ASYNC_BEGIN(name, id) Span_API_Record(eSpanEvent_AsyncBegin, name, (uint32_t) (id))
+#define SPAN_ASYNC_END(name, id) Span_API_Record(eSpanEvent_AsyncEnd, name, (uint32_t) (id))
+#else
+#define SPAN_BEGIN(name) ((void) 0)
+#define SPAN_END(name) ((void) 0)
+#define SPAN_SCOPE(name) ((void) 0)
+#define SPAN_COUNTER(name, value) ((void) 0)
+#define SPAN_ASYNC_BEGIN(name, id) ((void) 0)
+#define SPAN_ASYNC_END(name, id) ((void) 0)
+#endif
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef enum eSpanEvent {
+    eSpanEvent_First = 0,
+    eSpanEvent_Begin = eSpanEvent_First,
+    eSpanEvent_End,
+    eSpanEvent_Counter,
+    eSpanEvent_AsyncBegin,
+    eSpanEvent_AsyncEnd,
+    eSpanEvent_Last
+} eSpanEvent_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool Span_API_Init (void);
+void Span_API_Record (const eSpanEvent_t event, const char *name, const uint32_t value);
+const char *Span_API_BeginScope (const char *name);
+void Span_API_EndScope (const char **name);
+bool Span_API_Dump (void);
+
+#endif /* SOURCE_API_SPAN_API_H_ */
@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "stack_api.h"
+
+#ifdef ENABLE_STACK_MONITOR
+
+#include <stdatomic.h>
+#include "rtos_static.h"
+#include "debug_api.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define STACK_MONITOR_THREAD_STACK_SIZE (128 * 4)
+#define STACK_SIZE_GRANULARITY 8U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sStackThread {
+    atomic_uintptr_t thread;
+    size_t stack_size;
+    size_t free_min;
+    bool is_warned;
+} sStackThread_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+CREATE_FRAMEWORK_MODULE_NAME (STACK_API)
+
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_stack_monitor_thread_cb;
+static uint64_t g_stack_monitor_thread_stack[RTOS_STACK_LENGTH(STACK_MONITOR_THREAD_STACK_SIZE)];
+#endif
+
+const static osThreadAttr_t g_stack_monitor_thread_attributes = {
+    .name = "Stack_API_Thread",
+    .cb_mem = RTOS_STATIC_MEM(g_stack_monitor_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_stack_monitor_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_stack_monitor_thread_stack),
+    .stack_size = STACK_MONITOR_THREAD_STACK_SIZE,
+    .priority = (osPriority_t) osPriorityLow
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static sStackThread_t g_stack_threads[STACK_MONITOR_MAX_THREADS];
+static atomic_size_t g_stack_thread_count = 0;
+
+static osThreadId_t g_stack_monitor_thread_id = NULL;
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Stack_API_Thread (void *arg);
+static void Stack_API_Sample (void);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Stack_API_Thread (void *arg) {
+    while (true) {
+        Stack_API_Sample();
+
+        osDelay(STACK_MONITOR_PERIOD_MS);
+    }
+
+    osThreadYield();
+}
+
+/* Only the monitor thread writes free_min, readers may see a value one period old */
+static void Stack_API_Sample (void) {
+    size_t count = atomic_load_explicit(&g_stack_thread_count, memory_order_acquire);
+
+    if (count > STACK_MONITOR_MAX_THREADS) {
+        count = STACK_MONITOR_MAX_THREADS;
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        osThreadId_t thread = (osThreadId_t) atomic_load_explicit(&g_stack_threads[index].thread, memory_order_acquire);
+
+        if (thread == NULL) {
+            continue;
+        }
+
+        size_t free_bytes = osThreadGetStackSpace(thread);
+
+        if (free_bytes < g_stack_threads[index].free_min) {
+            g_stack_threads[index].free_min = free_bytes;
+        }
+
+        if (g_stack_threads[index].is_warned) {
+            continue;
+        }
+
+        if ((g_stack_threads[index].free_min * 100U) < (g_stack_threads[index].stack_size * STACK_MONITOR_WARNING_PERCENT)) {
+            TRACE_WRN("%s: %u of %u B stack left\n", osThreadGetName(thread), (unsigned int) g_stack_threads[index].free_min, (unsigned int) g_stack_threads[index].stack_size);
+
+            g_stack_threads[index].is_warned = true;
+        }
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+bool Stack_API_Init (void) {
+    if (g_stack_monitor_thread_id != NULL) {
+        return true;
+    }
+
+    g_stack_monitor_thread_id = osThreadNew(Stack_API_Thread, NULL, &g_stack_monitor_thread_attributes);
+
+    if (g_stack_monitor_thread_id == NULL) {
+        return false;
+    }
+
+    return Stack_API_Register(g_stack_monitor_thread_id, STACK_MONITOR_THREAD_STACK_SIZE);
+}
+
+/* Can be called before Stack_API_Init, sampling starts once the monitor thread runs */
+bool Stack_API_Register (const osThreadId_t thread, const size_t stack_size) {
+    if ((thread == NULL) || (stack_size == 0)) {
+        return false;
+    }
+
+    size_t index = atomic_fetch_add_explicit(&g_stack_thread_count, 1, memory_order_relaxed);
+
+    if (index >= STACK_MONITOR_MAX_THREADS) {
+        atomic_fetch_sub_explicit(&g_stack_thread_count, 1, memory_order_relaxed);
+
+        return false;
+    }
+
+    g_stack_threads[index].stack_size = stack_size;
+    g_stack_threads[index].free_min = stack_size;
+    g_stack_threads[index].is_warned = false;
+
+    atomic_store_explicit(&g_stack_threads[index].thread, (uintptr_t) thread, memory_order_release);
+
+    return true;
+}
+
+size_t Stack_API_GetCount (void) {
+    size_t count = atomic_load_explicit(&g_stack_thread_count, memory_order_acquire);
+
+    if (count > STACK_MONITOR_MAX_THREADS) {
+        return STACK_MONITOR_MAX_THREADS;
+    }
+
+    return count;
+}
+
+bool Stack_API_GetStats (const size_t index, sStackStats_t *stats) {
+    if ((index >= Stack_API_GetCount()) || (stats == NULL)) {
+        return false;
+    }
+
+    osThreadId_t thread = (osThreadId_t) atomic_load_explicit(&g_stack_threads[index].thread, memory_order_acquire);
+
+    if (thread == NULL) {
+        return false;
+    }
+
+    stats->name = osThreadGetName(thread);
+    stats->stack_size = g_stack_threads[index].stack_size;
+    stats->free_min = g_stack_threads[index].free_min;
+    stats->peak_used = stats->stack_size - stats->free_min;
+
+    size_t suggested_size = (stats->peak_used * (100U + STACK_MONITOR_MARGIN_PERCENT)) / 100U;
+
+    stats->suggested_size = ((suggested_size + (STACK_SIZE_GRANULARITY - 1U)) / STACK_SIZE_GRANULARITY) * STACK_SIZE_GRANULARITY;
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef SOURCE_API_STACK_API_H_
+#define SOURCE_API_STACK_API_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "cmsis_os2.h"
+#include "framework_config.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/// Hand a framework thread to the stack monitor, compiles out without ENABLE_STACK_MONITOR
+#ifdef ENABLE_STACK_MONITOR
+#define Stack_API_Track(thread, stack_size) Stack_API_Register(thread, stack_size)
+#else
+#define Stack_API_Track(thread, stack_size) ((void) 0)
+#endif
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sStackStats {
+    const char *name;
+    size_t stack_size;
+    size_t free_min;
+    size_t peak_used;
+    size_t suggested_size;
+} sStackStats_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool Stack_API_Init (void);
+bool Stack_API_Register (const osThreadId_t thread, const size_t stack_size);
+size_t Stack_API_GetCount (void);
+bool Stack_API_GetStats (const size_t index, sStackStats_t *stats);
+
+#endif /* SOURCE_API_STACK_API_H_ */
@@ -6,9 +6,13 @@
 
 #ifdef USE_UART
 
+#include <stdatomic.h>
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "uart_driver.h"
-#include "heap_api.h"
+#include "cobs.h"
+#include "bitmap_pool.h"
+#include "stack_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -18,6 +22,24 @@
 #define MESSAGE_QUEUE_CAPACITY 10
 #define MESSAGE_QUEUE_PUT_TIMEOUT 0U
 
+#define TX_COMPLETE_FLAG 0x01U
+#define TX_SPACE_FLAG 0x02U
+
+#define UART_API_RX_FLAG(uart) (1UL << (uart))
+#define UART_API_ALL_RX_FLAGS (((1UL << eUart_Last) - 1U) & ~1UL)
+_Static_assert(eUart_Last <= 31, "Every UART needs its own thread flag");
+/* Used while a message can not be allocated or queued */
+#define FSM_RETRY_PERIOD 10U
+
+#define LENGTH_PREFIX_SIZE 2U
+
+#define MESSAGE_POOL_MAX_SIZE BITMAP_POOL_MAX_SLOTS
+#define FSM_THREAD_STACK_SIZE (256 * 8)
+
+#if defined(USE_UART_FLOW_CONTROL) && defined(USE_UART_RX_DMA)
+#define RTS_POLL
+#endif
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -32,48 +54,178 @@ typedef enum eState {
 
 typedef struct sUartConst {
     eUartDriver_t uart_driver;
+    eUartFraming_t framing;
     size_t buffer_capacity;
+    char *message_pool;
+    size_t message_pool_size;
     osMutexAttr_t mutex_send_attributes;
     osMessageQueueAttr_t message_queue_attributes;
+    osEventFlagsAttr_t tx_flag_attributes;
 } sUartConst_t;
 
 typedef struct sUartDynamic {
     eState_t current_state;
     bool is_initialized;
+    eUartFraming_t framing;
+    atomic_uint_least8_t requested_framing;
     osMutexId_t mutex_send;
+    osEventFlagsId_t tx_flag;
+    /* A Send timed out part way, the receiver holds the start of a frame that has no end */
+    bool is_tx_frame_broken;
     osMessageQueueId_t message_queue;
     sMessage_t message;
-    char *delimiter;
+    char delimiter[UART_API_DELIMITER_MAX_LENGTH + 1];
     size_t delimiter_length;
+    /* KMP state: longest proper prefix of the delimiter that is also a suffix, per prefix length */
+    uint8_t delimiter_prefix[UART_API_DELIMITER_MAX_LENGTH];
+    size_t delimiter_matched;
+    size_t frame_length;
+    size_t header_received;
+    size_t discard_remaining;
+    bool is_oversized;
+    uint32_t oversized_messages;
+    sCobsDecoder_t cobs_decoder;
+    sBitmapPool_t message_pool_slots;
+    atomic_size_t message_pool_in_use;
+    size_t message_pool_high_water_mark;
 } sUartDynamic_t;
 
+#ifdef USE_UART_DEBUG
+_Static_assert(UART_DEBUG_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_DEBUG_MESSAGE_POOL_SIZE is too large");
+static char g_debug_message_pool[UART_DEBUG_MESSAGE_POOL_SIZE][UART_DEBUG_BUFFER_CAPACITY];
+#endif
+
+#ifdef USE_UART_UROS_TX
+_Static_assert(UART_UROS_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_UROS_MESSAGE_POOL_SIZE is too large");
+static char g_uros_message_pool[UART_UROS_MESSAGE_POOL_SIZE][UART_UROS_BUFFER_CAPACITY];
+#endif
+
+#ifdef USE_UART_USART3
+_Static_assert(UART_USART3_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_USART3_MESSAGE_POOL_SIZE is too large");
+static char g_usart3_message_pool[UART_USART3_MESSAGE_POOL_SIZE][UART_USART3_BUFFER_CAPACITY];
+#endif
+
+#ifdef USE_UART_UART4
+_Static_assert(UART_UART4_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_UART4_MESSAGE_POOL_SIZE is too large");
+static char g_uart4_message_pool[UART_UART4_MESSAGE_POOL_SIZE][UART_UART4_BUFFER_CAPACITY];
+#endif
+
+#ifdef USE_UART_UART5
+_Static_assert(UART_UART5_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_UART5_MESSAGE_POOL_SIZE is too large");
+static char g_uart5_message_pool[UART_UART5_MESSAGE_POOL_SIZE][UART_UART5_BUFFER_CAPACITY];
+#endif
+
+#ifdef USE_UART_USART6
+_Static_assert(UART_USART6_MESSAGE_POOL_SIZE <= MESSAGE_POOL_MAX_SIZE, "UART_USART6_MESSAGE_POOL_SIZE is too large");
+static char g_usart6_message_pool[UART_USART6_MESSAGE_POOL_SIZE][UART_USART6_BUFFER_CAPACITY];
+#endif
+
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_fsm_thread_cb;
+static uint64_t g_fsm_thread_stack[RTOS_STACK_LENGTH(FSM_THREAD_STACK_SIZE)];
+static StaticSemaphore_t g_uart_mutex_send_cb[eUart_Last];
+static StaticEventGroup_t g_uart_tx_flag_cb[eUart_Last];
+static StaticQueue_t g_uart_message_queue_cb[eUart_Last];
+static uint8_t g_uart_message_queue_storage[eUart_Last][MESSAGE_QUEUE_CAPACITY * sizeof(sMessage_t)];
+#ifdef RTS_POLL
+static StaticTimer_t g_rts_poll_timer_cb;
+#endif
+#endif
+
 const static osThreadAttr_t g_fsm_thread_attributes = {
     .name = "UART_API_Thread",
-    .stack_size = 256 * 8,
+    .cb_mem = RTOS_STATIC_MEM(g_fsm_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_fsm_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_fsm_thread_stack),
+    .stack_size = FSM_THREAD_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
+#ifdef RTS_POLL
+const static osTimerAttr_t g_rts_poll_timer_attributes = {.name = "UART_API_RtsPollTimer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_rts_poll_timer_cb), .cb_size = RTOS_STATIC_SIZE(g_rts_poll_timer_cb)};
+#endif
+
 /* clang-format off */
 const static sUartConst_t g_static_uart_lut[eUart_Last] = {
     #ifdef USE_UART_DEBUG
     [eUart_Debug] = {
         .uart_driver = eUartDriver_Debug,
+        .framing = UART_DEBUG_FRAMING,
         .buffer_capacity = UART_DEBUG_BUFFER_CAPACITY,
-        .mutex_send_attributes = {.name = "Debug_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .message_queue_attributes = {.name = "Debug_MessageQueue", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0, .mq_mem = NULL, .mq_size = 0}
+        .message_pool = &g_debug_message_pool[0][0],
+        .message_pool_size = UART_DEBUG_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "Debug_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_Debug]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_Debug])},
+        .message_queue_attributes = {.name = "Debug_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_Debug]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_Debug]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_Debug]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_Debug])},
+        .tx_flag_attributes = {.name = "Debug_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_Debug]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_Debug])}
     },
     #endif
 
     #ifdef USE_UART_UROS_TX
     [eUart_uRos] = {
         .uart_driver = eUartDriver_uRos,
+        .framing = UART_UROS_FRAMING,
         .buffer_capacity = UART_UROS_BUFFER_CAPACITY,
-        .mutex_send_attributes = {.name = "uRos_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .message_queue_attributes = {.name = "uRos_MessageQueue", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0, .mq_mem = NULL, .mq_size = 0}
+        .message_pool = &g_uros_message_pool[0][0],
+        .message_pool_size = UART_UROS_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "uRos_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_uRos]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_uRos])},
+        .message_queue_attributes = {.name = "uRos_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_uRos]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_uRos]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_uRos]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_uRos])},
+        .tx_flag_attributes = {.name = "uRos_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_uRos]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_uRos])}
+    },
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUart_Usart3] = {
+        .uart_driver = eUartDriver_Usart3,
+        .framing = UART_USART3_FRAMING,
+        .buffer_capacity = UART_USART3_BUFFER_CAPACITY,
+        .message_pool = &g_usart3_message_pool[0][0],
+        .message_pool_size = UART_USART3_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "Usart3_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_Usart3]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_Usart3])},
+        .message_queue_attributes = {.name = "Usart3_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_Usart3]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_Usart3]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_Usart3]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_Usart3])},
+        .tx_flag_attributes = {.name = "Usart3_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_Usart3]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_Usart3])}
+    },
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUart_Uart4] = {
+        .uart_driver = eUartDriver_Uart4,
+        .framing = UART_UART4_FRAMING,
+        .buffer_capacity = UART_UART4_BUFFER_CAPACITY,
+        .message_pool = &g_uart4_message_pool[0][0],
+        .message_pool_size = UART_UART4_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "Uart4_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_Uart4]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_Uart4])},
+        .message_queue_attributes = {.name = "Uart4_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_Uart4]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_Uart4]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_Uart4]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_Uart4])},
+        .tx_flag_attributes = {.name = "Uart4_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_Uart4]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_Uart4])}
+    },
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUart_Uart5] = {
+        .uart_driver = eUartDriver_Uart5,
+        .framing = UART_UART5_FRAMING,
+        .buffer_capacity = UART_UART5_BUFFER_CAPACITY,
+        .message_pool = &g_uart5_message_pool[0][0],
+        .message_pool_size = UART_UART5_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "Uart5_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_Uart5]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_Uart5])},
+        .message_queue_attributes = {.name = "Uart5_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_Uart5]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_Uart5]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_Uart5]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_Uart5])},
+        .tx_flag_attributes = {.name = "Uart5_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_Uart5]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_Uart5])}
+    },
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUart_Usart6] = {
+        .uart_driver = eUartDriver_Usart6,
+        .framing = UART_USART6_FRAMING,
+        .buffer_capacity = UART_USART6_BUFFER_CAPACITY,
+        .message_pool = &g_usart6_message_pool[0][0],
+        .message_pool_size = UART_USART6_MESSAGE_POOL_SIZE,
+        .mutex_send_attributes = {.name = "Usart6_SendMutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_uart_mutex_send_cb[eUart_Usart6]), .cb_size = RTOS_STATIC_SIZE(g_uart_mutex_send_cb[eUart_Usart6])},
+        .message_queue_attributes = {.name = "Usart6_MessageQueue", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_message_queue_cb[eUart_Usart6]), .cb_size = RTOS_STATIC_SIZE(g_uart_message_queue_cb[eUart_Usart6]), .mq_mem = RTOS_STATIC_MEM(g_uart_message_queue_storage[eUart_Usart6]), .mq_size = RTOS_STATIC_SIZE(g_uart_message_queue_storage[eUart_Usart6])},
+        .tx_flag_attributes = {.name = "Usart6_TxEventFlags", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_uart_tx_flag_cb[eUart_Usart6]), .cb_size = RTOS_STATIC_SIZE(g_uart_tx_flag_cb[eUart_Usart6])}
     },
     #endif
 };
@@ -84,6 +236,10 @@ const static sUartConst_t g_static_uart_lut[eUart_Last] = {
  *********************************************************************************************************************/
 
 static osThreadId_t g_fsm_thread_id = NULL;
+#ifdef RTS_POLL
+static osTimerId_t g_rts_poll_timer = NULL;
+#endif
+static sUartFsmStats_t g_fsm_stats = {0};
 
 /* clang-format off */
 static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {
@@ -92,10 +248,23 @@ static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {
         .current_state = eState_Setup,
         .is_initialized = false,
         .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
         .message_queue = NULL,
         .message = {.data = NULL, .size = 0},
-        .delimiter = NULL,
-        .delimiter_length = 0
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
     },
     #endif
 
@@ -104,11 +273,124 @@ static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {
         .current_state = eState_Setup,
         .is_initialized = false,
         .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
         .message_queue = NULL,
         .message = {.data = NULL, .size = 0},
-        .delimiter = NULL,
-        .delimiter_length = 0
-    }
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
+    },
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUart_Usart3] = {
+        .current_state = eState_Setup,
+        .is_initialized = false,
+        .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
+        .message_queue = NULL,
+        .message = {.data = NULL, .size = 0},
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
+    },
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUart_Uart4] = {
+        .current_state = eState_Setup,
+        .is_initialized = false,
+        .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
+        .message_queue = NULL,
+        .message = {.data = NULL, .size = 0},
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
+    },
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUart_Uart5] = {
+        .current_state = eState_Setup,
+        .is_initialized = false,
+        .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
+        .message_queue = NULL,
+        .message = {.data = NULL, .size = 0},
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
+    },
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUart_Usart6] = {
+        .current_state = eState_Setup,
+        .is_initialized = false,
+        .mutex_send = NULL,
+        .tx_flag = NULL,
+        .is_tx_frame_broken = false,
+        .message_queue = NULL,
+        .message = {.data = NULL, .size = 0},
+        .delimiter = {0},
+        .delimiter_length = 0,
+        .delimiter_prefix = {0},
+        .delimiter_matched = 0,
+        .frame_length = 0,
+        .header_received = 0,
+        .discard_remaining = 0,
+        .is_oversized = false,
+        .oversized_messages = 0,
+        .cobs_decoder = {0},
+        .message_pool_slots = {0},
+        .message_pool_in_use = 0,
+        .message_pool_high_water_mark = 0
+    },
     #endif
 };
 /* clang-format on */
@@ -122,93 +404,401 @@ static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {
  *********************************************************************************************************************/
 
 static void UART_API_FsmThread (void *arg);
-static bool UART_API_IsDelimiterReceived (const eUart_t uart);
-static void UART_API_BufferIncrement (const eUart_t uart);
+static bool UART_API_RunFsm (const eUart_t uart);
+static bool UART_API_CollectByte (const eUart_t uart, const uint8_t byte);
+static bool UART_API_CollectDelimited (const eUart_t uart, const uint8_t byte);
+static bool UART_API_CollectLengthPrefixed (const eUart_t uart, const uint8_t byte);
+static bool UART_API_CollectCobs (const eUart_t uart, const uint8_t byte);
+static void UART_API_ResetCollector (const eUart_t uart);
+static void UART_API_StoreByte (const eUart_t uart, const uint8_t byte);
+static void UART_API_BuildDelimiterPrefix (const eUart_t uart);
+static char *UART_API_PoolLoan (const eUart_t uart);
+static bool UART_API_PoolReturn (const eUart_t uart, char *data);
+static void UART_API_DriverCallback (void *context, const eUartDriver_Flags_t flag);
+static uint32_t UART_API_TimeLeft (const uint32_t start, const uint32_t timeout);
+static bool UART_API_WriteTx (const eUart_t uart, const uint8_t *data, const size_t size, const uint32_t start, const uint32_t timeout);
+#ifdef RTS_POLL
+static void UART_API_RtsPollTimerCallback (void *arg);
+#endif
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
 static void UART_API_FsmThread (void *arg) {
+    /* Data may have arrived before the thread was started, run every UART once */
+    uint32_t pending = UART_API_ALL_RX_FLAGS;
+
     while (1) {
-        for (eUart_t uart = (eUart_First + 1); uart < eUart_Last; uart++) {
-            if (!g_dynamic_uart_lut[uart].is_initialized) {
-                continue;
-            }
+        uint32_t retry = 0;
+        uint32_t busy_start = osKernelGetSysTimerCount();
 
-            switch (g_dynamic_uart_lut[uart].current_state) {
-                case eState_Setup: {
-                    g_dynamic_uart_lut[uart].message.data = Heap_API_Calloc(g_static_uart_lut[uart].buffer_capacity, sizeof(char));
-                    
-                    if (g_dynamic_uart_lut[uart].message.data == NULL) {
-                            continue;
-                    }
-                    
-                    g_dynamic_uart_lut[uart].message.size = 0;
-                    g_dynamic_uart_lut[uart].current_state = eState_Collect;
+        /* Only signalled UARTs are visited, each pass serves every pending UART once so a busy link can not starve the others */
+        while (pending != 0) {
+            uint32_t batch = pending;
+
+            pending = 0;
+
+            while (batch != 0) {
+                eUart_t uart = (eUart_t) __builtin_ctz(batch);
+
+                batch &= (batch - 1);
+
+                if (!g_dynamic_uart_lut[uart].is_initialized) {
+                    continue;
                 }
-                case eState_Collect: {
-                    uint8_t received_byte = 0;
 
-                    while (UART_Driver_ReceiveByte(g_static_uart_lut[uart].uart_driver, &received_byte)) {
-                        g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = received_byte;
+                if (UART_API_RunFsm(uart)) {
+                    pending |= UART_API_RX_FLAG(uart);
+                } else if (g_dynamic_uart_lut[uart].current_state != eState_Collect) {
+                    retry |= UART_API_RX_FLAG(uart);
+                }
+            }
+        }
 
-                        UART_API_BufferIncrement(uart);
+        g_fsm_stats.busy_time_us += ((uint64_t) (osKernelGetSysTimerCount() - busy_start) * 1000000U) / osKernelGetSysTimerFreq();
 
-                        if (!UART_API_IsDelimiterReceived(uart)) {
-                            continue;
-                        }
+        uint32_t sleep_start = osKernelGetTickCount();
+        uint32_t flags = osThreadFlagsWait(UART_API_ALL_RX_FLAGS, osFlagsWaitAny, (retry != 0) ? FSM_RETRY_PERIOD : osWaitForever);
 
-                        g_dynamic_uart_lut[uart].message.size -= g_dynamic_uart_lut[uart].delimiter_length;
-                        g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = '\0';
+        g_fsm_stats.sleep_time_ms += ((uint64_t) (osKernelGetTickCount() - sleep_start) * 1000U) / osKernelGetTickFreq();
+        g_fsm_stats.wakeups++;
 
-                        g_dynamic_uart_lut[uart].current_state = eState_Flush;
+        if ((flags & osFlagsError) != 0) {
+            flags = 0;
+        }
 
-                        break;
-                    }
+        pending = flags | retry;
+    }
+}
+
+/* Returns true when a message was completed and more data may be waiting */
+static bool UART_API_RunFsm (const eUart_t uart) {
+    switch (g_dynamic_uart_lut[uart].current_state) {
+        case eState_Setup: {
+            g_dynamic_uart_lut[uart].message.data = UART_API_PoolLoan(uart);
+            
+            if (g_dynamic_uart_lut[uart].message.data == NULL) {
+                return false;
+            }
+            
+            g_dynamic_uart_lut[uart].message.size = 0;
+            g_dynamic_uart_lut[uart].current_state = eState_Collect;
+        }
+        case eState_Collect: {
+            uint8_t received_byte = 0;
 
-                    if (g_dynamic_uart_lut[uart].current_state != eState_Flush) {
-                        continue;
-                    }
+            while (UART_Driver_ReceiveByte(g_static_uart_lut[uart].uart_driver, &received_byte)) {
+                if (!UART_API_CollectByte(uart, received_byte)) {
+                    continue;
                 }
-                case eState_Flush: {
-                    if (osMessageQueuePut(g_dynamic_uart_lut[uart].message_queue, &g_dynamic_uart_lut[uart].message, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_PUT_TIMEOUT) != osOK) {
-                        continue;
-                    }
-
-                    g_dynamic_uart_lut[uart].current_state = eState_Setup;
-                } break;
-                default: {  
-                } break;
+
+                if (g_dynamic_uart_lut[uart].is_oversized) {
+                    g_dynamic_uart_lut[uart].is_oversized = false;
+                    g_dynamic_uart_lut[uart].oversized_messages++;
+                    g_dynamic_uart_lut[uart].message.size = 0;
+
+                    continue;
+                }
+
+                g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = '\0';
+
+                g_dynamic_uart_lut[uart].current_state = eState_Flush;
+
+                break;
             }
+
+            if (g_dynamic_uart_lut[uart].current_state != eState_Flush) {
+                return false;
+            }
+        }
+        case eState_Flush: {
+            if (osMessageQueuePut(g_dynamic_uart_lut[uart].message_queue, &g_dynamic_uart_lut[uart].message, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_PUT_TIMEOUT) != osOK) {
+                return false;
+            }
+
+            g_dynamic_uart_lut[uart].current_state = eState_Setup;
+        } break;
+        default: {  
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Returns true when the byte completes a frame */
+static bool UART_API_CollectByte (const eUart_t uart, const uint8_t byte) {
+    eUartFraming_t requested_framing = (eUartFraming_t) atomic_load_explicit(&g_dynamic_uart_lut[uart].requested_framing, memory_order_acquire);
+
+    if (requested_framing != g_dynamic_uart_lut[uart].framing) {
+        UART_API_ResetCollector(uart);
+
+        g_dynamic_uart_lut[uart].framing = requested_framing;
+    }
+
+    switch (g_dynamic_uart_lut[uart].framing) {
+        case eUartFraming_Delimiter: {
+            return UART_API_CollectDelimited(uart, byte);
+        }
+        case eUartFraming_LengthPrefix: {
+            return UART_API_CollectLengthPrefixed(uart, byte);
+        }
+        case eUartFraming_Cobs: {
+            return UART_API_CollectCobs(uart, byte);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+static bool UART_API_CollectDelimited (const eUart_t uart, const uint8_t byte) {
+    UART_API_StoreByte(uart, byte);
+
+    while ((g_dynamic_uart_lut[uart].delimiter_matched > 0) && (byte != (uint8_t) g_dynamic_uart_lut[uart].delimiter[g_dynamic_uart_lut[uart].delimiter_matched])) {
+        g_dynamic_uart_lut[uart].delimiter_matched = g_dynamic_uart_lut[uart].delimiter_prefix[g_dynamic_uart_lut[uart].delimiter_matched - 1];
+    }
+
+    if (byte == (uint8_t) g_dynamic_uart_lut[uart].delimiter[g_dynamic_uart_lut[uart].delimiter_matched]) {
+        g_dynamic_uart_lut[uart].delimiter_matched++;
+    }
+
+    if (g_dynamic_uart_lut[uart].delimiter_matched < g_dynamic_uart_lut[uart].delimiter_length) {
+        return false;
+    }
+
+    g_dynamic_uart_lut[uart].delimiter_matched = 0;
+    g_dynamic_uart_lut[uart].message.size = (g_dynamic_uart_lut[uart].message.size >= g_dynamic_uart_lut[uart].delimiter_length) ? (g_dynamic_uart_lut[uart].message.size - g_dynamic_uart_lut[uart].delimiter_length) : 0;
+
+    return true;
+}
+
+static bool UART_API_CollectLengthPrefixed (const eUart_t uart, const uint8_t byte) {
+    if (g_dynamic_uart_lut[uart].discard_remaining > 0) {
+        g_dynamic_uart_lut[uart].discard_remaining--;
+
+        return false;
+    }
+
+    if (g_dynamic_uart_lut[uart].header_received < LENGTH_PREFIX_SIZE) {
+        g_dynamic_uart_lut[uart].frame_length |= ((size_t) byte << (8 * g_dynamic_uart_lut[uart].header_received));
+        g_dynamic_uart_lut[uart].header_received++;
+
+        if (g_dynamic_uart_lut[uart].header_received < LENGTH_PREFIX_SIZE) {
+            return false;
+        }
+
+        if (g_dynamic_uart_lut[uart].frame_length == 0) {
+            g_dynamic_uart_lut[uart].header_received = 0;
+
+            return true;
+        }
+
+        /* One byte is kept for the terminator */
+        if (g_dynamic_uart_lut[uart].frame_length >= g_static_uart_lut[uart].buffer_capacity) {
+            g_dynamic_uart_lut[uart].oversized_messages++;
+            g_dynamic_uart_lut[uart].discard_remaining = g_dynamic_uart_lut[uart].frame_length;
+            g_dynamic_uart_lut[uart].frame_length = 0;
+            g_dynamic_uart_lut[uart].header_received = 0;
+        }
+
+        return false;
+    }
+
+    UART_API_StoreByte(uart, byte);
+
+    if (g_dynamic_uart_lut[uart].message.size < g_dynamic_uart_lut[uart].frame_length) {
+        return false;
+    }
+
+    g_dynamic_uart_lut[uart].frame_length = 0;
+    g_dynamic_uart_lut[uart].header_received = 0;
+
+    return true;
+}
+
+static bool UART_API_CollectCobs (const eUart_t uart, const uint8_t byte) {
+    uint8_t decoded = 0;
+
+    switch (COBS_Decoder_Push(&g_dynamic_uart_lut[uart].cobs_decoder, byte, &decoded)) {
+        case eCobsDecode_Byte: {
+            UART_API_StoreByte(uart, decoded);
+        } break;
+        case eCobsDecode_FrameEnd: {
+            /* Back to back delimiters are allowed for resynchronisation */
+            return (g_dynamic_uart_lut[uart].message.size > 0);
         }
+        default: {
+        } break;
     }
 
-    osThreadYield();
+    return false;
+}
+
+/* Drops the partly collected message */
+static void UART_API_ResetCollector (const eUart_t uart) {
+    g_dynamic_uart_lut[uart].message.size = 0;
+    g_dynamic_uart_lut[uart].delimiter_matched = 0;
+    g_dynamic_uart_lut[uart].frame_length = 0;
+    g_dynamic_uart_lut[uart].header_received = 0;
+    g_dynamic_uart_lut[uart].discard_remaining = 0;
+    g_dynamic_uart_lut[uart].is_oversized = false;
+
+    COBS_Decoder_Reset(&g_dynamic_uart_lut[uart].cobs_decoder);
+
+    return;
 }
 
-static void UART_API_BufferIncrement (const eUart_t uart) {
+/* One byte is kept for the terminator, a message that does not fit is dropped once its frame ends */
+static void UART_API_StoreByte (const eUart_t uart, const uint8_t byte) {
+    if ((g_dynamic_uart_lut[uart].message.size + 1) >= g_static_uart_lut[uart].buffer_capacity) {
+        g_dynamic_uart_lut[uart].is_oversized = true;
+
+        return;
+    }
+
+    g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = byte;
     g_dynamic_uart_lut[uart].message.size++;
 
-    if (g_dynamic_uart_lut[uart].message.size >= g_static_uart_lut[uart].buffer_capacity) {
-        g_dynamic_uart_lut[uart].message.size = 0;
+    return;
+}
+
+static void UART_API_BuildDelimiterPrefix (const eUart_t uart) {
+    size_t length = 0;
+
+    g_dynamic_uart_lut[uart].delimiter_prefix[0] = 0;
+
+    for (size_t i = 1; i < g_dynamic_uart_lut[uart].delimiter_length; i++) {
+        while ((length > 0) && (g_dynamic_uart_lut[uart].delimiter[i] != g_dynamic_uart_lut[uart].delimiter[length])) {
+            length = g_dynamic_uart_lut[uart].delimiter_prefix[length - 1];
+        }
+
+        if (g_dynamic_uart_lut[uart].delimiter[i] == g_dynamic_uart_lut[uart].delimiter[length]) {
+            length++;
+        }
+
+        g_dynamic_uart_lut[uart].delimiter_prefix[i] = length;
     }
 
+    g_dynamic_uart_lut[uart].delimiter_matched = 0;
+
     return;
 }
 
-static bool UART_API_IsDelimiterReceived (const eUart_t uart) {
-    if (g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size - 1] != g_dynamic_uart_lut[uart].delimiter[g_dynamic_uart_lut[uart].delimiter_length - 1]) {
+/* Lock free, the FSM thread loans and any consumer thread returns */
+static char *UART_API_PoolLoan (const eUart_t uart) {
+    size_t slot = 0;
+
+    if (!Bitmap_Pool_Acquire(&g_dynamic_uart_lut[uart].message_pool_slots, &slot)) {
+        return NULL;
+    }
+
+    size_t in_use = atomic_fetch_add_explicit(&g_dynamic_uart_lut[uart].message_pool_in_use, 1, memory_order_relaxed) + 1;
+
+    if (in_use > g_dynamic_uart_lut[uart].message_pool_high_water_mark) {
+        g_dynamic_uart_lut[uart].message_pool_high_water_mark = in_use;
+    }
+
+    return &g_static_uart_lut[uart].message_pool[slot * g_static_uart_lut[uart].buffer_capacity];
+}
+
+static bool UART_API_PoolReturn (const eUart_t uart, char *data) {
+    if ((data < g_static_uart_lut[uart].message_pool) || (data >= (g_static_uart_lut[uart].message_pool + (g_static_uart_lut[uart].message_pool_size * g_static_uart_lut[uart].buffer_capacity)))) {
+        return false;
+    }
+
+    size_t offset = data - g_static_uart_lut[uart].message_pool;
+
+    if ((offset % g_static_uart_lut[uart].buffer_capacity) != 0) {
         return false;
-    } 
+    }
 
-    if (strstr(g_dynamic_uart_lut[uart].message.data, g_dynamic_uart_lut[uart].delimiter) == NULL) {
+    if (!Bitmap_Pool_Release(&g_dynamic_uart_lut[uart].message_pool_slots, offset / g_static_uart_lut[uart].buffer_capacity)) {
         return false;
     }
 
+    atomic_fetch_sub_explicit(&g_dynamic_uart_lut[uart].message_pool_in_use, 1, memory_order_relaxed);
+
     return true;
 }
 
+static void UART_API_DriverCallback (void *context, const eUartDriver_Flags_t flag) {
+    eUart_t uart = (eUart_t) (uintptr_t) context;
+
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
+        return;
+    }
+
+    switch (flag) {
+        case eUartDriver_Flags_TxComplete: {
+            osEventFlagsSet(g_dynamic_uart_lut[uart].tx_flag, TX_COMPLETE_FLAG);
+        } break;
+        case eUartDriver_Flags_RxData: {
+            if (g_fsm_thread_id != NULL) {
+                osThreadFlagsSet(g_fsm_thread_id, UART_API_RX_FLAG(uart));
+            }
+        } break;
+        case eUartDriver_Flags_TxSpace: {
+            osEventFlagsSet(g_dynamic_uart_lut[uart].tx_flag, TX_SPACE_FLAG);
+        } break;
+        default: {
+        } break;
+    }
+
+    return;
+}
+
+/* What is left of a timeout that started at the start tick, osWaitForever never runs out */
+static uint32_t UART_API_TimeLeft (const uint32_t start, const uint32_t timeout) {
+    if (timeout == osWaitForever) {
+        return osWaitForever;
+    }
+
+    uint32_t elapsed = osKernelGetTickCount() - start;
+
+    if (elapsed >= timeout) {
+        return 0;
+    }
+
+    return timeout - elapsed;
+}
+
+/* Writes all of data or nothing, waits until the TX ring has room for it. size can not exceed the ring capacity */
+static bool UART_API_WriteTx (const eUart_t uart, const uint8_t *data, const size_t size, const uint32_t start, const uint32_t timeout) {
+    osEventFlagsClear(g_dynamic_uart_lut[uart].tx_flag, TX_SPACE_FLAG);
+
+    while (!UART_Driver_RequestTxSpace(g_static_uart_lut[uart].uart_driver, size)) {
+        if ((osEventFlagsWait(g_dynamic_uart_lut[uart].tx_flag, TX_SPACE_FLAG, osFlagsWaitAny, UART_API_TimeLeft(start, timeout)) & osFlagsError) != 0) {
+            return false;
+        }
+    }
+
+    size_t written = 0;
+
+    if (!UART_Driver_Write(g_static_uart_lut[uart].uart_driver, data, size, &written)) {
+        return false;
+    }
+
+    /* Only this thread pushes into the ring, the room found above can not shrink */
+    return written == size;
+}
+
+#ifdef RTS_POLL
+/* The DMA only raises events every half ring, without the poll RTS could be released too late to stop the sender */
+static void UART_API_RtsPollTimerCallback (void *arg) {
+    for (eUart_t uart = (eUart_First + 1); uart < eUart_Last; uart++) {
+        if (!g_dynamic_uart_lut[uart].is_initialized) {
+            continue;
+        }
+
+        UART_Driver_RxPoll(g_static_uart_lut[uart].uart_driver);
+    }
+
+    return;
+}
+#endif
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -222,44 +812,107 @@ bool UART_API_Init (const eUart_t uart, const eUartBaudrate_t baudrate, const ch
         return false;
     }
 
-    if (delimiter == NULL) {
-        return false;
+    if (g_static_uart_lut[uart].framing == eUartFraming_Delimiter) {
+        if (delimiter == NULL) {
+            return false;
+        }
+
+        size_t delimiter_length = strlen(delimiter);
+
+        if ((delimiter_length == 0) || (delimiter_length > UART_API_DELIMITER_MAX_LENGTH)) {
+            return false;
+        }
     }
 
     if (g_dynamic_uart_lut[uart].is_initialized) {
         return false;
     }
     
-    if (!UART_Driver_Init(g_static_uart_lut[uart].uart_driver, baudrate)) {
-        return false;
-    }
-
     g_dynamic_uart_lut[uart].mutex_send = osMutexNew(&g_static_uart_lut[uart].mutex_send_attributes);
     
     if (g_dynamic_uart_lut[uart].mutex_send == NULL) {
         return false;
     }
 
+    g_dynamic_uart_lut[uart].tx_flag = osEventFlagsNew(&g_static_uart_lut[uart].tx_flag_attributes);
+
+    if (g_dynamic_uart_lut[uart].tx_flag == NULL) {
+        return false;
+    }
+
     g_dynamic_uart_lut[uart].message_queue = osMessageQueueNew(MESSAGE_QUEUE_CAPACITY, sizeof(sMessage_t), &g_static_uart_lut[uart].message_queue_attributes);
 
     if (g_dynamic_uart_lut[uart].message_queue == NULL) {
         return false;
     }
 
-    g_dynamic_uart_lut[uart].delimiter_length = strlen(delimiter);
-    g_dynamic_uart_lut[uart].delimiter = Heap_API_Calloc((g_dynamic_uart_lut[uart].delimiter_length + 1), sizeof(char));
+    if (g_static_uart_lut[uart].framing == eUartFraming_Delimiter) {
+        g_dynamic_uart_lut[uart].delimiter_length = strlen(delimiter);
 
-    if (g_dynamic_uart_lut[uart].delimiter == NULL) {
-        return false;
+        memcpy(g_dynamic_uart_lut[uart].delimiter, delimiter, g_dynamic_uart_lut[uart].delimiter_length + 1);
+
+        UART_API_BuildDelimiterPrefix(uart);
     }
 
-    memcpy(g_dynamic_uart_lut[uart].delimiter, delimiter, g_dynamic_uart_lut[uart].delimiter_length + 1);
+    COBS_Decoder_Reset(&g_dynamic_uart_lut[uart].cobs_decoder);
+
+    g_dynamic_uart_lut[uart].framing = g_static_uart_lut[uart].framing;
+    atomic_store(&g_dynamic_uart_lut[uart].requested_framing, (uint_least8_t) g_static_uart_lut[uart].framing);
+
+    if (!Bitmap_Pool_Init(&g_dynamic_uart_lut[uart].message_pool_slots, g_static_uart_lut[uart].message_pool_size)) {
+        return false;
+    }
 
+    /* The driver signals only when its ring turns non-empty, the FSM must not drop that flag as an uninitialized UART */
     g_dynamic_uart_lut[uart].is_initialized = true;
 
+    if (!UART_Driver_Init(g_static_uart_lut[uart].uart_driver, baudrate, UART_API_DriverCallback, (void*) (uintptr_t) uart)) {
+        g_dynamic_uart_lut[uart].is_initialized = false;
+
+        return false;
+    }
+
     if (g_fsm_thread_id == NULL) {
         g_fsm_thread_id = osThreadNew(UART_API_FsmThread, NULL, &g_fsm_thread_attributes);
+
+        Stack_API_Track(g_fsm_thread_id, FSM_THREAD_STACK_SIZE);
+    }
+
+    #ifdef RTS_POLL
+    if (g_rts_poll_timer == NULL) {
+        g_rts_poll_timer = osTimerNew(UART_API_RtsPollTimerCallback, osTimerPeriodic, NULL, &g_rts_poll_timer_attributes);
+
+        if (g_rts_poll_timer == NULL) {
+            return false;
+        }
+
+        osTimerStart(g_rts_poll_timer, UART_RTS_POLL_MS);
     }
+    #endif
+
+    return true;
+}
+
+/* The FSM thread switches on the next received byte and drops the message it was collecting */
+bool UART_API_SetFraming (const eUart_t uart, const eUartFraming_t framing) {
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
+        return false;
+    }
+
+    if ((framing < eUartFraming_First) || (framing >= eUartFraming_Last)) {
+        return false;
+    }
+
+    if (!g_dynamic_uart_lut[uart].is_initialized) {
+        return false;
+    }
+
+    /* The delimiter is only set up when the UART was initialized with delimiter framing */
+    if ((framing == eUartFraming_Delimiter) && (g_dynamic_uart_lut[uart].delimiter_length == 0)) {
+        return false;
+    }
+
+    atomic_store_explicit(&g_dynamic_uart_lut[uart].requested_framing, (uint_least8_t) framing, memory_order_release);
 
     return true;
 }
@@ -273,22 +926,89 @@ bool UART_API_Send (const eUart_t uart, const sMessage_t message, const uint32_t
         return false;
     }
     
+    if ((message.data == NULL) || (message.size == 0)) {
+        return false;
+    }
+
+    uint32_t start = osKernelGetTickCount();
+
     if (osMutexAcquire(g_dynamic_uart_lut[uart].mutex_send, timeout) != osOK) {
         return false;
     }
 
-    if (!UART_Driver_SendBytes(g_static_uart_lut[uart].uart_driver, (uint8_t*) message.data, message.size)) {
+    size_t capacity = 0;
+
+    if (!UART_Driver_GetTxCapacity(g_static_uart_lut[uart].uart_driver, &capacity) || (capacity < 2)) {
         osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
-        
+
+        return false;
+    }
+
+    bool is_sent = true;
+
+    if (g_dynamic_uart_lut[uart].is_tx_frame_broken) {
+        const uint8_t delimiter = COBS_DELIMITER;
+
+        is_sent = UART_API_WriteTx(uart, &delimiter, sizeof(delimiter), start, timeout);
+        g_dynamic_uart_lut[uart].is_tx_frame_broken = !is_sent;
+    }
+
+    size_t sent = 0;
+
+    while (is_sent && (sent < message.size)) {
+        size_t length = message.size - sent;
+
+        if (length > capacity) {
+            length = capacity / 2;
+        }
+
+        is_sent = UART_API_WriteTx(uart, (const uint8_t*) &message.data[sent], length, start, timeout);
+
+        if (is_sent) {
+            sent += length;
+        }
+    }
+
+    if (!is_sent && (sent > 0)) {
+        g_dynamic_uart_lut[uart].is_tx_frame_broken = true;
+    }
+
+    osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+    return is_sent;
+}
+
+bool UART_API_Flush (const eUart_t uart, const uint32_t timeout) {
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
         return false;
     }
 
+    if (!g_dynamic_uart_lut[uart].is_initialized) {
+        return false;
+    }
+
+    uint32_t start = osKernelGetTickCount();
+
+    if (osMutexAcquire(g_dynamic_uart_lut[uart].mutex_send, timeout) != osOK) {
+        return false;
+    }
+
+    osEventFlagsClear(g_dynamic_uart_lut[uart].tx_flag, TX_COMPLETE_FLAG);
+
+    while (!UART_Driver_IsTxIdle(g_static_uart_lut[uart].uart_driver)) {
+        if ((osEventFlagsWait(g_dynamic_uart_lut[uart].tx_flag, TX_COMPLETE_FLAG, osFlagsWaitAny, UART_API_TimeLeft(start, timeout)) & osFlagsError) != 0) {
+            osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+            return false;
+        }
+    }
+
     osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
 
     return true;
 }
 
-bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t timeout) {
+bool UART_API_ReceiveLoan (const eUart_t uart, sMessage_t *message, const uint32_t timeout) {
     if ((uart <= eUart_First) || (uart >= eUart_Last)) {
         return false;
     }
@@ -308,4 +1028,106 @@ bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t t
     return true;
 }
 
+bool UART_API_ReturnLoan (const eUart_t uart, sMessage_t *message) {
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
+        return false;
+    }
+
+    if (!g_dynamic_uart_lut[uart].is_initialized) {
+        return false;
+    }
+
+    if ((message == NULL) || (message->data == NULL)) {
+        return false;
+    }
+
+    if (!UART_API_PoolReturn(uart, message->data)) {
+        return false;
+    }
+
+    message->data = NULL;
+    message->size = 0;
+
+    /* The FSM may be waiting for a free buffer */
+    if ((g_fsm_thread_id != NULL) && (g_dynamic_uart_lut[uart].current_state == eState_Setup)) {
+        osThreadFlagsSet(g_fsm_thread_id, UART_API_RX_FLAG(uart));
+    }
+
+    return true;
+}
+
+bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t timeout) {
+    if ((message == NULL) || (message->data == NULL) || (message->size == 0)) {
+        return false;
+    }
+
+    sMessage_t loan = {.data = NULL, .size = 0};
+
+    if (!UART_API_ReceiveLoan(uart, &loan, timeout)) {
+        return false;
+    }
+
+    size_t length = (loan.size < message->size) ? loan.size : (message->size - 1);
+
+    memcpy(message->data, loan.data, length);
+    message->data[length] = '\0';
+    message->size = length;
+
+    UART_API_ReturnLoan(uart, &loan);
+
+    return true;
+}
+
+bool UART_API_GetPoolStats (const eUart_t uart, sUartPoolStats_t *stats) {
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
+        return false;
+    }
+
+    if (stats == NULL) {
+        return false;
+    }
+
+    stats->size = g_static_uart_lut[uart].message_pool_size;
+    stats->in_use = atomic_load(&g_dynamic_uart_lut[uart].message_pool_in_use);
+    stats->high_water_mark = g_dynamic_uart_lut[uart].message_pool_high_water_mark;
+
+    return true;
+}
+
+bool UART_API_GetStats (const eUart_t uart, sUartStats_t *stats) {
+    if ((uart <= eUart_First) || (uart >= eUart_Last)) {
+        return false;
+    }
+
+    if (stats == NULL) {
+        return false;
+    }
+
+    sUartDriver_Stats_t driver_stats = {0};
+
+    if (!UART_Driver_GetStats(g_static_uart_lut[uart].uart_driver, &driver_stats)) {
+        return false;
+    }
+
+    stats->overrun_errors = driver_stats.overrun_errors;
+    stats->framing_errors = driver_stats.framing_errors;
+    stats->noise_errors = driver_stats.noise_errors;
+    stats->parity_errors = driver_stats.parity_errors;
+    stats->ring_overflows = driver_stats.ring_overflows;
+    stats->dma_errors = driver_stats.dma_errors;
+    stats->oversized_messages = g_dynamic_uart_lut[uart].oversized_messages;
+
+    return true;
+}
+
+bool UART_API_GetFsmStats (sUartFsmStats_t *stats) {
+    if (stats == NULL) {
+        return false;
+    }
+
+    *stats = g_fsm_stats;
+
+    return true;
+}
+
 #endif
@@ -17,6 +17,8 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+#define UART_API_DELIMITER_MAX_LENGTH 8
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
@@ -32,9 +34,61 @@ typedef enum eUart {
     #ifdef USE_UART_UROS_TX
     eUart_uRos,
     #endif
+
+    #ifdef USE_UART_USART3
+    eUart_Usart3,
+    #endif
+
+    #ifdef USE_UART_UART4
+    eUart_Uart4,
+    #endif
+
+    #ifdef USE_UART_UART5
+    eUart_Uart5,
+    #endif
+
+    #ifdef USE_UART_USART6
+    eUart_Usart6,
+    #endif
     
     eUart_Last
 } eUart_t;
+
+/**
+ * eUartFraming_Delimiter:    message ends with the delimiter passed to UART_API_Init, the delimiter is stripped.
+ * eUartFraming_LengthPrefix: 16-bit little-endian payload length followed by the payload.
+ * eUartFraming_Cobs:         COBS encoded payload terminated by 0x00.
+ */
+typedef enum eUartFraming {
+    eUartFraming_First = 0,
+    eUartFraming_Delimiter = eUartFraming_First,
+    eUartFraming_LengthPrefix,
+    eUartFraming_Cobs,
+    eUartFraming_Last
+} eUartFraming_t;
+
+/* Receive losses, see sUartDriver_Stats_t for the driver counters */
+typedef struct sUartStats {
+    uint32_t overrun_errors;
+    uint32_t framing_errors;
+    uint32_t noise_errors;
+    uint32_t parity_errors;
+    uint32_t ring_overflows;
+    uint32_t dma_errors;
+    uint32_t oversized_messages;
+} sUartStats_t;
+
+typedef struct sUartPoolStats {
+    size_t size;
+    size_t in_use;
+    size_t high_water_mark;
+} sUartPoolStats_t;
+
+typedef struct sUartFsmStats {
+    uint32_t wakeups;
+    uint64_t sleep_time_ms;
+    uint64_t busy_time_us;
+} sUartFsmStats_t;
 /* clang-format on */
 
 /**********************************************************************************************************************
@@ -45,8 +99,28 @@ typedef enum eUart {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
+/// delimiter is only used (and required) with eUartFraming_Delimiter
 bool UART_API_Init (const eUart_t uart, const eUartBaudrate_t baudrate, const char *delimiter);
+/// Changes the receive framing at run time, back to eUartFraming_Delimiter only if the UART was initialized with it
+bool UART_API_SetFraming (const eUart_t uart, const eUartFraming_t framing);
+/**
+ * Queues the message for transmission and returns once it is copied, it only blocks while the TX queue is full.
+ * Use UART_API_Flush when the data has to be on the wire. timeout bounds the whole call of both.
+ * A message that fits the TX queue is queued whole or not at all, a longer one is queued in halves of the queue. When
+ * such a message times out part way the next Send starts with a COBS delimiter, the receiver drops the cut frame.
+ */
 bool UART_API_Send (const eUart_t uart, const sMessage_t message, const uint32_t timeout);
+bool UART_API_Flush (const eUart_t uart, const uint32_t timeout);
+/**
+ * Received messages live in a fixed per-UART pool.
+ * UART_API_ReceiveLoan hands out the pool buffer itself, it must be given back with UART_API_ReturnLoan.
+ * UART_API_Receive copies into message->data (capacity message->size), truncating if needed, and returns the buffer at once.
+ */
+bool UART_API_ReceiveLoan (const eUart_t uart, sMessage_t *message, const uint32_t timeout);
+bool UART_API_ReturnLoan (const eUart_t uart, sMessage_t *message);
 bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t  timeout);
+bool UART_API_GetPoolStats (const eUart_t uart, sUartPoolStats_t *stats);
+bool UART_API_GetStats (const eUart_t uart, sUartStats_t *stats);
+bool UART_API_GetFsmStats (sUartFsmStats_t *stats);
 
 #endif /* SOURCE_API_UART_API_H_ */
@@ -10,6 +10,7 @@
 #include "vl53l0x_api.h"
 #include "i2c_api.h"
 #include "debug_api.h"
+#include "span_api.h"
 #include "gpio_driver.h"
 
 /**********************************************************************************************************************
@@ -75,7 +76,7 @@ typedef struct sVl53l0xDynamicDesc {
  *********************************************************************************************************************/
 
 #ifdef DEBUG_VL53L0X_API 
-CREATE_MODULE_NAME (VL53L0XV2_API)
+CREATE_FRAMEWORK_MODULE_NAME (VL53L0XV2_API)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
@@ -518,6 +519,8 @@ bool VL53L0X_API_TurnOn (const eVl53l0x_t vl53l0x) {
 }
 
 bool VL53L0X_API_GetDistance (const eVl53l0x_t vl53l0x, uint16_t *distance, size_t timeout) {
+    SPAN_SCOPE("vl53l0x_get_distance");
+
     if (!VL53L0X_API_IsCorrectDevice(vl53l0x)) {
         return false;
     }
@@ -610,6 +613,8 @@ bool VL53L0X_API_GetDistance (const eVl53l0x_t vl53l0x, uint16_t *distance, size
 
     *distance = ranging_data.RangeMilliMeter;
 
+    SPAN_COUNTER("vl53l0x_distance_mm", ranging_data.RangeMilliMeter);
+
     return true;
 }
 
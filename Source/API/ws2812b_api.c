@@ -7,8 +7,10 @@
 #ifdef USE_WS2812B
 
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "heap_api.h"
 #include "debug_api.h"
+#include "span_api.h"
 #include "ws2812b_driver.h"
 #include "timer_driver.h"
 #include "pwm_driver.h"
@@ -75,20 +77,26 @@ typedef struct sWs2812bDynamicDesc {
  *********************************************************************************************************************/
 
 #ifdef DEBUG_WS2812B_API
-CREATE_MODULE_NAME (WS2812B_API)
+CREATE_FRAMEWORK_MODULE_NAME (WS2812B_API)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTimer_t g_ws2812b_timer_cb[eWs2812b_Last];
+static StaticSemaphore_t g_ws2812b_mutex_cb[eWs2812b_Last];
+static StaticEventGroup_t g_ws2812b_flag_cb[eWs2812b_Last];
+#endif
+
 /* clang-format off */ 
 const static sWs2812bApiDesc_t g_ws2812b_api_static_lut[eWs2812b_Last] = {
     #ifdef USE_WS2812B_1
     [eWs2812b_1] = {
         .device = eWs2812bDriver_1,
         .max_led = WS2812B_1_LED_COUNT,
-        .timer_attributes = {.name = "WS2812B_API_1_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U},
-        .mutex_attributes = {.name = "WS2812B_API_1_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .flag_attributes = {.name = "WS2812B_API_1_EventFlag", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U}
+        .timer_attributes = {.name = "WS2812B_API_1_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_timer_cb[eWs2812b_1]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_timer_cb[eWs2812b_1])},
+        .mutex_attributes = {.name = "WS2812B_API_1_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_mutex_cb[eWs2812b_1]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_mutex_cb[eWs2812b_1])},
+        .flag_attributes = {.name = "WS2812B_API_1_EventFlag", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_flag_cb[eWs2812b_1]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_flag_cb[eWs2812b_1])}
     },
     #endif
 
@@ -96,9 +104,9 @@ const static sWs2812bApiDesc_t g_ws2812b_api_static_lut[eWs2812b_Last] = {
     [eWs2812b_2] = {
         .device = eWs2812bDriver_2,
         .max_led = WS2812B_2_LED_COUNT,
-        .timer_attributes = {.name = "WS2812B_API_2_Timer", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U},
-        .mutex_attributes = {.name = "WS2812B_API_2_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U},
-        .flag_attributes = {.name = "WS2812B_API_2_EventFlag", .attr_bits = 0, .cb_mem = NULL, .cb_size = 0U}
+        .timer_attributes = {.name = "WS2812B_API_2_Timer", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_timer_cb[eWs2812b_2]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_timer_cb[eWs2812b_2])},
+        .mutex_attributes = {.name = "WS2812B_API_2_Mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_mutex_cb[eWs2812b_2]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_mutex_cb[eWs2812b_2])},
+        .flag_attributes = {.name = "WS2812B_API_2_EventFlag", .attr_bits = 0, .cb_mem = RTOS_STATIC_MEM(g_ws2812b_flag_cb[eWs2812b_2]), .cb_size = RTOS_STATIC_SIZE(g_ws2812b_flag_cb[eWs2812b_2])}
     }
     #endif
 };
@@ -159,6 +167,8 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
  *********************************************************************************************************************/
 
 static void WS2812B_API_TimerCallback (void *arg) {
+    SPAN_SCOPE("ws2812b_frame");
+
     if (arg == NULL) {
         return;
     }
@@ -231,7 +241,16 @@ static bool WS2812B_API_Update (const eWs2812b_t device) {
 
     osMutexRelease(g_ws2812b_api_dynamic_lut[device].mutex);
 
-    if (!WS2812B_Driver_Set(g_ws2812b_api_static_lut[device].device, g_ws2812b_api_dynamic_lut[device].led_data, g_ws2812b_api_static_lut[device].max_led)) {
+    SPAN_ASYNC_BEGIN("ws2812b_dma", device);
+    SPAN_BEGIN("ws2812b_driver_set");
+
+    bool is_set = WS2812B_Driver_Set(g_ws2812b_api_static_lut[device].device, g_ws2812b_api_dynamic_lut[device].led_data, g_ws2812b_api_static_lut[device].max_led);
+
+    SPAN_END("ws2812b_driver_set");
+
+    if (!is_set) {
+        SPAN_ASYNC_END("ws2812b_dma", device);
+
         return false;
     }
 
@@ -247,6 +266,14 @@ static void WS2812B_API_DriverCallback (void *context, const eLedTransferState_t
 
     if (transfer_state == eLedTransferState_Complete) { 
         osEventFlagsSet(callback_arg->flag, TRANSFER_SUCCESS_FLAG);
+
+        SPAN_ASYNC_END("ws2812b_dma", callback_arg->device);
+    }
+
+    if (transfer_state == eLedTransferState_TransferError) {
+        TRACE_ISR("DMA transfer error, led state [%u]\n", callback_arg->led_state);
+
+        SPAN_ASYNC_END("ws2812b_dma", callback_arg->device);
     }
 
     return;
@@ -342,7 +369,7 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
         case eLedAnimation_Rainbow: {
             sLedAnimationRainbow_t *data = dynamic_animation_data->data;
 
-            sLedRainbow_t *rainbow_context = Heap_API_Malloc(sizeof(sLedRainbow_t));
+            sLedRainbow_t *rainbow_context = Heap_API_Calloc(1, sizeof(sLedRainbow_t));
             sLedAnimationRainbow_t *rainbow_data = Heap_API_Malloc(sizeof(sLedAnimationRainbow_t));
 
             if ((rainbow_context == NULL) || (rainbow_data == NULL)) {
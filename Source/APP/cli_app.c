@@ -7,14 +7,21 @@
 #ifdef ENABLE_CLI
 
 #include <ctype.h>
+#include <string.h>
 #include "cmsis_os2.h"
+#include "rtos_static.h"
 #include "framework_cli_lut.h"
 #include "cmd_api.h"
 #include "uart_api.h"
 #include "heap_api.h"
+#include "stack_api.h"
+#include "span_api.h"
+#include "cpu_api.h"
 #include "debug_api.h"
 #include "message.h"
 #include "error_messages.h"
+#include "cobs.h"
+#include "bitmap_pool.h"
 
 #ifdef INCLUDE_PROJECT_CLI
 #include "project_cli_lut.h"
@@ -26,6 +33,21 @@
 
 #define DEBUG_CLI_APP
 
+#define CLI_APP_THREAD_STACK_SIZE (256 * 4)
+
+#ifdef INCLUDE_PROJECT_CLI
+#define CLI_APP_COMMAND_COUNT (eCliFrameworkCmd_Last + eCliProjectCmd_Last)
+#else
+#define CLI_APP_COMMAND_COUNT eCliFrameworkCmd_Last
+#endif
+
+#ifdef ENABLE_CLI_RPC
+#define CLI_APP_RPC_RECORD_SIZE CMD_RPC_RESPONSE_MAX_SIZE(RESPONSE_MESSAGE_CAPACITY)
+/* Leading delimiter, so text traces sent in between end up in a frame of their own, and the trailing one */
+#define CLI_APP_RPC_FRAME_SIZE (COBS_ENCODED_MAX_SIZE(CLI_APP_RPC_RECORD_SIZE) + 2U)
+#define CLI_APP_RPC_SEND_TIMEOUT 100U
+#endif
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -35,14 +57,22 @@
  *********************************************************************************************************************/
 
 #ifdef DEBUG_CLI_APP
-CREATE_MODULE_NAME (CLI_APP)
+CREATE_FRAMEWORK_MODULE_NAME (CLI_APP)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
 
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_cli_thread_cb;
+static uint64_t g_cli_thread_stack[RTOS_STACK_LENGTH(CLI_APP_THREAD_STACK_SIZE)];
+#endif
+
 const static osThreadAttr_t g_cli_thread_attributes = {
     .name = "CLI_APP_Thread",
-    .stack_size = 256 * 4,
+    .cb_mem = RTOS_STATIC_MEM(g_cli_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_cli_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_cli_thread_stack),
+    .stack_size = CLI_APP_THREAD_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
@@ -53,10 +83,30 @@ const static osThreadAttr_t g_cli_thread_attributes = {
 static bool g_is_initialized = false;
 
 static osThreadId_t g_cli_thread_id = NULL;
+/* Replies stream through this buffer in RESPONSE_MESSAGE_CAPACITY sized chunks */
 static char g_response_buffer[RESPONSE_MESSAGE_CAPACITY];
 
 static sMessage_t g_command = {.data = NULL, .size = 0};
-static sMessage_t g_response = {.data = g_response_buffer, .size = RESPONSE_MESSAGE_CAPACITY};
+static sCmdWriter_t g_response = {0};
+
+/* Framework and project commands in one table, keyed on the full command token */
+static sCmdDesc_t *g_command_index_slot[CMD_API_INDEX_CAPACITY(CLI_APP_COMMAND_COUNT)];
+static sCmdIndex_t g_command_index = {0};
+
+/* One arena per command in flight, the APP thread releases it once the command is done */
+static uint8_t g_command_arena_storage[CLI_COMMAND_ARENA_COUNT][CLI_COMMAND_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGNMENT)));
+static sArena_t g_command_arena[CLI_COMMAND_ARENA_COUNT];
+static sBitmapPool_t g_command_arena_slots = {0};
+
+#ifdef ENABLE_CLI_RPC
+/* Only touched by the CLI thread, the rpc command runs on it as well */
+static bool g_is_rpc_mode = false;
+/* Same buffer as g_response, every full buffer goes out as a frame with CMD_RPC_FLAG_MORE set */
+static sCmdWriter_t g_rpc_response = {0};
+static uint16_t g_rpc_sequence = 0;
+static uint8_t g_rpc_record[CLI_APP_RPC_RECORD_SIZE];
+static uint8_t g_rpc_frame[CLI_APP_RPC_FRAME_SIZE];
+#endif
 
 /**********************************************************************************************************************
  * Exported variables and references
@@ -67,30 +117,140 @@ static sMessage_t g_response = {.data = g_response_buffer, .size = RESPONSE_MESS
  *********************************************************************************************************************/
 
 static void CLI_APP_Thread (void *arg);
+#ifdef ENABLE_CLI_RPC
+static sCmdDesc_t *CLI_APP_Rpc_GetCommand (const uint16_t command_id);
+static void CLI_APP_Rpc_Handle (const sMessage_t frame);
+static void CLI_APP_Rpc_Respond (const eCmdRpcStatus_t status);
+static bool CLI_APP_Rpc_Sink (const char *data, const size_t size);
+static bool CLI_APP_Rpc_SendFrame (const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length);
+#endif
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+#ifdef ENABLE_CLI_RPC
+/* Framework commands keep their eCliFrameworkCmd value, project commands follow on from eCliFrameworkCmd_Last */
+static sCmdDesc_t *CLI_APP_Rpc_GetCommand (const uint16_t command_id) {
+    if ((command_id > eCliFrameworkCmd_First) && (command_id < eCliFrameworkCmd_Last)) {
+        return &g_framework_cli_lut[command_id];
+    }
+
+    #ifdef INCLUDE_PROJECT_CLI
+    if ((command_id > eCliFrameworkCmd_Last) && (command_id < (eCliFrameworkCmd_Last + eCliProjectCmd_Last))) {
+        return &g_project_cli_lut[command_id - eCliFrameworkCmd_Last];
+    }
+    #endif
+
+    return NULL;
+}
+
+/* Requests are answered in arrival order, the host may have as many in flight as the debug UART message pool holds */
+static void CLI_APP_Rpc_Handle (const sMessage_t frame) {
+    sCmdRpcRequest_t request = {0};
+    eCmdRpcStatus_t status = CMD_API_Rpc_Decode((const uint8_t*) frame.data, frame.size, &request);
+
+    g_rpc_sequence = request.sequence;
+
+    CMD_API_Writer_Reset(&g_rpc_response);
+
+    if (status != eCmdRpcStatus_Ok) {
+        CMD_API_Writer_Printf(&g_rpc_response, "Invalid frame\n");
+
+        CLI_APP_Rpc_Respond(status);
+
+        return;
+    }
+
+    if (request.command_id == CMD_RPC_PING_ID) {
+        CLI_APP_Rpc_Respond(eCmdRpcStatus_Ok);
+
+        return;
+    }
+
+    if (request.command_id == CMD_RPC_EXIT_ID) {
+        CLI_APP_Rpc_Respond(eCmdRpcStatus_Ok);
+
+        /* The response is queued before the host can send text again */
+        if (UART_API_SetFraming(eUart_Debug, UART_DEBUG_FRAMING)) {
+            g_is_rpc_mode = false;
+        }
+
+        return;
+    }
+
+    /* Text handlers expect NUL terminated arguments like text mode messages, the CRC behind the text is checked by now */
+    request.text.data[request.text.size] = '\0';
+
+    status = CMD_API_Rpc_Execute(CLI_APP_Rpc_GetCommand(request.command_id), &request, &g_rpc_response);
+
+    CLI_APP_Rpc_Respond(status);
+
+    return;
+}
+
+/* The last frame of a reply carries the status and the rest of the text */
+static void CLI_APP_Rpc_Respond (const eCmdRpcStatus_t status) {
+    CLI_APP_Rpc_SendFrame(status, false, g_rpc_response.buffer, g_rpc_response.length);
+
+    CMD_API_Writer_Reset(&g_rpc_response);
+
+    return;
+}
+
+static bool CLI_APP_Rpc_Sink (const char *data, const size_t size) {
+    return CLI_APP_Rpc_SendFrame(eCmdRpcStatus_Ok, true, data, size);
+}
+
+static bool CLI_APP_Rpc_SendFrame (const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length) {
+    size_t record_length = CMD_API_Rpc_Encode(g_rpc_sequence, status, has_more, text, text_length, g_rpc_record, sizeof(g_rpc_record));
+
+    if (record_length == 0) {
+        TRACE_ERR("RPC response encode failed\n");
+
+        return false;
+    }
+
+    size_t frame_length = 0;
+
+    g_rpc_frame[frame_length++] = COBS_DELIMITER;
+    frame_length += COBS_Encode(g_rpc_record, record_length, &g_rpc_frame[frame_length], (sizeof(g_rpc_frame) - frame_length - 1U));
+    g_rpc_frame[frame_length++] = COBS_DELIMITER;
+
+    if (!UART_API_Send(eUart_Debug, (sMessage_t) {.data = (char*) g_rpc_frame, .size = frame_length}, CLI_APP_RPC_SEND_TIMEOUT)) {
+        TRACE_ERR("RPC response send failed\n");
+
+        return false;
+    }
+
+    return true;
+}
+#endif
+
 static void CLI_APP_Thread (void *arg) {
     while (true) {
-        if (UART_API_Receive(eUart_Debug, &g_command, osWaitForever)) {
-            if (CMD_API_FindCommand(g_command, &g_response, g_framework_cli_lut, eCliFrameworkCmd_Last)){
-                Heap_API_Free(g_command.data);
-                
-                continue;
-            }
-
-            #ifdef INCLUDE_PROJECT_CLI
-            if (CMD_API_FindCommand(g_command, &g_response, g_project_cli_lut, eCliProjectCmd_Last)){
-                Heap_API_Free(g_command.data);
-                
-                continue;
-            }
-            #endif
-
-            TRACE_ERR(g_response.data);
+        if (!UART_API_ReceiveLoan(eUart_Debug, &g_command, osWaitForever)) {
+            continue;
         }
+
+        #ifdef ENABLE_CLI_RPC
+        if (g_is_rpc_mode) {
+            CLI_APP_Rpc_Handle(g_command);
+
+            UART_API_ReturnLoan(eUart_Debug, &g_command);
+
+            continue;
+        }
+        #endif
+
+        CMD_API_Writer_Reset(&g_response);
+
+        CMD_API_FindCommand(g_command, &g_response, &g_command_index);
+
+        UART_API_ReturnLoan(eUart_Debug, &g_command);
+
+        /* Errors are part of the reply as well */
+        CMD_API_Writer_Flush(&g_response);
     }
 
     osThreadYield();
@@ -122,8 +282,62 @@ bool CLI_APP_Init (const eUartBaudrate_t baudrate) {
         return false;
     }
 
+    #ifdef ENABLE_STACK_MONITOR
+    if (Stack_API_Init() == false) {
+        return false;
+    }
+    #endif
+
+    #ifdef ENABLE_SPAN_TRACE
+    if (Span_API_Init() == false) {
+        return false;
+    }
+    #endif
+
+    #ifdef ENABLE_RUN_TIME_STATS
+    if (CPU_API_Init() == false) {
+        return false;
+    }
+    #endif
+
+    if (!CMD_API_Writer_Init(&g_response, g_response_buffer, RESPONSE_MESSAGE_CAPACITY, Debug_API_Write)) {
+        return false;
+    }
+
+    #ifdef ENABLE_CLI_RPC
+    if (!CMD_API_Writer_Init(&g_rpc_response, g_response_buffer, RESPONSE_MESSAGE_CAPACITY, CLI_APP_Rpc_Sink)) {
+        return false;
+    }
+    #endif
+
+    if (!CMD_API_Index_Init(&g_command_index, g_command_index_slot, CMD_API_INDEX_CAPACITY(CLI_APP_COMMAND_COUNT))) {
+        return false;
+    }
+
+    if (!CMD_API_Index_Add(&g_command_index, g_framework_cli_lut, eCliFrameworkCmd_Last)) {
+        return false;
+    }
+
+    #ifdef INCLUDE_PROJECT_CLI
+    if (!CMD_API_Index_Add(&g_command_index, g_project_cli_lut, eCliProjectCmd_Last)) {
+        return false;
+    }
+    #endif
+
+    for (size_t arena = 0; arena < CLI_COMMAND_ARENA_COUNT; arena++) {
+        if (!Arena_Init(&g_command_arena[arena], g_command_arena_storage[arena], CLI_COMMAND_ARENA_SIZE)) {
+            return false;
+        }
+    }
+
+    if (!Bitmap_Pool_Init(&g_command_arena_slots, CLI_COMMAND_ARENA_COUNT)) {
+        return false;
+    }
+
     if (g_cli_thread_id == NULL) {
         g_cli_thread_id = osThreadNew(CLI_APP_Thread, NULL, &g_cli_thread_attributes);
+
+        Stack_API_Track(g_cli_thread_id, CLI_APP_THREAD_STACK_SIZE);
     }
 
     g_is_initialized = true;
@@ -131,4 +345,81 @@ bool CLI_APP_Init (const eUartBaudrate_t baudrate) {
     return g_is_initialized;
 }
 
+#ifdef ENABLE_CLI_RPC
+/* Called from the rpc command handler, which runs on the CLI thread */
+bool CLI_APP_Rpc_Enter (void) {
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    if (!UART_API_SetFraming(eUart_Debug, eUartFraming_Cobs)) {
+        return false;
+    }
+
+    g_is_rpc_mode = true;
+
+    return true;
+}
+#endif
+
+/* Lock free, the CLI thread acquires and the APP threads release */
+sArena_t *CLI_APP_Arena_Acquire (void) {
+    size_t slot = 0;
+
+    if (!Bitmap_Pool_Acquire(&g_command_arena_slots, &slot)) {
+        return NULL;
+    }
+
+    Arena_Reset(&g_command_arena[slot]);
+
+    return &g_command_arena[slot];
+}
+
+bool CLI_APP_Arena_Release (sArena_t *arena) {
+    if ((arena < &g_command_arena[0]) || (arena >= &g_command_arena[CLI_COMMAND_ARENA_COUNT])) {
+        return false;
+    }
+
+    return Bitmap_Pool_Release(&g_command_arena_slots, (size_t) (arena - &g_command_arena[0]));
+}
+
+/* Copies the payload into a command arena and queues it, the arena goes back to the pool when queuing fails */
+bool CLI_APP_Add_Task (const uint32_t task, const void *payload, const size_t size, bool (*add_task) (const uint32_t task, void *data, sArena_t *arena), sCmdWriter_t *response) {
+    if ((payload == NULL) || (size == 0) || (add_task == NULL) || (response == NULL)) {
+        return false;
+    }
+
+    sArena_t *arena = CLI_APP_Arena_Acquire();
+
+    if (arena == NULL) {
+        CMD_API_Writer_Printf(response, "No free command arena\n");
+
+        return false;
+    }
+
+    void *data = Arena_Allocate(arena, size);
+
+    if (data == NULL) {
+        CMD_API_Writer_Printf(response, "Failed arena allocate\n");
+
+        CLI_APP_Arena_Release(arena);
+
+        return false;
+    }
+
+    memcpy(data, payload, size);
+
+    if (!add_task(task, data, arena)) {
+        CMD_API_Writer_Printf(response, "Failed task add\n");
+
+        CLI_APP_Arena_Release(arena);
+
+        return false;
+    }
+
+    CMD_API_Writer_Printf(response, "Operation successful\n");
+
+    return true;
+}
+
 #endif
@@ -5,7 +5,11 @@
  *********************************************************************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 #include "uart_baudrate.h"
+#include "arena.h"
+#include "cmd_api.h"
 #include "framework_config.h"
 
 /**********************************************************************************************************************
@@ -25,5 +29,14 @@
  *********************************************************************************************************************/
 
 bool CLI_APP_Init (const eUartBaudrate_t baudrate);
+sArena_t *CLI_APP_Arena_Acquire (void);
+bool CLI_APP_Arena_Release (sArena_t *arena);
+/**
+ * Hands a command to an APP thread: copies size bytes of payload into a command arena and calls add_task with it,
+ * add_task queues the task with CLI_APP_Arena_Release as its release. Errors and success go to response.
+ */
+bool CLI_APP_Add_Task (const uint32_t task, const void *payload, const size_t size, bool (*add_task) (const uint32_t task, void *data, sArena_t *arena), sCmdWriter_t *response);
+/// Switches the debug UART to COBS framed binary requests, see CMD_RPC_REQUEST_TAG
+bool CLI_APP_Rpc_Enter (void);
 
 #endif /* SOURCE_APP_CLI_APP_H_ */
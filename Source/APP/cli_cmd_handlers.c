@@ -11,10 +11,14 @@
 #include <string.h>
 #include "led_app.h"
 #include "motor_app.h"
-#include "cmd_api_helper.h"
+#include "cli_app.h"
 #include "heap_api.h"
+#include "stack_api.h"
+#include "span_api.h"
+#include "cpu_api.h"
 #include "led_api.h"
 #include "motor_api.h"
+#include "uart_api.h"
 #include "debug_api.h"
 #include "error_messages.h"
 #include "led_color.h"
@@ -25,8 +29,10 @@
 
 #define DEBUG_CLI_APP
 
-#define CMD_SEPARATOR ","
-#define CMD_SEPARATOR_LENGHT (sizeof(CMD_SEPARATOR) - 1)
+#ifdef ENABLE_HEAP_TRACKING
+#define HEAP_REPORT_CALL_SITES 5
+#define HEAP_REPORT_ALLOCATIONS 10
+#endif
 
 /**********************************************************************************************************************
  * Private typedef
@@ -37,7 +43,7 @@
  *********************************************************************************************************************/
 
 #ifdef DEBUG_CLI_APP
-CREATE_MODULE_NAME (CLI_CMD_HANDLERS)
+CREATE_FRAMEWORK_MODULE_NAME (CLI_CMD_HANDLERS)
 #else
 CREATE_MODULE_NAME_EMPTY
 #endif
@@ -54,546 +60,349 @@ CREATE_MODULE_NAME_EMPTY
  * Prototypes of private functions
  *********************************************************************************************************************/
 
-static bool CLI_APP_Led_Handlers_Common (sMessage_t arguments, sMessage_t *response, const eLedTask_t task);
+#if defined(USE_LED) || defined(USE_PWM_LED)
+static bool CLI_APP_Led_Add_Task (const uint32_t task, void *data, sArena_t *arena);
+#endif
+#ifdef USE_LED
+static bool CLI_APP_Led_Handlers_Common (const sCmdArgs_t *arguments, sCmdWriter_t *response, const eLedTask_t task);
+#endif
+#ifdef USE_MOTORS
+static bool CLI_APP_Motors_Add_Task (const uint32_t task, void *data, sArena_t *arena);
+#endif
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
-static bool CLI_APP_Led_Handlers_Common (sMessage_t arguments, sMessage_t *response, const eLedTask_t task) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-    
-    eLed_t led;
-    size_t led_value = 0;
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
-
-        return false;
-    }
-
-    led = led_value;
-
-    if (!LED_API_IsCorrectLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
-
-        return false;
-    }
-
-    sLedCommandDesc_t formated_task = {.task = task, .data = NULL};
-    sLedCommon_t *task_data = Heap_API_Calloc(1, sizeof(sLedCommon_t));
-
-    if (task_data == NULL) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
-        
-        return false;
-    }
+#if defined(USE_LED) || defined(USE_PWM_LED)
+static bool CLI_APP_Led_Add_Task (const uint32_t task, void *data, sArena_t *arena) {
+    sLedCommandDesc_t formated_task = {.task = (eLedTask_t) task, .data = data, .arena = arena, .release = CLI_APP_Arena_Release};
 
-    task_data->led = led;
-    formated_task.data = task_data;
+    return LED_APP_Add_Task(&formated_task);
+}
+#endif
 
-    if (!LED_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
-        
-        Heap_API_Free(task_data);
+#ifdef USE_LED
+static bool CLI_APP_Led_Handlers_Common (const sCmdArgs_t *arguments, sCmdWriter_t *response, const eLedTask_t task) {
+    sLedCommon_t task_data = {.led = (eLed_t) arguments->value[0].uint_value};
 
-        return false;
-    }
+    return CLI_APP_Add_Task(task, &task_data, sizeof(task_data), CLI_APP_Led_Add_Task, response);
+}
+#endif
 
-    snprintf(response->data, response->size, "Operation successful\n");
+#ifdef USE_MOTORS
+static bool CLI_APP_Motors_Add_Task (const uint32_t task, void *data, sArena_t *arena) {
+    sMotorCommandDesc_t formated_task = {.task = (eMotorTask_t) task, .data = data, .arena = arena, .release = CLI_APP_Arena_Release};
 
-    return true;
+    return Motor_APP_Add_Task(&formated_task);
 }
+#endif
 
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
 #ifdef USE_LED
-bool CLI_APP_Led_Handlers_Set (sMessage_t arguments, sMessage_t *response) {
+bool CLI_APP_Led_Handlers_Set (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
     eLedTask_t task = eLedTask_Set;
 
     return CLI_APP_Led_Handlers_Common(arguments, response, task);
 }
 
-bool CLI_APP_Led_Handlers_Reset (sMessage_t arguments, sMessage_t *response) {
+bool CLI_APP_Led_Handlers_Reset (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
     eLedTask_t task = eLedTask_Reset;
 
     return CLI_APP_Led_Handlers_Common(arguments, response, task);
 }
 
-bool CLI_APP_Led_Handlers_Toggle (sMessage_t arguments, sMessage_t *response) {
+bool CLI_APP_Led_Handlers_Toggle (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
     eLedTask_t task = eLedTask_Toggle;
 
     return CLI_APP_Led_Handlers_Common(arguments, response, task);
 }
 
-bool CLI_APP_Led_Handlers_Blink (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-    
-    eLed_t led;
-    size_t led_value = 0;
-    size_t blink_time = 0;
-    size_t blink_frequency = 0;
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &blink_time, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
+bool CLI_APP_Led_Handlers_Blink (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    eLed_t led = (eLed_t) arguments->value[0].uint_value;
+    uint8_t blink_time = (uint8_t) arguments->value[1].uint_value;
+    uint16_t blink_frequency = (uint16_t) arguments->value[2].uint_value;
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &blink_frequency, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-    
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    sLedBlink_t task_data = {.led = led, .blink_time = blink_time, .blink_frequency = blink_frequency};
 
-        return false;
-    }
+    return CLI_APP_Add_Task(eLedTask_Blink, &task_data, sizeof(task_data), CLI_APP_Led_Add_Task, response);
+}
+#endif
 
-    led = led_value;
+#ifdef USE_PWM_LED
+bool CLI_APP_Pwm_Led_Handlers_Set_Brightness (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    eLedPwm_t led = (eLedPwm_t) arguments->value[0].uint_value;
+    uint8_t duty_cycle = (uint8_t) arguments->value[1].uint_value;
 
-    if (!LED_API_IsCorrectLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+    /* The limit depends on the timer resolution of the led */
+    if (!LED_API_IsCorrectDutyCycle(led, duty_cycle)) {
+        CMD_API_Writer_Printf(response, "%d: Incorrect duty cycle\n", led);
 
         return false;
     }
 
-    if (!LED_API_IsCorrectBlinkTime(blink_time)) {
-        snprintf(response->data, response->size, "%d: Incorrect blink time\n", blink_time);
-
-        return false;
-    }
+    sLedSetBrightness_t task_data = {.led = led, .duty_cycle = duty_cycle};
 
-    if (!LED_API_IsCorrectBlinkFrequency(blink_frequency)) {
-        snprintf(response->data, response->size, "%d: Incorrect blink frequency\n", blink_frequency);
+    return CLI_APP_Add_Task(eLedTask_Set_Brightness, &task_data, sizeof(task_data), CLI_APP_Led_Add_Task, response);
+}
 
-        return false;
-    }
+bool CLI_APP_Pwm_Led_Handlers_Pulse (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    eLedPwm_t led = (eLedPwm_t) arguments->value[0].uint_value;
+    uint8_t pulse_time = (uint8_t) arguments->value[1].uint_value;
+    uint16_t pulse_frequency = (uint16_t) arguments->value[2].uint_value;
 
-    sLedCommandDesc_t formated_task = {.task = eLedTask_Blink, .data = NULL};
-    sLedBlink_t *task_data = Heap_API_Calloc(1, sizeof(sLedBlink_t));
+    sLedPulse_t task_data = {.led = led, .pulse_time = pulse_time, .pulse_frequency = pulse_frequency};
 
-    if (task_data == NULL) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
-        
-        return false;
-    }
+    return CLI_APP_Add_Task(eLedTask_Pulse, &task_data, sizeof(task_data), CLI_APP_Led_Add_Task, response);
+}
+#endif
 
-    task_data->led = led;
-    task_data->blink_time = blink_time;
-    task_data->blink_frequency = blink_frequency;
-    formated_task.data = task_data;
+#ifdef USE_MOTORS
+bool CLI_APP_Motors_Handlers_Stop (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    sMotorCommandDesc_t formated_task = {.task = eMotorTask_Stop, .data = NULL, .arena = NULL, .release = NULL};
 
-    if (!LED_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
-        
-        Heap_API_Free(task_data);
+    if (!Motor_APP_Add_Task(&formated_task)) {
+        CMD_API_Writer_Printf(response, "Failed task add\n");
 
         return false;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
-#endif
-
-#ifdef USE_PWM_LED
-bool CLI_APP_Pwm_Led_Handlers_Set_Brightness (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
 
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-
-    eLedPwm_t led;
-    size_t led_value = 0;
-    size_t duty_cycle = 0;
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-    
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &duty_cycle, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
+bool CLI_APP_Motors_Handlers_Set (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    uint8_t speed = (uint8_t) arguments->value[0].uint_value;
+    eMotorDirection_t direction = (eMotorDirection_t) arguments->value[1].uint_value;
 
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    if (!Motor_API_IsCorrectSpeed(speed)) {
+        CMD_API_Writer_Printf(response, "%u: Incorect speed\n", (unsigned int) speed);
 
         return false;
     }
 
-    led = led_value;
+    sMotorSet_t task_data = {.speed = speed, .direction = direction};
 
-    if (!LED_API_IsCorrectPwmLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+    return CLI_APP_Add_Task(eMotorTask_Set, &task_data, sizeof(task_data), CLI_APP_Motors_Add_Task, response);
+}
+#endif
 
-        return false;
-    }
+bool CLI_APP_Uart_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    eUart_t uart = (eUart_t) arguments->value[0].uint_value;
 
-    if (!LED_API_IsCorrectDutyCycle(led, duty_cycle)) {
-        snprintf(response->data, response->size, "%d: Incorrect duty cycle\n", led);
+    sUartStats_t stats = {0};
+    sUartPoolStats_t pool_stats = {0};
+    sUartFsmStats_t fsm_stats = {0};
 
-        return false;
-    }
-
-    sLedCommandDesc_t formated_task = {.task = eLedTask_Set_Brightness, .data = NULL};
-    sLedSetBrightness_t *task_data = Heap_API_Calloc(1, sizeof(sLedSetBrightness_t));
+    if (!UART_API_GetStats(uart, &stats) || !UART_API_GetPoolStats(uart, &pool_stats) || !UART_API_GetFsmStats(&fsm_stats)) {
+        CMD_API_Writer_Printf(response, "%u: Incorrect uart\n", (unsigned int) uart);
 
-    if (task_data == NULL) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
-        
         return false;
     }
 
-    task_data->led = led;
-    task_data->duty_cycle = duty_cycle;
-    formated_task.data = task_data;
-
-    if (!LED_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
-        
-        Heap_API_Free(task_data);
-
-        return false;
-    }
+    CMD_API_Writer_Printf(response, "ore: %lu, fe: %lu, ne: %lu, pe: %lu, ring overflows: %lu, dma errors: %lu, oversized: %lu\n", (unsigned long) stats.overrun_errors, (unsigned long) stats.framing_errors, (unsigned long) stats.noise_errors, (unsigned long) stats.parity_errors, (unsigned long) stats.ring_overflows, (unsigned long) stats.dma_errors, (unsigned long) stats.oversized_messages);
+    CMD_API_Writer_Printf(response, "pool: %u/%u in use, high water: %u\n", (unsigned int) pool_stats.in_use, (unsigned int) pool_stats.size, (unsigned int) pool_stats.high_water_mark);
+    CMD_API_Writer_Printf(response, "fsm wakeups: %lu, busy: %lu us, sleep: %lu ms\n", (unsigned long) fsm_stats.wakeups, (unsigned long) fsm_stats.busy_time_us, (unsigned long) fsm_stats.sleep_time_ms);
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
 
-bool CLI_APP_Pwm_Led_Handlers_Pulse (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
+bool CLI_APP_Heap_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    for (eHeapPool_t pool = (eHeapPool_First + 1); pool < eHeapPool_Last; pool++) {
+        sHeapPoolStats_t pool_stats = {0};
 
-        return false;
-    }
+        Heap_API_GetPoolStats(pool, &pool_stats);
 
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
+        CMD_API_Writer_Printf(response, "pool %u: %u/%u in use, high water: %u\n", (unsigned int) pool_stats.block_size, (unsigned int) pool_stats.in_use, (unsigned int) pool_stats.block_count, (unsigned int) pool_stats.high_water_mark);
     }
 
-    eLedPwm_t led;
-    size_t led_value = 0;
-    size_t pulse_time = 0;
-    size_t pulse_frequency = 0;
+    #ifdef ENABLE_HEAP_TRACKING
+    sHeapStats_t stats = {0};
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-    
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &pulse_time, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
+    if (!Heap_API_GetStats(&stats)) {
+        CMD_API_Writer_Printf(response, "Failed to read heap stats\n");
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &pulse_frequency, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
         return false;
     }
 
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
-
-        return false;
-    }
+    CMD_API_Writer_Printf(response, "live: %u B in %u, peak: %u B, failed: %lu, untracked allocations: %lu, untracked frees: %lu\n", (unsigned int) stats.live_bytes, (unsigned int) stats.live_allocations, (unsigned int) stats.peak_bytes, (unsigned long) stats.failed_allocations, (unsigned long) stats.untracked_allocations, (unsigned long) stats.untracked_frees);
+    CMD_API_Writer_Printf(response, "heap arena: %u B, free in arena: %u B\n", (unsigned int) stats.heap_arena_bytes, (unsigned int) stats.heap_free_bytes);
 
-    led = led_value;
+    sHeapCallSite_t call_sites[HEAP_REPORT_CALL_SITES] = {0};
+    size_t call_site_count = Heap_API_GetTopCallSites(call_sites, HEAP_REPORT_CALL_SITES);
 
-    if (!LED_API_IsCorrectPwmLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+    for (size_t call_site = 0; call_site < call_site_count; call_site++) {
+        const char *file = strrchr(call_sites[call_site].file, '/');
 
-        return false;
+        CMD_API_Writer_Printf(response, "%s:%lu live: %u B in %lu, total: %lu\n", (file != NULL) ? (file + 1) : call_sites[call_site].file, (unsigned long) call_sites[call_site].line, (unsigned int) call_sites[call_site].live_bytes, (unsigned long) call_sites[call_site].live_allocations, (unsigned long) call_sites[call_site].total_allocations);
     }
 
-    if (!LED_API_IsCorrectPulseTime(pulse_time)) {
-        snprintf(response->data, response->size, "%d: Incorrect pulse time\n", led);
+    sHeapAllocation_t allocations[HEAP_REPORT_ALLOCATIONS] = {0};
+    size_t allocation_count = Heap_API_GetAllocations(allocations, HEAP_REPORT_ALLOCATIONS);
 
-        return false;
-    }
+    for (size_t allocation = 0; allocation < allocation_count; allocation++) {
+        const char *file = strrchr(allocations[allocation].file, '/');
 
-    if (!LED_API_IsCorrectPulseFrequency(pulse_frequency)) {
-        snprintf(response->data, response->size, "%d: Incorrect pulse frequency\n", led);
-
-        return false;
+        CMD_API_Writer_Printf(response, "outstanding %p: %u B from %s:%lu\n", allocations[allocation].pointer, (unsigned int) allocations[allocation].size, (file != NULL) ? (file + 1) : allocations[allocation].file, (unsigned long) allocations[allocation].line);
     }
+    #endif
 
-    sLedCommandDesc_t formated_task = {.task = eLedTask_Pulse, .data = NULL};
-    sLedPulse_t *task_data = Heap_API_Calloc(1, sizeof(sLedPulse_t));
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
-    if (task_data == NULL) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
-        
-        return false;
-    }
+    return true;
+}
 
-    task_data->led = led;
-    task_data->pulse_time = pulse_time;
-    task_data->pulse_frequency = pulse_frequency;
-    formated_task.data = task_data;
+#ifdef ENABLE_STACK_MONITOR
+bool CLI_APP_Stack_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    for (size_t thread = 0; thread < Stack_API_GetCount(); thread++) {
+        sStackStats_t stats = {0};
 
-    if (!LED_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
-        
-        Heap_API_Free(task_data);
+        if (!Stack_API_GetStats(thread, &stats)) {
+            continue;
+        }
 
-        return false;
+        CMD_API_Writer_Printf(response, "%s: size %u B, peak %u B, free %u B, suggested %u B\n", (stats.name != NULL) ? stats.name : "?", (unsigned int) stats.stack_size, (unsigned int) stats.peak_used, (unsigned int) stats.free_min, (unsigned int) stats.suggested_size);
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
 #endif
 
-#ifdef USE_MOTORS
-bool CLI_APP_Motors_Handlers_Stop (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
+#ifdef ENABLE_DEBUG
+bool CLI_APP_Debug_Handlers_SetLevel (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    eTraceModule_t module = (eTraceModule_t) arguments->value[0].uint_value;
+    eTraceLevel_t level = (eTraceLevel_t) arguments->value[1].uint_value;
 
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
+    if (!Debug_API_SetModuleLevel(module, level)) {
+        CMD_API_Writer_Printf(response, "Invalid module or level\n");
 
         return false;
     }
 
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
-        return false;
-    }
+    return true;
+}
 
-    sMotorCommandDesc_t formated_task = {.task = eMotorTask_Stop, .data = NULL};
+bool CLI_APP_Debug_Handlers_Levels (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    for (eTraceModule_t module = (eTraceModule_None + 1); module < eTraceModule_Last; module++) {
+        eTraceLevel_t level = eTraceLevel_First;
 
-    if (!Motor_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        if ((Debug_API_GetModuleName(module) == NULL) || !Debug_API_GetModuleLevel(module, &level)) {
+            continue;
+        }
 
-        return false;
+        CMD_API_Writer_Printf(response, "%u %s: level %u\n", (unsigned int) module, Debug_API_GetModuleName(module), (unsigned int) level);
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
+#endif
 
-bool CLI_APP_Motors_Handlers_Set (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-
-    eMotorDirection_t direction;
-    size_t speed = 0;
-    size_t direction_value = 0;
+#ifdef ENABLE_SPAN_TRACE
+bool CLI_APP_Span_Handlers_Dump (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    if (!Span_API_Dump()) {
+        CMD_API_Writer_Printf(response, "Trace dump failed\n");
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &speed, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
         return false;
     }
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &direction_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
-
-        return false;
-    }
+    return true;
+}
+#endif
 
-    direction = direction_value;
+#ifdef ENABLE_RUN_TIME_STATS
+bool CLI_APP_Cpu_Handlers_Top (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    uint32_t window_ms = CPU_API_GetWindowMs();
 
-    if (!Motor_API_IsCorrectSpeed(speed)) {
-        snprintf(response->data, response->size, "%d: Incorect speed\n", speed);
+    if (window_ms == 0) {
+        CMD_API_Writer_Printf(response, "No samples yet\n");
 
         return false;
     }
 
-    if (!Motor_API_IsCorrectDirection(direction)) {
-        snprintf(response->data, response->size, "%d: Incorect motors direction\n", direction);
+    CMD_API_Writer_Printf(response, "Last %u ms\n", (unsigned int) window_ms);
 
-        return false;
-    }
+    for (size_t thread = 0; thread < CPU_API_GetThreadCount(); thread++) {
+        sCpuThreadStats_t stats = {0};
 
-    sMotorCommandDesc_t formated_task = {.task = eMotorTask_Set, .data = NULL};
-    sMotorSet_t *task_data = Heap_API_Calloc(1, sizeof(sMotorSet_t));
+        if (!CPU_API_GetThreadStats(thread, &stats)) {
+            continue;
+        }
 
-    if (task_data == NULL) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
-        
-        return false;
+        CMD_API_Writer_Printf(response, "%s: %u.%u%% cpu, %u switches\n", stats.name, (unsigned int) (stats.load_permille / 10U), (unsigned int) (stats.load_permille % 10U), (unsigned int) stats.switches);
     }
 
-    task_data->speed = speed;
-    task_data->direction = direction;
-    formated_task.data = task_data;
+    for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+        sCpuIsrStats_t stats = {0};
 
-    if (!Motor_APP_Add_Task(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
-        
-        Heap_API_Free(task_data);
+        if (!CPU_API_GetIsrStats(source, &stats)) {
+            continue;
+        }
 
-        return false;
+        CMD_API_Writer_Printf(response, "isr %s: %u.%u%% cpu, %u calls, %u cycles avg\n", stats.name, (unsigned int) (stats.load_permille / 10U), (unsigned int) (stats.load_permille % 10U), (unsigned int) stats.count, (unsigned int) stats.average_cycles);
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
 #endif
 
-bool CLI_APP_Led_Handlers_RgbToHsv (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-
-    size_t red = 0;
-    size_t green = 0;
-    size_t blue = 0;
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &red, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &green, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
+#ifdef ENABLE_CLI_RPC
+bool CLI_APP_Rpc_Handlers_Enter (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    if (!CLI_APP_Rpc_Enter()) {
+        CMD_API_Writer_Printf(response, "Failed to enter RPC mode\n");
 
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &blue, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
         return false;
     }
-    
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
 
-        return false;
-    }
+    CMD_API_Writer_Printf(response, "RPC mode, command id 0x%04X returns to text\n", (unsigned int) CMD_RPC_EXIT_ID);
 
-    if ((red > 255) || (green > 255) || (blue > 255)) {
-        snprintf(response->data, response->size, "Invalid RGB values\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
-        return false;
-    }
+    return true;
+}
+#endif
 
-    sLedColorRgb_t rgb = {0};
+bool CLI_APP_Led_Handlers_RgbToHsv (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    sLedColorRgb_t rgb = {.color = arguments->value[0].uint_value};
     sLedColorHsv_t hsv = {0};
-    rgb.color = (red << 16) | (green << 8) | blue;
 
     LED_RgbToHsv(rgb, &hsv);
 
-    TRACE_INFO("hue: %d, sat: %d, val: %d\n", hsv.hue, hsv.saturation, hsv.value);
+    CMD_API_Writer_Printf(response, "hue: %d, sat: %d, val: %d\n", hsv.hue, hsv.saturation, hsv.value);
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
 
-bool CLI_APP_Led_Handlers_HsvToRgb (sMessage_t arguments, sMessage_t *response) {
-    if (response == NULL) {
-        TRACE_ERR("Invalid data pointer\n");
-
-        return false;
-    }
-
-    if ((response->data == NULL)) {
-        TRACE_ERR("Invalid response data pointer\n");
-
-        return false;
-    }
-
-    size_t hue = 0;
-    size_t saturation = 0;
-    size_t value = 0;
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &hue, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &saturation, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-
-    if (CMD_API_Helper_FindNextArgUInt(&arguments, &value, CMD_SEPARATOR, CMD_SEPARATOR_LENGHT, response) != eErrorCode_OSOK) {
-        return false;
-    }
-    
-    if (arguments.size != 0) {
-        snprintf(response->data, response->size, "Too many arguments\n");
-
-        return false;
-    }
-
-    if ((hue > 255) || (saturation > 255) || (value > 255)) {
-        snprintf(response->data, response->size, "Invalid RGB values\n");
-
-        return false;
-    }
-
+bool CLI_APP_Led_Handlers_HsvToRgb (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
     sLedColorHsv_t hsv = {0};
     sLedColorRgb_t rgb = {0};
 
-    hsv.hue = hue;
-    hsv.saturation = saturation;
-    hsv.value = value;
+    hsv.hue = (arguments->value[0].uint_value >> 16) & 0xFF;
+    hsv.saturation = (arguments->value[0].uint_value >> 8) & 0xFF;
+    hsv.value = arguments->value[0].uint_value & 0xFF;
 
     LED_HsvToRgb(hsv, &rgb);
 
-    TRACE_INFO("red: %d, green: %d, blue: %d\n", (rgb.color >> 16) & 0xFF, (rgb.color >> 8) & 0xFF, rgb.color & 0xFF);
+    CMD_API_Writer_Printf(response, "red: %d, green: %d, blue: %d\n", (rgb.color >> 16) & 0xFF, (rgb.color >> 8) & 0xFF, rgb.color & 0xFF);
     
-    snprintf(response->data, response->size, "Operation successful\n");
+    CMD_API_Writer_Printf(response, "Operation successful\n");
 
     return true;
 }
@@ -6,6 +6,7 @@
 
 #include <stdbool.h>
 #include "message.h"
+#include "cmd_api.h"
 #include "framework_config.h"
 
 /**********************************************************************************************************************
@@ -24,15 +25,33 @@
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-bool CLI_APP_Led_Handlers_Set (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Led_Handlers_Reset (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Led_Handlers_Toggle (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Led_Handlers_Blink (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Pwm_Led_Handlers_Set_Brightness (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Pwm_Led_Handlers_Pulse (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Motors_Handlers_Stop (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Motors_Handlers_Set (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Led_Handlers_RgbToHsv (sMessage_t arguments, sMessage_t *response);
-bool CLI_APP_Led_Handlers_HsvToRgb (sMessage_t arguments, sMessage_t *response);
+bool CLI_APP_Led_Handlers_Set (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Led_Handlers_Reset (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Led_Handlers_Toggle (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Led_Handlers_Blink (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Pwm_Led_Handlers_Set_Brightness (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Pwm_Led_Handlers_Pulse (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Motors_Handlers_Stop (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Motors_Handlers_Set (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Uart_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Heap_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#ifdef ENABLE_STACK_MONITOR
+bool CLI_APP_Stack_Handlers_Stats (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#endif
+#ifdef ENABLE_DEBUG
+bool CLI_APP_Debug_Handlers_SetLevel (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Debug_Handlers_Levels (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#endif
+#ifdef ENABLE_SPAN_TRACE
+bool CLI_APP_Span_Handlers_Dump (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#endif
+#ifdef ENABLE_RUN_TIME_STATS
+bool CLI_APP_Cpu_Handlers_Top (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#endif
+#ifdef ENABLE_CLI_RPC
+bool CLI_APP_Rpc_Handlers_Enter (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+#endif
+bool CLI_APP_Led_Handlers_RgbToHsv (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+bool CLI_APP_Led_Handlers_HsvToRgb (const sCmdArgs_t *arguments, sCmdWriter_t *response);
 
 #endif /* SOURCE_APP_CLI_APP_HANDLERS_H_ */
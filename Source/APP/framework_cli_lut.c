@@ -6,7 +6,12 @@
 
 #ifdef ENABLE_CLI
 
+#include <stdint.h>
 #include "cli_cmd_handlers.h"
+#include "led_api.h"
+#include "motor_api.h"
+#include "uart_api.h"
+#include "debug_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -22,6 +27,76 @@
  * Private constants
  *********************************************************************************************************************/
 
+/* clang-format off */
+#ifdef USE_LED
+static const sCmdArgDesc_t g_led_arguments[] = {
+    CMD_ARG_UINT("led", eLed_First + 1, eLed_Last - 1)
+};
+
+static const sCmdArgDesc_t g_led_blink_arguments[] = {
+    CMD_ARG_UINT("led", eLed_First + 1, eLed_Last - 1),
+    CMD_ARG_UINT("blink time", 1, MAX_BLINK_TIME),
+    CMD_ARG_UINT("blink frequency", MIN_BLINK_FREQUENCY, MAX_BLINK_FREQUENCY)
+};
+#endif
+
+#ifdef USE_PWM_LED
+static const sCmdArgDesc_t g_pwm_led_brightness_arguments[] = {
+    CMD_ARG_UINT("led", eLedPwm_First + 1, eLedPwm_Last - 1),
+    CMD_ARG_UINT("duty cycle", 0, UINT8_MAX)
+};
+
+static const sCmdArgDesc_t g_pwm_led_pulse_arguments[] = {
+    CMD_ARG_UINT("led", eLedPwm_First + 1, eLedPwm_Last - 1),
+    CMD_ARG_UINT("pulse time", 1, MAX_PULSING_TIME),
+    CMD_ARG_UINT("pulse frequency", 1, MAX_PULSE_FREQUENCY)
+};
+#endif
+
+#ifdef USE_MOTORS
+static const char * const g_motor_direction_names[eMotorDirection_Last] = {
+    [eMotorDirection_Forward] = "forward",
+    [eMotorDirection_Reverse] = "reverse",
+    [eMotorDirection_Right] = "right",
+    [eMotorDirection_Left] = "left",
+    [eMotorDirection_RightSoft] = "right_soft",
+    [eMotorDirection_LeftSoft] = "left_soft"
+};
+
+static const sCmdArgDesc_t g_motors_set_arguments[] = {
+    CMD_ARG_UINT("speed", 0, UINT8_MAX),
+    CMD_ARG_ENUM("direction", g_motor_direction_names)
+};
+#endif
+
+static const sCmdArgDesc_t g_uart_stats_arguments[] = {
+    CMD_ARG_UINT("uart", eUart_First + 1, eUart_Last - 1)
+};
+
+#ifdef ENABLE_DEBUG
+/* eTraceLevel_Last mutes the module */
+static const char * const g_trace_level_names[eTraceLevel_Last + 1] = {
+    [eTraceLevel_Info] = "info",
+    [eTraceLevel_Warning] = "warning",
+    [eTraceLevel_Error] = "error",
+    [eTraceLevel_Last] = "off"
+};
+
+static const sCmdArgDesc_t g_log_level_arguments[] = {
+    CMD_ARG_UINT("module", eTraceModule_None + 1, eTraceModule_Last - 1),
+    CMD_ARG_ENUM("level", g_trace_level_names)
+};
+#endif
+
+static const sCmdArgDesc_t g_rgb_arguments[] = {
+    CMD_ARG_RGB("rgb")
+};
+
+static const sCmdArgDesc_t g_hsv_arguments[] = {
+    CMD_ARG_HSV("hsv")
+};
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
@@ -35,51 +110,104 @@ sCmdDesc_t g_framework_cli_lut[eCliFrameworkCmd_Last] = {
     #ifdef USE_LED
     [eCliFrameworkCmd_Led_Set] = {
         DEFINE_CMD("led_set:"),
-        .handler = CLI_APP_Led_Handlers_Set
+        CMD_ARGUMENTS(g_led_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_Set
     },
     [eCliFrameworkCmd_Led_Reset] = {
         DEFINE_CMD("led_reset:"),
-        .handler = CLI_APP_Led_Handlers_Reset
+        CMD_ARGUMENTS(g_led_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_Reset
     },
     [eCliFrameworkCmd_Led_Toggle] = {
         DEFINE_CMD("led_toggle:"),
-        .handler = CLI_APP_Led_Handlers_Toggle
+        CMD_ARGUMENTS(g_led_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_Toggle
     },
     [eCliFrameworkCmd_Led_Blink] = {
         DEFINE_CMD("led_blink:"),
-        .handler = CLI_APP_Led_Handlers_Blink
+        CMD_ARGUMENTS(g_led_blink_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_Blink
     },
     #endif
 
     #ifdef USE_PWM_LED
     [eCliFrameworkCmd_Pwm_Led_SetBrightness] = {
         DEFINE_CMD("led_setb:"),
-        .handler = CLI_APP_Pwm_Led_Handlers_Set_Brightness
+        CMD_ARGUMENTS(g_pwm_led_brightness_arguments),
+        .typed_handler = CLI_APP_Pwm_Led_Handlers_Set_Brightness
     },
     [eCliFrameworkCmd_Pwm_Led_Pulse] = {
         DEFINE_CMD("led_pulse:"),
-        .handler = CLI_APP_Pwm_Led_Handlers_Pulse
+        CMD_ARGUMENTS(g_pwm_led_pulse_arguments),
+        .typed_handler = CLI_APP_Pwm_Led_Handlers_Pulse
     },
     #endif
 
     #ifdef USE_MOTORS
     [eCliFrameworkCmd_Motors_Set] = {
         DEFINE_CMD("motors_set:"),
-        .handler = CLI_APP_Motors_Handlers_Set
+        CMD_ARGUMENTS(g_motors_set_arguments),
+        .typed_handler = CLI_APP_Motors_Handlers_Set
     },
     [eCliFrameworkCmd_Motors_Stop] = {
         DEFINE_CMD("motors_stop"),
-        .handler = CLI_APP_Motors_Handlers_Stop
+        .typed_handler = CLI_APP_Motors_Handlers_Stop
+    },
+    #endif
+
+    [eCliFrameworkCmd_Uart_Stats] = {
+        DEFINE_CMD("uart_stats:"),
+        CMD_ARGUMENTS(g_uart_stats_arguments),
+        .typed_handler = CLI_APP_Uart_Handlers_Stats
+    },
+    [eCliFrameworkCmd_Heap_Stats] = {
+        DEFINE_CMD("heap_stats"),
+        .typed_handler = CLI_APP_Heap_Handlers_Stats
+    },
+    #ifdef ENABLE_STACK_MONITOR
+    [eCliFrameworkCmd_Stack_Stats] = {
+        DEFINE_CMD("stack_stats"),
+        .typed_handler = CLI_APP_Stack_Handlers_Stats
+    },
+    #endif
+    #ifdef ENABLE_DEBUG
+    [eCliFrameworkCmd_Log_Level] = {
+        DEFINE_CMD("log_level:"),
+        CMD_ARGUMENTS(g_log_level_arguments),
+        .typed_handler = CLI_APP_Debug_Handlers_SetLevel
+    },
+    [eCliFrameworkCmd_Log_Levels] = {
+        DEFINE_CMD("log_levels"),
+        .typed_handler = CLI_APP_Debug_Handlers_Levels
+    },
+    #endif
+    #ifdef ENABLE_SPAN_TRACE
+    [eCliFrameworkCmd_Trace_Dump] = {
+        DEFINE_CMD("trace_dump"),
+        .typed_handler = CLI_APP_Span_Handlers_Dump
+    },
+    #endif
+    #ifdef ENABLE_RUN_TIME_STATS
+    [eCliFrameworkCmd_Top] = {
+        DEFINE_CMD("top"),
+        .typed_handler = CLI_APP_Cpu_Handlers_Top
+    },
+    #endif
+    #ifdef ENABLE_CLI_RPC
+    [eCliFrameworkCmd_Rpc] = {
+        DEFINE_CMD("rpc"),
+        .typed_handler = CLI_APP_Rpc_Handlers_Enter
     },
     #endif
-    
     [eCliFrameworkCmd_RgbToHsv] = {
         DEFINE_CMD("rgb:"),
-        .handler = CLI_APP_Led_Handlers_RgbToHsv
+        CMD_ARGUMENTS(g_rgb_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_RgbToHsv
     },
     [eCliFrameworkCmd_HsvToRgb] = {
         DEFINE_CMD("hsv:"),
-        .handler = CLI_APP_Led_Handlers_HsvToRgb
+        CMD_ARGUMENTS(g_hsv_arguments),
+        .typed_handler = CLI_APP_Led_Handlers_HsvToRgb
     }
 };
 /* clang-format on */
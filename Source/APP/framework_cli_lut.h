@@ -36,6 +36,24 @@ typedef enum eCliFrameworkCmd {
     eCliFrameworkCmd_Motors_Stop,
     #endif
 
+    eCliFrameworkCmd_Uart_Stats,
+    eCliFrameworkCmd_Heap_Stats,
+    #ifdef ENABLE_STACK_MONITOR
+    eCliFrameworkCmd_Stack_Stats,
+    #endif
+    #ifdef ENABLE_DEBUG
+    eCliFrameworkCmd_Log_Level,
+    eCliFrameworkCmd_Log_Levels,
+    #endif
+    #ifdef ENABLE_SPAN_TRACE
+    eCliFrameworkCmd_Trace_Dump,
+    #endif
+    #ifdef ENABLE_RUN_TIME_STATS
+    eCliFrameworkCmd_Top,
+    #endif
+    #ifdef ENABLE_CLI_RPC
+    eCliFrameworkCmd_Rpc,
+    #endif
     eCliFrameworkCmd_RgbToHsv,
     eCliFrameworkCmd_HsvToRgb,
     eCliFrameworkCmd_Last
@@ -8,9 +8,10 @@
 
 #include <stddef.h>
 #include "cmsis_os2.h"
-#include "cli_app.h"
+#include "rtos_static.h"
 #include "debug_api.h"
 #include "heap_api.h"
+#include "stack_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -18,6 +19,7 @@
 
 #define MESSAGE_QUEUE_PRIORITY 0U
 #define MESSAGE_QUEUE_TIMEOUT 0U
+#define LED_APP_THREAD_STACK_SIZE (128 * 6)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -27,28 +29,38 @@
  * Private constants
  *********************************************************************************************************************/
 
-CREATE_MODULE_NAME (LED_APP)
+CREATE_FRAMEWORK_MODULE_NAME (LED_APP)
+
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_led_thread_cb;
+static uint64_t g_led_thread_stack[RTOS_STACK_LENGTH(LED_APP_THREAD_STACK_SIZE)];
+static StaticQueue_t g_led_message_queue_cb;
+static uint8_t g_led_message_queue_storage[CLI_COMMAND_MESSAGE_CAPACITY * sizeof(sLedCommandDesc_t)];
+#endif
 
 const static osThreadAttr_t g_led_thread_attributes = {
     .name = "LED_APP_Thread",
-    .stack_size = 128 * 6,
+    .cb_mem = RTOS_STATIC_MEM(g_led_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_led_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_led_thread_stack),
+    .stack_size = LED_APP_THREAD_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
 const static osMessageQueueAttr_t g_led_message_queue_attributes = {
     .name = "Led_Command_MessageQueue", 
     .attr_bits = 0, 
-    .cb_mem = NULL, 
-    .cb_size = 0, 
-    .mq_mem = NULL, 
-    .mq_size = 0
+    .cb_mem = RTOS_STATIC_MEM(g_led_message_queue_cb), 
+    .cb_size = RTOS_STATIC_SIZE(g_led_message_queue_cb), 
+    .mq_mem = RTOS_STATIC_MEM(g_led_message_queue_storage), 
+    .mq_size = RTOS_STATIC_SIZE(g_led_message_queue_storage)
 };
 
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 
-static sLedCommandDesc_t g_received_task = {.task = eLedTask_Last, .data = NULL};
+static sLedCommandDesc_t g_received_task = {.task = eLedTask_Last, .data = NULL, .arena = NULL, .release = NULL};
 static bool g_is_initialized = false;
 
 static osThreadId_t g_led_thread_id = NULL;
@@ -63,11 +75,26 @@ static osMessageQueueId_t g_led_message_queue_id = NULL;
  *********************************************************************************************************************/
  
 static void LED_APP_Thread (void *arg);
+static void LED_APP_ReleaseTask (sLedCommandDesc_t *task);
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+static void LED_APP_ReleaseTask (sLedCommandDesc_t *task) {
+    if (task->release != NULL) {
+        task->release(task->arena);
+    } else if (task->data != NULL) {
+        Heap_API_Free(task->data);
+    }
+
+    task->data = NULL;
+    task->arena = NULL;
+    task->release = NULL;
+
+    return;
+}
+
 static void LED_APP_Thread (void *arg) {
     while (1) {
         if (osMessageQueueGet(g_led_message_queue_id, &g_received_task, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_TIMEOUT) != osOK) {
@@ -85,30 +112,22 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
                 
                 if (!LED_API_IsCorrectLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
                 
                 if (!LED_API_TurnOn(arguments->led)) {
                     TRACE_ERR("LED Turn On Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Led %d Set\n", arguments->led);
-
-                Heap_API_Free(arguments);    
             } break;
             case eLedTask_Reset: {
                 sLedCommon_t *arguments = (sLedCommon_t*) g_received_task.data;
@@ -116,30 +135,22 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_TurnOff(arguments->led)) {
                     TRACE_ERR("LED Turn Off Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Led %d Reset\n", arguments->led);
-
-                Heap_API_Free(arguments);
             } break;
             case eLedTask_Toggle: {
                 sLedCommon_t *arguments = (sLedCommon_t*) g_received_task.data;
@@ -147,30 +158,22 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_Toggle(arguments->led)) {
                     TRACE_ERR("LED Toggle Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Led %d Toggle\n", arguments->led);
-
-                Heap_API_Free(arguments);
             } break;
             case eLedTask_Blink: {
                 sLedBlink_t *arguments = (sLedBlink_t*) g_received_task.data;
@@ -178,46 +181,34 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectBlinkTime(arguments->blink_time)) {
                     TRACE_ERR("Invalid blink time\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectBlinkFrequency(arguments->blink_frequency)) {
                     TRACE_ERR("Invalid blink frequency\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_Blink(arguments->led, arguments->blink_time, arguments->blink_frequency)) {
                     TRACE_ERR("LED Blink Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Led %d Blink %d s, @ %d Hz\n", arguments->led, arguments->blink_time, arguments->blink_frequency);
-
-                Heap_API_Free(arguments);
             } break;
             #endif
 
@@ -228,38 +219,28 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectPwmLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectDutyCycle(arguments->led, arguments->duty_cycle)) {
                     TRACE_ERR("Invalid duty cycle\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_Set_Brightness(arguments->led, arguments->duty_cycle)) {
                     TRACE_ERR("LED Set Brightness Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Pwm Led Brightness %d\n", arguments->led, arguments->duty_cycle);
-
-                Heap_API_Free(arguments);
             } break;
             case eLedTask_Pulse: {
                 sLedPulse_t *arguments = (sLedPulse_t*) g_received_task.data;
@@ -267,52 +248,42 @@ static void LED_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectPwmLed(arguments->led)) {
                     TRACE_ERR("Invalid Led\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectPulseTime(arguments->pulse_time)) {
                     TRACE_ERR("Invalid pulse time\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_IsCorrectPulseFrequency(arguments->pulse_frequency)) {
                     TRACE_ERR("Invalid pulse frequency\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!LED_API_Pulse(arguments->led, arguments->pulse_time, arguments->pulse_frequency)) {
                     TRACE_ERR("LED Pulse Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Pwm Led %d Pulse %d s, @ %d Hz\n", arguments->led, arguments->pulse_time, arguments->pulse_frequency);
-
-                Heap_API_Free(arguments);
             } break;
             #endif
             default: {
                 TRACE_ERR("Task not found\n");
             } break;
         }
+
+        LED_APP_ReleaseTask(&g_received_task);
     }
 
     osThreadYield();
@@ -337,6 +308,8 @@ bool LED_APP_Init (void) {
 
     if (g_led_thread_id == NULL) {
         g_led_thread_id = osThreadNew(LED_APP_Thread, NULL, &g_led_thread_attributes);
+
+        Stack_API_Track(g_led_thread_id, LED_APP_THREAD_STACK_SIZE);
     }
 
     g_is_initialized = true;
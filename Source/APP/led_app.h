@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "led_api.h"
+#include "arena.h"
 #include "framework_config.h"
 
 /**********************************************************************************************************************
@@ -39,6 +40,9 @@ typedef enum eLedTask {
 typedef struct sLedCommandDesc {
     eLedTask_t task;
     void *data;
+    /* The APP thread hands the arena to release once the task is done, without a release data goes to Heap_API_Free */
+    sArena_t *arena;
+    bool (*release) (sArena_t *arena);
 } sLedCommandDesc_t;
 
 typedef struct sLedCommon {
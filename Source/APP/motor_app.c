@@ -8,10 +8,11 @@
 
 #include <stddef.h>
 #include "cmsis_os2.h"
-#include "cli_app.h"
+#include "rtos_static.h"
 #include "debug_api.h"
-#include "motor_api.h"
 #include "heap_api.h"
+#include "motor_api.h"
+#include "stack_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -20,6 +21,7 @@
 #define MESSAGE_QUEUE_CAPACITY 10
 #define MESSAGE_QUEUE_PRIORITY 0U
 #define MESSAGE_QUEUE_TIMEOUT 0U
+#define MOTOR_APP_THREAD_STACK_SIZE (128 * 5)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -29,28 +31,38 @@
  * Private constants
  *********************************************************************************************************************/
 
-CREATE_MODULE_NAME (Motor_APP)
+CREATE_FRAMEWORK_MODULE_NAME (Motor_APP)
+
+#ifdef USE_STATIC_RTOS_OBJECTS
+static StaticTask_t g_motor_thread_cb;
+static uint64_t g_motor_thread_stack[RTOS_STACK_LENGTH(MOTOR_APP_THREAD_STACK_SIZE)];
+static StaticQueue_t g_motor_message_queue_cb;
+static uint8_t g_motor_message_queue_storage[MESSAGE_QUEUE_CAPACITY * sizeof(sMotorCommandDesc_t)];
+#endif
 
 const static osThreadAttr_t g_motor_thread_attributes = {
     .name = "Motor_APP_Thread",
-    .stack_size = 128 * 5,
+    .cb_mem = RTOS_STATIC_MEM(g_motor_thread_cb),
+    .cb_size = RTOS_STATIC_SIZE(g_motor_thread_cb),
+    .stack_mem = RTOS_STATIC_MEM(g_motor_thread_stack),
+    .stack_size = MOTOR_APP_THREAD_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
 const static osMessageQueueAttr_t g_motor_message_queue_attributes = {
     .name = "Motor_Command_MessageQueue", 
     .attr_bits = 0, 
-    .cb_mem = NULL, 
-    .cb_size = 0, 
-    .mq_mem = NULL, 
-    .mq_size = 0
+    .cb_mem = RTOS_STATIC_MEM(g_motor_message_queue_cb), 
+    .cb_size = RTOS_STATIC_SIZE(g_motor_message_queue_cb), 
+    .mq_mem = RTOS_STATIC_MEM(g_motor_message_queue_storage), 
+    .mq_size = RTOS_STATIC_SIZE(g_motor_message_queue_storage)
 };
 
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 
-static sMotorCommandDesc_t g_received_task = {.task = eMotorTask_Last, .data = NULL};
+static sMotorCommandDesc_t g_received_task = {.task = eMotorTask_Last, .data = NULL, .arena = NULL, .release = NULL};
 static bool g_is_initialized = false; 
 
 static osThreadId_t g_motor_thread_id = NULL;
@@ -65,11 +77,26 @@ static osMessageQueueId_t g_motor_message_queue_id = NULL;
  *********************************************************************************************************************/
  
 static void Motor_APP_Thread (void *arg); 
+static void Motor_APP_ReleaseTask (sMotorCommandDesc_t *task);
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
  
+static void Motor_APP_ReleaseTask (sMotorCommandDesc_t *task) {
+    if (task->release != NULL) {
+        task->release(task->arena);
+    } else if (task->data != NULL) {
+        Heap_API_Free(task->data);
+    }
+
+    task->data = NULL;
+    task->arena = NULL;
+    task->release = NULL;
+
+    return;
+}
+
 static void Motor_APP_Thread (void *arg) {
     while (1) {
         if (osMessageQueueGet(g_motor_message_queue_id, &g_received_task, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_TIMEOUT) != osOK) {
@@ -89,38 +116,28 @@ static void Motor_APP_Thread (void *arg) {
                 if (arguments == NULL){
                     TRACE_ERR("No arguments\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
             
                 if (!Motor_API_IsCorrectSpeed(arguments->speed)) {
                     TRACE_ERR("Invalid Motor Speed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
             
                 if (!Motor_API_IsCorrectDirection(arguments->direction)) {
                     TRACE_ERR("Invalid Motor direction\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 if (!Motor_API_SetSpeed(arguments->speed, arguments->direction)) {
                     TRACE_ERR("Motor Set Speed Failed\n");
 
-                    Heap_API_Free(arguments);
-
                     break;
                 }
 
                 TRACE_INFO("Motors @ Speed %d, Dir %d\n", arguments->speed, arguments->direction);
-
-                Heap_API_Free(arguments);    
             } break;
             case eMotorTask_Stop: {
                 if (!Motor_API_StopAllMotors()) {
@@ -135,6 +152,8 @@ static void Motor_APP_Thread (void *arg) {
                 TRACE_ERR("Task not found\n");
             } break;
         }
+
+        Motor_APP_ReleaseTask(&g_received_task);
     }
 
     osThreadYield();
@@ -159,6 +178,8 @@ bool Motor_APP_Init (void) {
 
     if (g_motor_thread_id == NULL) {
         g_motor_thread_id = osThreadNew(Motor_APP_Thread, NULL, &g_motor_thread_attributes);
+
+        Stack_API_Track(g_motor_thread_id, MOTOR_APP_THREAD_STACK_SIZE);
     }
 
     g_is_initialized = true;
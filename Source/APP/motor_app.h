@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "motor_api.h"
+#include "arena.h"
 #include "framework_config.h"
 
 /**********************************************************************************************************************
@@ -28,6 +29,9 @@ typedef enum eMotorTask {
 typedef struct sMotorCommandDesc {
     eMotorTask_t task;
     void *data;
+    /* The APP thread hands the arena to release once the task is done, without a release data goes to Heap_API_Free */
+    sArena_t *arena;
+    bool (*release) (sArena_t *arena);
 } sMotorCommandDesc_t;
 
 typedef struct sMotorSet {
@@ -8,6 +8,7 @@
 
 #include "stm32f4xx_ll_dma.h"
 #include "stm32f4xx_ll_bus.h"
+#include "run_time_stats.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -97,6 +98,44 @@ const static sDmaStaticDesc_t g_static_dma_desc_lut[eDmaDriver_Last] = {
         .fifo_mode_fp = LL_DMA_DisableFifoMode,
     },
     #endif
+
+    #ifdef UART_DEBUG_RX_DMA
+    [eDmaDriver_UartDebugRx] = {
+        .dma = DMA1,
+        .enable_clock_fp = LL_AHB1_GRP1_EnableClock,
+        .clock = LL_AHB1_GRP1_PERIPH_DMA1,
+        .nvic = DMA1_Stream5_IRQn,
+        .channel = LL_DMA_CHANNEL_4,
+        .stream = LL_DMA_STREAM_5,
+        .data_direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY,
+        .mode = LL_DMA_MODE_CIRCULAR,
+        .periph_or_src_increment_mode = LL_DMA_PERIPH_NOINCREMENT,
+        .mem_or_dest_increment_mode = LL_DMA_MEMORY_INCREMENT,
+        .periph_or_src_size = LL_DMA_PDATAALIGN_BYTE,
+        .mem_or_dest_size = LL_DMA_MDATAALIGN_BYTE,
+        .priority_level = LL_DMA_PRIORITY_HIGH,
+        .fifo_mode_fp = LL_DMA_DisableFifoMode,
+    },
+    #endif
+
+    #ifdef UART_UROS_RX_DMA
+    [eDmaDriver_UartUrosRx] = {
+        .dma = DMA2,
+        .enable_clock_fp = LL_AHB1_GRP1_EnableClock,
+        .clock = LL_AHB1_GRP1_PERIPH_DMA2,
+        .nvic = DMA2_Stream2_IRQn,
+        .channel = LL_DMA_CHANNEL_4,
+        .stream = LL_DMA_STREAM_2,
+        .data_direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY,
+        .mode = LL_DMA_MODE_CIRCULAR,
+        .periph_or_src_increment_mode = LL_DMA_PERIPH_NOINCREMENT,
+        .mem_or_dest_increment_mode = LL_DMA_MEMORY_INCREMENT,
+        .periph_or_src_size = LL_DMA_PDATAALIGN_BYTE,
+        .mem_or_dest_size = LL_DMA_MDATAALIGN_BYTE,
+        .priority_level = LL_DMA_PRIORITY_HIGH,
+        .fifo_mode_fp = LL_DMA_DisableFifoMode,
+    },
+    #endif
 };
 
 static sDmaIsActiveFlags_t g_dma_is_active_flags_fp_lut[eDmaDriver_Last] = {
@@ -115,6 +154,22 @@ static sDmaIsActiveFlags_t g_dma_is_active_flags_fp_lut[eDmaDriver_Last] = {
         .is_active_te_flag_fp = LL_DMA_IsActiveFlag_TE2
     },
     #endif
+
+    #ifdef UART_DEBUG_RX_DMA
+    [eDmaDriver_UartDebugRx] = {
+        .is_active_tc_flag_fp = LL_DMA_IsActiveFlag_TC5,
+        .is_active_ht_flag_fp = LL_DMA_IsActiveFlag_HT5,
+        .is_active_te_flag_fp = LL_DMA_IsActiveFlag_TE5
+    },
+    #endif
+
+    #ifdef UART_UROS_RX_DMA
+    [eDmaDriver_UartUrosRx] = {
+        .is_active_tc_flag_fp = LL_DMA_IsActiveFlag_TC2,
+        .is_active_ht_flag_fp = LL_DMA_IsActiveFlag_HT2,
+        .is_active_te_flag_fp = LL_DMA_IsActiveFlag_TE2
+    },
+    #endif
 };
 
 const static sDmaClearFlags_t g_dma_clear_flags_fp_lut[eDmaDriver_Last] = {
@@ -133,6 +188,22 @@ const static sDmaClearFlags_t g_dma_clear_flags_fp_lut[eDmaDriver_Last] = {
         .clear_te_flag_fp = LL_DMA_ClearFlag_TE2
     },
     #endif
+
+    #ifdef UART_DEBUG_RX_DMA
+    [eDmaDriver_UartDebugRx] = {
+        .clear_tc_flag_fp = LL_DMA_ClearFlag_TC5,
+        .clear_ht_flag_fp = LL_DMA_ClearFlag_HT5,
+        .clear_te_flag_fp = LL_DMA_ClearFlag_TE5
+    },
+    #endif
+
+    #ifdef UART_UROS_RX_DMA
+    [eDmaDriver_UartUrosRx] = {
+        .clear_tc_flag_fp = LL_DMA_ClearFlag_TC2,
+        .clear_ht_flag_fp = LL_DMA_ClearFlag_HT2,
+        .clear_te_flag_fp = LL_DMA_ClearFlag_TE2
+    },
+    #endif
 };
 /* clang-format on */
 
@@ -159,6 +230,24 @@ static sDmaDynamicDesc_t g_dynamic_dma_lut[eDmaDriver_Last] = {
         .isr_callback = NULL
     },
     #endif
+
+    #ifdef UART_DEBUG_RX_DMA
+    [eDmaDriver_UartDebugRx] = {
+        .is_init = false,
+        .periph_or_src_addr = NULL,
+        .mem_or_dest_addr = NULL,
+        .isr_callback = NULL
+    },
+    #endif
+
+    #ifdef UART_UROS_RX_DMA
+    [eDmaDriver_UartUrosRx] = {
+        .is_init = false,
+        .periph_or_src_addr = NULL,
+        .mem_or_dest_addr = NULL,
+        .isr_callback = NULL
+    },
+    #endif
 };
 /* clang-format on */
 
@@ -173,6 +262,8 @@ static sDmaDynamicDesc_t g_dynamic_dma_lut[eDmaDriver_Last] = {
 static void DMAx_Streamx_ISRHandler(const eDmaDriver_t stream, const eDmaDriver_Flags_t flag);
 void DMA1_Stream2_IRQHandler(void);
 void DMA1_Stream4_IRQHandler(void);
+void DMA1_Stream5_IRQHandler(void);
+void DMA2_Stream2_IRQHandler(void);
 
 /**********************************************************************************************************************
  * Definitions of private functions
@@ -200,6 +291,8 @@ static void DMAx_Streamx_ISRHandler(const eDmaDriver_t stream, const eDmaDriver_
 
 void DMA1_Stream2_IRQHandler(void) {
     #ifdef USE_WS2812B_2
+    RUN_TIME_ISR_ENTER();
+
     if (LL_DMA_IsActiveFlag_TC2(DMA1)) {
         DMAx_Streamx_ISRHandler(eDmaDriver_Ws2812b_2, eDmaDriver_Flags_TC);
     }
@@ -211,6 +304,8 @@ void DMA1_Stream2_IRQHandler(void) {
     if (LL_DMA_IsActiveFlag_TE2(DMA1)) {
         DMAx_Streamx_ISRHandler(eDmaDriver_Ws2812b_2, eDmaDriver_Flags_TE);
     }
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Dma);
     #endif
 
     return;
@@ -218,6 +313,8 @@ void DMA1_Stream2_IRQHandler(void) {
 
 void DMA1_Stream4_IRQHandler(void) {
     #ifdef USE_WS2812B_1
+    RUN_TIME_ISR_ENTER();
+
     if (LL_DMA_IsActiveFlag_TC4(DMA1)) {
         DMAx_Streamx_ISRHandler(eDmaDriver_Ws2812b_1, eDmaDriver_Flags_TC);
     }
@@ -229,6 +326,52 @@ void DMA1_Stream4_IRQHandler(void) {
     if (LL_DMA_IsActiveFlag_TE4(DMA1)) {
         DMAx_Streamx_ISRHandler(eDmaDriver_Ws2812b_1, eDmaDriver_Flags_TE);
     }
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Dma);
+    #endif
+
+    return;
+}
+
+void DMA1_Stream5_IRQHandler(void) {
+    #ifdef UART_DEBUG_RX_DMA
+    RUN_TIME_ISR_ENTER();
+
+    if (LL_DMA_IsActiveFlag_TC5(DMA1)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartDebugRx, eDmaDriver_Flags_TC);
+    }
+
+    if (LL_DMA_IsActiveFlag_HT5(DMA1)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartDebugRx, eDmaDriver_Flags_HT);
+    }
+
+    if (LL_DMA_IsActiveFlag_TE5(DMA1)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartDebugRx, eDmaDriver_Flags_TE);
+    }
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Dma);
+    #endif
+
+    return;
+}
+
+void DMA2_Stream2_IRQHandler(void) {
+    #ifdef UART_UROS_RX_DMA
+    RUN_TIME_ISR_ENTER();
+
+    if (LL_DMA_IsActiveFlag_TC2(DMA2)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartUrosRx, eDmaDriver_Flags_TC);
+    }
+
+    if (LL_DMA_IsActiveFlag_HT2(DMA2)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartUrosRx, eDmaDriver_Flags_HT);
+    }
+
+    if (LL_DMA_IsActiveFlag_TE2(DMA2)) {
+        DMAx_Streamx_ISRHandler(eDmaDriver_UartUrosRx, eDmaDriver_Flags_TE);
+    }
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Dma);
     #endif
 
     return;
@@ -515,4 +658,22 @@ bool DMA_Driver_DisableItAll (const eDmaDriver_t stream) {
     return true;
 }
 
+bool DMA_Driver_GetDataLength (const eDmaDriver_t stream, size_t *length) {
+    if ((stream <= eDmaDriver_First) || (stream >= eDmaDriver_Last)) {
+        return false;
+    }
+
+    if (length == NULL) {
+        return false;
+    }
+
+    if (!g_dynamic_dma_lut[stream].is_init) {
+        return false;
+    }
+
+    *length = LL_DMA_GetDataLength(g_static_dma_desc_lut[stream].dma, g_static_dma_desc_lut[stream].stream);
+
+    return true;
+}
+
 #endif
@@ -29,6 +29,14 @@ typedef enum eDmaDriver{
     eDmaDriver_Ws2812b_2,
     #endif
 
+    #ifdef UART_DEBUG_RX_DMA
+    eDmaDriver_UartDebugRx,
+    #endif
+
+    #ifdef UART_UROS_RX_DMA
+    eDmaDriver_UartUrosRx,
+    #endif
+
     eDmaDriver_Last
 } eDmaDriver_t;
 
@@ -68,5 +76,6 @@ bool DMA_Driver_EnableIt (const eDmaDriver_t stream, const eDmaDriver_Flags_t fl
 bool DMA_Driver_EnableItAll (const eDmaDriver_t stream);
 bool DMA_Driver_DisableIt (const eDmaDriver_t stream, const eDmaDriver_Flags_t flag);
 bool DMA_Driver_DisableItAll (const eDmaDriver_t stream);
+bool DMA_Driver_GetDataLength (const eDmaDriver_t stream, size_t *length);
 
 #endif /* SOURCE_DRIVER_DMA_DRIVER_H_ */
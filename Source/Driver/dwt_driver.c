@@ -0,0 +1,63 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "dwt_driver.h"
+
+#if defined(ENABLE_DEBUG_DEFERRED) || defined(ENABLE_SPAN_TRACE) || defined(ENABLE_RUN_TIME_STATS)
+
+#include "stm32f4xx.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Free running core clock counter, wraps every 2^32 cycles (about 43 s at 100 MHz) */
+bool DWT_Driver_Init (void) {
+    if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0) {
+        return false;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return true;
+}
+
+uint32_t DWT_Driver_GetCycles (void) {
+    return DWT->CYCCNT;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SOURCE_DRIVER_DWT_DRIVER_H_
+#define SOURCE_DRIVER_DWT_DRIVER_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "framework_config.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool DWT_Driver_Init (void);
+uint32_t DWT_Driver_GetCycles (void);
+
+#endif /* SOURCE_DRIVER_DWT_DRIVER_H_ */
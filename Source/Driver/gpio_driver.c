@@ -55,6 +55,30 @@ const static sGpioDesc_t g_static_gpio_lut[eGpioPin_Last] = {
     },
     #endif
 
+    #ifdef UART_DEBUG_FLOW_CONTROL
+    [eGpioPin_DebugCts] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_0,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_7
+    },
+    /* Driven by the UART driver from the RX ring fill level, low means ready to receive */
+    [eGpioPin_DebugRts] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_1,
+        .mode = LL_GPIO_MODE_OUTPUT,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_0
+    },
+    #endif
+
     #ifdef USE_ONBOARD_LED
     [eGpioPin_OnboardLed] = {
         .port = GPIOA,
@@ -107,6 +131,135 @@ const static sGpioDesc_t g_static_gpio_lut[eGpioPin_Last] = {
     },
     #endif
 
+    #ifdef USE_UART_UROS_RX
+    [eGpioPin_uRosRx] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_10,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_7
+    },
+    #endif
+
+    #ifdef UART_UROS_FLOW_CONTROL
+    [eGpioPin_uRosCts] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_11,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_7
+    },
+    /* Driven by the UART driver from the RX ring fill level, low means ready to receive */
+    [eGpioPin_uRosRts] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_12,
+        .mode = LL_GPIO_MODE_OUTPUT,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_0
+    },
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eGpioPin_Usart3Tx] = {
+        .port = GPIOC,
+        .pin = LL_GPIO_PIN_10,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOC,
+        .alternate = LL_GPIO_AF_7
+    },
+    [eGpioPin_Usart3Rx] = {
+        .port = GPIOC,
+        .pin = LL_GPIO_PIN_11,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOC,
+        .alternate = LL_GPIO_AF_7
+    },
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eGpioPin_Uart4Tx] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_0,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_8
+    },
+    [eGpioPin_Uart4Rx] = {
+        .port = GPIOA,
+        .pin = LL_GPIO_PIN_1,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOA,
+        .alternate = LL_GPIO_AF_8
+    },
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eGpioPin_Uart5Tx] = {
+        .port = GPIOC,
+        .pin = LL_GPIO_PIN_12,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOC,
+        .alternate = LL_GPIO_AF_8
+    },
+    [eGpioPin_Uart5Rx] = {
+        .port = GPIOD,
+        .pin = LL_GPIO_PIN_2,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOD,
+        .alternate = LL_GPIO_AF_8
+    },
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eGpioPin_Usart6Tx] = {
+        .port = GPIOC,
+        .pin = LL_GPIO_PIN_6,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOC,
+        .alternate = LL_GPIO_AF_8
+    },
+    [eGpioPin_Usart6Rx] = {
+        .port = GPIOC,
+        .pin = LL_GPIO_PIN_7,
+        .mode = LL_GPIO_MODE_ALTERNATE,
+        .speed = LL_GPIO_SPEED_FREQ_VERY_HIGH,
+        .pull = LL_GPIO_PULL_NO,
+        .output = LL_GPIO_OUTPUT_PUSHPULL,
+        .clock = LL_AHB1_GRP1_PERIPH_GPIOC,
+        .alternate = LL_GPIO_AF_8
+    },
+    #endif
+
     #ifdef USE_MOTOR_A
     [eGpioPin_MotorA_A1] = {
         .port = GPIOB,
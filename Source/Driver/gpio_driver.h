@@ -25,6 +25,11 @@ typedef enum eGpioPin {
     eGpioPin_DebugRx,
     #endif
 
+    #ifdef UART_DEBUG_FLOW_CONTROL
+    eGpioPin_DebugCts,
+    eGpioPin_DebugRts,
+    #endif
+
     #ifdef USE_ONBOARD_LED
     eGpioPin_OnboardLed,
     #endif
@@ -41,6 +46,35 @@ typedef enum eGpioPin {
     eGpioPin_uRosTx,
     #endif
 
+    #ifdef USE_UART_UROS_RX
+    eGpioPin_uRosRx,
+    #endif
+
+    #ifdef UART_UROS_FLOW_CONTROL
+    eGpioPin_uRosCts,
+    eGpioPin_uRosRts,
+    #endif
+
+    #ifdef USE_UART_USART3
+    eGpioPin_Usart3Tx,
+    eGpioPin_Usart3Rx,
+    #endif
+
+    #ifdef USE_UART_UART4
+    eGpioPin_Uart4Tx,
+    eGpioPin_Uart4Rx,
+    #endif
+
+    #ifdef USE_UART_UART5
+    eGpioPin_Uart5Tx,
+    eGpioPin_Uart5Rx,
+    #endif
+
+    #ifdef USE_UART_USART6
+    eGpioPin_Usart6Tx,
+    eGpioPin_Usart6Rx,
+    #endif
+
     #ifdef USE_MOTOR_A
     eGpioPin_MotorA_A1,
     eGpioPin_MotorA_A2,
@@ -10,6 +10,7 @@
 #include "stm32f4xx_ll_i2c.h"
 #include "stm32f4xx_ll_gpio.h"
 #include "gpio_driver.h"
+#include "run_time_stats.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -109,6 +110,7 @@ static sI2cDynamicDesc_t g_dynamic_i2c_lut[eI2cDriver_Last] = {
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static void I2C1_EV_ISRHandler (void);
 void I2C1_EV_IRQHandler (void);
 void I2C_Driver_ClearAllFlags (const eI2cDriver_t i2c);
 
@@ -116,7 +118,7 @@ void I2C_Driver_ClearAllFlags (const eI2cDriver_t i2c);
  * Definitions of private functions
  *********************************************************************************************************************/
 
-void I2C1_EV_IRQHandler (void) {
+static void I2C1_EV_ISRHandler (void) {
     #ifdef USE_I2C1
     eI2cDriver_Flags_t flag = eI2cDriver_Flags_Last;
     
@@ -166,6 +168,16 @@ void I2C1_EV_IRQHandler (void) {
     return;
 }
 
+void I2C1_EV_IRQHandler (void) {
+    RUN_TIME_ISR_ENTER();
+
+    I2C1_EV_ISRHandler();
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_I2c);
+
+    return;
+}
+
 void I2C_Driver_ClearAllFlags (const eI2cDriver_t i2c) {
     if ((i2c <= eI2cDriver_First) || (i2c >= eI2cDriver_Last)) {
         return;
@@ -9,11 +9,18 @@
 #include "stm32f4xx_ll_bus.h"
 #include "stm32f4xx_ll_usart.h"
 #include "ring_buffer.h"
+#include "uart_rx_ring.h"
+#include "dma_driver.h"
+#include "gpio_driver.h"
+#include "run_time_stats.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+/* Only rings the producer may overwrite pay for the compare-and-swap pop, DMA rings always are */
+#define RX_RING_POLICY(overflow_policy) (((overflow_policy) == eUartDriver_Overflow_DropOldest) ? eRingBufferPolicy_Overwrite : eRingBufferPolicy_Reject)
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -30,18 +37,123 @@ typedef struct sUartDesc {
     uint32_t clock;
     void (*enable_clock_fp) (uint32_t);
     IRQn_Type nvic;
-    size_t ring_buffer_capacity;
+    eDmaDriver_t rx_dma_stream;
+    eUartDriver_Overflow_t rx_overflow_policy;
+    eGpioPin_t rts_pin;
 } sUartDesc_t;
 
-RingBuffer_Handle g_ring_buffer[eUartDriver_Last] = {
+typedef struct sUartDynamicDesc {
+    void (*isr_callback) (void *isr_callback_context, const eUartDriver_Flags_t);
+    void *isr_callback_context;
+    volatile bool is_rx_paused;
+    volatile bool is_rts_released;
+    /* Free TX ring bytes a writer waits for, 0 when nobody waits */
+    volatile size_t tx_space_wanted;
+    sUartRxDma_t rx_dma;
+    sUartDriver_Stats_t stats;
+} sUartDynamicDesc_t;
+
+#ifdef USE_UART_DEBUG
+#ifdef UART_DEBUG_RX_DMA
+RING_BUFFER_DEFINE_WITH_POLICY(g_debug_rx_ring_buffer, UART_DEBUG_BUFFER_CAPACITY, eRingBufferPolicy_Overwrite);
+#else
+RING_BUFFER_DEFINE_WITH_POLICY(g_debug_rx_ring_buffer, UART_DEBUG_BUFFER_CAPACITY, RX_RING_POLICY(UART_DEBUG_RX_OVERFLOW_POLICY));
+#endif
+#endif
+
+#ifdef USE_UART_UROS_RX
+#ifdef UART_UROS_RX_DMA
+RING_BUFFER_DEFINE_WITH_POLICY(g_uros_rx_ring_buffer, UART_UROS_BUFFER_CAPACITY, eRingBufferPolicy_Overwrite);
+#else
+RING_BUFFER_DEFINE_WITH_POLICY(g_uros_rx_ring_buffer, UART_UROS_BUFFER_CAPACITY, RX_RING_POLICY(UART_UROS_RX_OVERFLOW_POLICY));
+#endif
+#endif
+
+#ifdef USE_UART_DEBUG
+RING_BUFFER_DEFINE(g_debug_tx_ring_buffer, UART_DEBUG_TX_BUFFER_CAPACITY);
+#endif
+
+#ifdef USE_UART_UROS_TX
+RING_BUFFER_DEFINE(g_uros_tx_ring_buffer, UART_UROS_TX_BUFFER_CAPACITY);
+#endif
+
+#ifdef USE_UART_USART3
+RING_BUFFER_DEFINE_WITH_POLICY(g_usart3_rx_ring_buffer, UART_USART3_BUFFER_CAPACITY, RX_RING_POLICY(UART_USART3_RX_OVERFLOW_POLICY));
+RING_BUFFER_DEFINE(g_usart3_tx_ring_buffer, UART_USART3_TX_BUFFER_CAPACITY);
+#endif
+
+#ifdef USE_UART_UART4
+RING_BUFFER_DEFINE_WITH_POLICY(g_uart4_rx_ring_buffer, UART_UART4_BUFFER_CAPACITY, RX_RING_POLICY(UART_UART4_RX_OVERFLOW_POLICY));
+RING_BUFFER_DEFINE(g_uart4_tx_ring_buffer, UART_UART4_TX_BUFFER_CAPACITY);
+#endif
+
+#ifdef USE_UART_UART5
+RING_BUFFER_DEFINE_WITH_POLICY(g_uart5_rx_ring_buffer, UART_UART5_BUFFER_CAPACITY, RX_RING_POLICY(UART_UART5_RX_OVERFLOW_POLICY));
+RING_BUFFER_DEFINE(g_uart5_tx_ring_buffer, UART_UART5_TX_BUFFER_CAPACITY);
+#endif
+
+#ifdef USE_UART_USART6
+RING_BUFFER_DEFINE_WITH_POLICY(g_usart6_rx_ring_buffer, UART_USART6_BUFFER_CAPACITY, RX_RING_POLICY(UART_USART6_RX_OVERFLOW_POLICY));
+RING_BUFFER_DEFINE(g_usart6_tx_ring_buffer, UART_USART6_TX_BUFFER_CAPACITY);
+#endif
+
+/* clang-format off */
+static RingBuffer_Handle const g_rx_ring_buffer[eUartDriver_Last] = {
     #ifdef USE_UART_DEBUG
-    [eUartDriver_Debug] = NULL,
+    [eUartDriver_Debug] = &g_debug_rx_ring_buffer,
     #endif
 
     #ifdef USE_UART_UROS_TX
+    #ifdef USE_UART_UROS_RX
+    [eUartDriver_uRos] = &g_uros_rx_ring_buffer,
+    #else
     [eUartDriver_uRos] = NULL,
     #endif
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUartDriver_Usart3] = &g_usart3_rx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUartDriver_Uart4] = &g_uart4_rx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUartDriver_Uart5] = &g_uart5_rx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUartDriver_Usart6] = &g_usart6_rx_ring_buffer,
+    #endif
+};
+
+static RingBuffer_Handle const g_tx_ring_buffer[eUartDriver_Last] = {
+    #ifdef USE_UART_DEBUG
+    [eUartDriver_Debug] = &g_debug_tx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_UROS_TX
+    [eUartDriver_uRos] = &g_uros_tx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUartDriver_Usart3] = &g_usart3_tx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUartDriver_Uart4] = &g_uart4_tx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUartDriver_Uart5] = &g_uart5_tx_ring_buffer,
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUartDriver_Usart6] = &g_usart6_tx_ring_buffer,
+    #endif
 };
+/* clang-format on */
 
 /**********************************************************************************************************************
  * Private constants
@@ -57,13 +169,21 @@ const static sUartDesc_t g_static_uart_lut[eUartDriver_Last] = {
         .stop_bits = LL_USART_STOPBITS_1,
         .parity = LL_USART_PARITY_NONE,
         .direction = LL_USART_DIRECTION_TX_RX,
+        #ifdef UART_DEBUG_FLOW_CONTROL
+        .flow_control = LL_USART_HWCONTROL_CTS,
+        .rts_pin = eGpioPin_DebugRts,
+        #else
         .flow_control = LL_USART_HWCONTROL_NONE,
+        #endif
         .oversample = LL_USART_OVERSAMPLING_16,
         .clock = LL_APB1_GRP1_PERIPH_USART2,
         .enable_clock_fp = LL_APB1_GRP1_EnableClock,
         .nvic = USART2_IRQn,
-        .ring_buffer_capacity = UART_DEBUG_BUFFER_CAPACITY
-    }
+        .rx_overflow_policy = UART_DEBUG_RX_OVERFLOW_POLICY,
+        #ifdef UART_DEBUG_RX_DMA
+        .rx_dma_stream = eDmaDriver_UartDebugRx,
+        #endif
+    },
     #endif
 
     #ifdef USE_UART_UROS_TX
@@ -73,13 +193,94 @@ const static sUartDesc_t g_static_uart_lut[eUartDriver_Last] = {
         .data_bits = LL_USART_DATAWIDTH_8B,
         .stop_bits = LL_USART_STOPBITS_1,
         .parity = LL_USART_PARITY_NONE,
+        #ifdef USE_UART_UROS_RX
+        .direction = LL_USART_DIRECTION_TX_RX,
+        #else
         .direction = LL_USART_DIRECTION_TX,
+        #endif
+        #ifdef UART_UROS_FLOW_CONTROL
+        .flow_control = LL_USART_HWCONTROL_CTS,
+        .rts_pin = eGpioPin_uRosRts,
+        #else
         .flow_control = LL_USART_HWCONTROL_NONE,
+        #endif
         .oversample = LL_USART_OVERSAMPLING_16,
         .clock = LL_APB2_GRP1_PERIPH_USART1,
         .enable_clock_fp = LL_APB2_GRP1_EnableClock,
         .nvic = USART1_IRQn,
-    }
+        .rx_overflow_policy = UART_UROS_RX_OVERFLOW_POLICY,
+        #ifdef UART_UROS_RX_DMA
+        .rx_dma_stream = eDmaDriver_UartUrosRx,
+        #endif
+    },
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUartDriver_Usart3] = {
+        .periph = USART3,
+        .baud = 115200,
+        .data_bits = LL_USART_DATAWIDTH_8B,
+        .stop_bits = LL_USART_STOPBITS_1,
+        .parity = LL_USART_PARITY_NONE,
+        .direction = LL_USART_DIRECTION_TX_RX,
+        .flow_control = LL_USART_HWCONTROL_NONE,
+        .oversample = LL_USART_OVERSAMPLING_16,
+        .clock = LL_APB1_GRP1_PERIPH_USART3,
+        .enable_clock_fp = LL_APB1_GRP1_EnableClock,
+        .nvic = USART3_IRQn,
+        .rx_overflow_policy = UART_USART3_RX_OVERFLOW_POLICY,
+    },
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUartDriver_Uart4] = {
+        .periph = UART4,
+        .baud = 115200,
+        .data_bits = LL_USART_DATAWIDTH_8B,
+        .stop_bits = LL_USART_STOPBITS_1,
+        .parity = LL_USART_PARITY_NONE,
+        .direction = LL_USART_DIRECTION_TX_RX,
+        .flow_control = LL_USART_HWCONTROL_NONE,
+        .oversample = LL_USART_OVERSAMPLING_16,
+        .clock = LL_APB1_GRP1_PERIPH_UART4,
+        .enable_clock_fp = LL_APB1_GRP1_EnableClock,
+        .nvic = UART4_IRQn,
+        .rx_overflow_policy = UART_UART4_RX_OVERFLOW_POLICY,
+    },
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUartDriver_Uart5] = {
+        .periph = UART5,
+        .baud = 115200,
+        .data_bits = LL_USART_DATAWIDTH_8B,
+        .stop_bits = LL_USART_STOPBITS_1,
+        .parity = LL_USART_PARITY_NONE,
+        .direction = LL_USART_DIRECTION_TX_RX,
+        .flow_control = LL_USART_HWCONTROL_NONE,
+        .oversample = LL_USART_OVERSAMPLING_16,
+        .clock = LL_APB1_GRP1_PERIPH_UART5,
+        .enable_clock_fp = LL_APB1_GRP1_EnableClock,
+        .nvic = UART5_IRQn,
+        .rx_overflow_policy = UART_UART5_RX_OVERFLOW_POLICY,
+    },
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUartDriver_Usart6] = {
+        .periph = USART6,
+        .baud = 115200,
+        .data_bits = LL_USART_DATAWIDTH_8B,
+        .stop_bits = LL_USART_STOPBITS_1,
+        .parity = LL_USART_PARITY_NONE,
+        .direction = LL_USART_DIRECTION_TX_RX,
+        .flow_control = LL_USART_HWCONTROL_NONE,
+        .oversample = LL_USART_OVERSAMPLING_16,
+        .clock = LL_APB2_GRP1_PERIPH_USART6,
+        .enable_clock_fp = LL_APB2_GRP1_EnableClock,
+        .nvic = USART6_IRQn,
+        .rx_overflow_policy = UART_USART6_RX_OVERFLOW_POLICY,
+    },
     #endif
 };
 
@@ -90,7 +291,7 @@ const static uint32_t g_static_baudrate_lut[eUartBaudrate_Last] = {
     [eUartBaudrate_38400] = 38400,
     [eUartBaudrate_57600] = 57600,
     [eUartBaudrate_115200] = 115200,
-    [eUartBaudrate_230400] = 320400,
+    [eUartBaudrate_230400] = 230400,
     [eUartBaudrate_460800] = 460800,
     [eUartBaudrate_921600] = 921600
 };
@@ -100,6 +301,82 @@ const static uint32_t g_static_baudrate_lut[eUartBaudrate_Last] = {
  * Private variables
  *********************************************************************************************************************/
 
+/* clang-format off */
+static sUartDynamicDesc_t g_dynamic_uart_lut[eUartDriver_Last] = {
+    #ifdef USE_UART_DEBUG
+    [eUartDriver_Debug] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+
+    #ifdef USE_UART_UROS_TX
+    [eUartDriver_uRos] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+
+    #ifdef USE_UART_USART3
+    [eUartDriver_Usart3] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+
+    #ifdef USE_UART_UART4
+    [eUartDriver_Uart4] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+
+    #ifdef USE_UART_UART5
+    [eUartDriver_Uart5] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+
+    #ifdef USE_UART_USART6
+    [eUartDriver_Usart6] = {
+        .isr_callback = NULL,
+        .isr_callback_context = NULL,
+        .is_rx_paused = false,
+        .is_rts_released = false,
+        .tx_space_wanted = 0,
+        .rx_dma = {0},
+        .stats = {0}
+    },
+    #endif
+};
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
@@ -109,13 +386,182 @@ const static uint32_t g_static_baudrate_lut[eUartBaudrate_Last] = {
  *********************************************************************************************************************/
 
 static void UARTx_ISRHandler (const eUartDriver_t uart);
+static void UART_Driver_Notify (const eUartDriver_t uart, const eUartDriver_Flags_t flag);
+static bool UART_Driver_CountErrors (const eUartDriver_t uart);
+static void UART_Driver_RxStore (const eUartDriver_t uart);
+static void UART_Driver_RxResume (const eUartDriver_t uart);
+#ifdef USE_UART_FLOW_CONTROL
+static void UART_Driver_RtsRelease (const eUartDriver_t uart);
+static void UART_Driver_RtsAssert (const eUartDriver_t uart);
+#endif
+#ifdef USE_UART_RX_DMA
+static bool UART_Driver_RxDmaInit (const eUartDriver_t uart);
+static size_t UART_Driver_RxDmaPublish (const eUartDriver_t uart, const bool is_lap_complete);
+static void UART_Driver_RxDmaSync (const eUartDriver_t uart, const bool is_lap_complete);
+static size_t UART_Driver_RxDmaPoll (const eUartDriver_t uart);
+static void UART_Driver_RxDmaRestart (const eUartDriver_t uart);
+static void UART_Driver_RxDmaCallback (void *context, const eDmaDriver_Flags_t flag);
+#endif
 void USART1_IRQHandler (void);
 void USART2_IRQHandler (void);
+#ifdef USE_UART_USART3
+void USART3_IRQHandler (void);
+#endif
+#ifdef USE_UART_UART4
+void UART4_IRQHandler (void);
+#endif
+#ifdef USE_UART_UART5
+void UART5_IRQHandler (void);
+#endif
+#ifdef USE_UART_USART6
+void USART6_IRQHandler (void);
+#endif
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+static void UART_Driver_Notify (const eUartDriver_t uart, const eUartDriver_Flags_t flag) {
+    if (g_dynamic_uart_lut[uart].isr_callback == NULL) {
+        return;
+    }
+
+    g_dynamic_uart_lut[uart].isr_callback(g_dynamic_uart_lut[uart].isr_callback_context, flag);
+
+    return;
+}
+
+/* Has to run before the data register is read, the SR then DR read sequence clears the error flags */
+static bool UART_Driver_CountErrors (const eUartDriver_t uart) {
+    bool has_error = false;
+
+    if (LL_USART_IsActiveFlag_ORE(g_static_uart_lut[uart].periph)) {
+        g_dynamic_uart_lut[uart].stats.overrun_errors++;
+        has_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_FE(g_static_uart_lut[uart].periph)) {
+        g_dynamic_uart_lut[uart].stats.framing_errors++;
+        has_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_NE(g_static_uart_lut[uart].periph)) {
+        g_dynamic_uart_lut[uart].stats.noise_errors++;
+        has_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_PE(g_static_uart_lut[uart].periph)) {
+        g_dynamic_uart_lut[uart].stats.parity_errors++;
+        has_error = true;
+    }
+
+    return has_error;
+}
+
+static void UART_Driver_RxStore (const eUartDriver_t uart) {
+    /* The consumer drains the buffer completely before sleeping, so only the first byte has to wake it */
+    bool was_empty = Ring_Buffer_IsEmpty(g_rx_ring_buffer[uart]);
+
+    switch (g_static_uart_lut[uart].rx_overflow_policy) {
+        case eUartDriver_Overflow_DropOldest: {
+            bool is_overwritten = false;
+
+            Ring_Buffer_PushOverwrite(g_rx_ring_buffer[uart], LL_USART_ReceiveData8(g_static_uart_lut[uart].periph), &is_overwritten);
+
+            if (is_overwritten) {
+                g_dynamic_uart_lut[uart].stats.ring_overflows++;
+            }
+        } break;
+        case eUartDriver_Overflow_FlowControl: {
+            if (Ring_Buffer_IsFull(g_rx_ring_buffer[uart])) {
+                LL_USART_DisableIT_RXNE(g_static_uart_lut[uart].periph);
+                g_dynamic_uart_lut[uart].is_rx_paused = true;
+
+                return;
+            }
+
+            Ring_Buffer_Push(g_rx_ring_buffer[uart], LL_USART_ReceiveData8(g_static_uart_lut[uart].periph));
+        } break;
+        default: {
+            if (!Ring_Buffer_Push(g_rx_ring_buffer[uart], LL_USART_ReceiveData8(g_static_uart_lut[uart].periph))) {
+                g_dynamic_uart_lut[uart].stats.ring_overflows++;
+
+                return;
+            }
+        } break;
+    }
+
+    #ifdef USE_UART_FLOW_CONTROL
+    UART_Driver_RtsRelease(uart);
+    #endif
+
+    if (was_empty) {
+        UART_Driver_Notify(uart, eUartDriver_Flags_RxData);
+    }
+
+    return;
+}
+
+/* Called by the consumer after it made room in the ring */
+static void UART_Driver_RxResume (const eUartDriver_t uart) {
+    #ifdef USE_UART_FLOW_CONTROL
+    UART_Driver_RtsAssert(uart);
+    #endif
+
+    if (!g_dynamic_uart_lut[uart].is_rx_paused) {
+        return;
+    }
+
+    g_dynamic_uart_lut[uart].is_rx_paused = false;
+
+    /* CR1 is also modified from the ISR */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    LL_USART_EnableIT_RXNE(g_static_uart_lut[uart].periph);
+
+    __set_PRIMASK(primask);
+
+    return;
+}
+
+#ifdef USE_UART_FLOW_CONTROL
+/* Producer side, tells the sender to stop while the ring still has room for the bytes already in flight */
+static void UART_Driver_RtsRelease (const eUartDriver_t uart) {
+    if ((g_static_uart_lut[uart].rts_pin == eGpioPin_First) || g_dynamic_uart_lut[uart].is_rts_released) {
+        return;
+    }
+
+    if (!UART_Rx_Ring_IsAboveWatermark(g_rx_ring_buffer[uart], UART_RTS_HIGH_WATERMARK_PERCENT)) {
+        return;
+    }
+
+    GPIO_Driver_WritePin(g_static_uart_lut[uart].rts_pin, true);
+    g_dynamic_uart_lut[uart].is_rts_released = true;
+
+    return;
+}
+
+/* Consumer side, the ISR may release RTS at any time so the check and the write are done with interrupts masked */
+static void UART_Driver_RtsAssert (const eUartDriver_t uart) {
+    if ((g_static_uart_lut[uart].rts_pin == eGpioPin_First) || !g_dynamic_uart_lut[uart].is_rts_released) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (UART_Rx_Ring_IsBelowWatermark(g_rx_ring_buffer[uart], UART_RTS_LOW_WATERMARK_PERCENT)) {
+        GPIO_Driver_WritePin(g_static_uart_lut[uart].rts_pin, false);
+        g_dynamic_uart_lut[uart].is_rts_released = false;
+    }
+
+    __set_PRIMASK(primask);
+
+    return;
+}
+#endif
+
 static void UARTx_ISRHandler (const eUartDriver_t uart) {
     if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
         return;
@@ -125,32 +571,253 @@ static void UARTx_ISRHandler (const eUartDriver_t uart) {
         return;
     }
     
-    if (!LL_USART_IsActiveFlag_RXNE(g_static_uart_lut[uart].periph)) {
-        return;
+    if (LL_USART_IsEnabledIT_RXNE(g_static_uart_lut[uart].periph) && LL_USART_IsActiveFlag_RXNE(g_static_uart_lut[uart].periph)) {
+        UART_Driver_CountErrors(uart);
+        UART_Driver_RxStore(uart);
     }
+
+    #ifdef USE_UART_RX_DMA
+    /**
+     * With DMA reception errors raise EIE. Reading the data register here could take a byte from under the DMA,
+     * the DMA read after this status read clears the flags instead. EIE stays off until the next sync.
+     */
+    if (LL_USART_IsEnabledIT_ERROR(g_static_uart_lut[uart].periph) && UART_Driver_CountErrors(uart)) {
+        LL_USART_DisableIT_ERROR(g_static_uart_lut[uart].periph);
+    }
+    #endif
+
+    if (LL_USART_IsEnabledIT_TXE(g_static_uart_lut[uart].periph) && LL_USART_IsActiveFlag_TXE(g_static_uart_lut[uart].periph)) {
+        uint8_t data = 0;
+
+        if (Ring_Buffer_Pop(g_tx_ring_buffer[uart], &data)) {
+            LL_USART_TransmitData8(g_static_uart_lut[uart].periph, data);
+
+            size_t wanted = g_dynamic_uart_lut[uart].tx_space_wanted;
+
+            if ((wanted != 0) && (Ring_Buffer_GetFree(g_tx_ring_buffer[uart]) >= wanted)) {
+                g_dynamic_uart_lut[uart].tx_space_wanted = 0;
+
+                UART_Driver_Notify(uart, eUartDriver_Flags_TxSpace);
+            }
+        } else {
+            LL_USART_DisableIT_TXE(g_static_uart_lut[uart].periph);
+            LL_USART_EnableIT_TC(g_static_uart_lut[uart].periph);
+        }
+    }
+
+    if (LL_USART_IsEnabledIT_TC(g_static_uart_lut[uart].periph) && LL_USART_IsActiveFlag_TC(g_static_uart_lut[uart].periph)) {
+        LL_USART_DisableIT_TC(g_static_uart_lut[uart].periph);
+        LL_USART_ClearFlag_TC(g_static_uart_lut[uart].periph);
+
+        UART_Driver_Notify(uart, eUartDriver_Flags_TxComplete);
+    }
+
+    #ifdef USE_UART_RX_DMA
+    if (LL_USART_IsEnabledIT_IDLE(g_static_uart_lut[uart].periph) && LL_USART_IsActiveFlag_IDLE(g_static_uart_lut[uart].periph)) {
+        LL_USART_ClearFlag_IDLE(g_static_uart_lut[uart].periph);
+
+        UART_Driver_RxDmaSync(uart, false);
+    }
+    #endif
     
-    Ring_Buffer_Push(g_ring_buffer[uart], LL_USART_ReceiveData8(g_static_uart_lut[uart].periph));
-    
     return;
 }
 
+#ifdef USE_UART_RX_DMA
+static bool UART_Driver_RxDmaInit (const eUartDriver_t uart) {
+    const eDmaDriver_t stream = g_static_uart_lut[uart].rx_dma_stream;
+
+    /* The DMA writes straight into the ring buffer storage, the ring head is moved forward in UART_Driver_RxDmaSync */
+    sDmaInit_t dma_init = {
+        .stream = stream,
+        .periph_or_src_addr = (uint32_t*) LL_USART_DMA_GetRegAddr(g_static_uart_lut[uart].periph),
+        .mem_or_dest_addr = (uint32_t*) Ring_Buffer_GetStorage(g_rx_ring_buffer[uart]),
+        .data_buffer_size = Ring_Buffer_GetCapacity(g_rx_ring_buffer[uart]),
+        .isr_callback = UART_Driver_RxDmaCallback,
+        .isr_callback_context = (void*) (uintptr_t) uart
+    };
+
+    if (!DMA_Driver_Init(&dma_init)) {
+        return false;
+    }
+
+    if (!UART_Rx_Ring_DmaStart(&g_dynamic_uart_lut[uart].rx_dma, g_rx_ring_buffer[uart])) {
+        return false;
+    }
+
+    DMA_Driver_ClearAllFlags(stream);
+
+    LL_USART_EnableDMAReq_RX(g_static_uart_lut[uart].periph);
+
+    if (!DMA_Driver_EnableStream(stream)) {
+        return false;
+    }
+
+    LL_USART_EnableIT_IDLE(g_static_uart_lut[uart].periph);
+    LL_USART_EnableIT_ERROR(g_static_uart_lut[uart].periph);
+
+    return true;
+}
+
+/* Moves the ring head to the DMA write position, returns the number of bytes that became readable */
+static size_t UART_Driver_RxDmaPublish (const eUartDriver_t uart, const bool is_lap_complete) {
+    size_t remaining = 0;
+    bool is_overrun = false;
+
+    if (!DMA_Driver_GetDataLength(g_static_uart_lut[uart].rx_dma_stream, &remaining)) {
+        return 0;
+    }
+
+    size_t published = UART_Rx_Ring_DmaSync(&g_dynamic_uart_lut[uart].rx_dma, remaining, is_lap_complete, &is_overrun);
+
+    if (is_overrun) {
+        g_dynamic_uart_lut[uart].stats.ring_overflows++;
+    }
+
+    LL_USART_EnableIT_ERROR(g_static_uart_lut[uart].periph);
+
+    #ifdef USE_UART_FLOW_CONTROL
+    UART_Driver_RtsRelease(uart);
+    #endif
+
+    return published;
+}
+
+static void UART_Driver_RxDmaSync (const eUartDriver_t uart, const bool is_lap_complete) {
+    if (UART_Driver_RxDmaPublish(uart, is_lap_complete) > 0) {
+        UART_Driver_Notify(uart, eUartDriver_Flags_RxData);
+    }
+
+    return;
+}
+
+/* Thread side sync, the HT, TC and IDLE interrupts sync the same stream so they are masked meanwhile */
+static size_t UART_Driver_RxDmaPoll (const eUartDriver_t uart) {
+    if (g_static_uart_lut[uart].rx_dma_stream == eDmaDriver_First) {
+        return 0;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    size_t published = UART_Driver_RxDmaPublish(uart, false);
+
+    __set_PRIMASK(primask);
+
+    return published;
+}
+
+/* A transfer error disables the stream. It starts over at the first storage byte, so unread data is dropped */
+static void UART_Driver_RxDmaRestart (const eUartDriver_t uart) {
+    const eDmaDriver_t stream = g_static_uart_lut[uart].rx_dma_stream;
+
+    g_dynamic_uart_lut[uart].stats.dma_errors++;
+
+    DMA_Driver_DisableStream(stream);
+    DMA_Driver_ClearAllFlags(stream);
+
+    /* Reloads the start address and NDTR */
+    if (!DMA_Driver_ConfigureStream(stream, NULL, NULL, Ring_Buffer_GetCapacity(g_rx_ring_buffer[uart]))) {
+        return;
+    }
+
+    UART_Rx_Ring_DmaRestart(&g_dynamic_uart_lut[uart].rx_dma);
+
+    DMA_Driver_EnableStream(stream);
+
+    return;
+}
+
+static void UART_Driver_RxDmaCallback (void *context, const eDmaDriver_Flags_t flag) {
+    eUartDriver_t uart = (eUartDriver_t) (uintptr_t) context;
+
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return;
+    }
+
+    switch (flag) {
+        case eDmaDriver_Flags_HT: {
+            UART_Driver_RxDmaSync(uart, false);
+        } break;
+        case eDmaDriver_Flags_TC: {
+            UART_Driver_RxDmaSync(uart, true);
+        } break;
+        case eDmaDriver_Flags_TE: {
+            UART_Driver_RxDmaRestart(uart);
+        } break;
+        default: {
+        } break;
+    }
+
+    return;
+}
+#endif
+
 void USART1_IRQHandler (void) {
     #ifdef USE_UART_UROS_TX
+    RUN_TIME_ISR_ENTER();
+
     UARTx_ISRHandler(eUartDriver_uRos);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
     #endif
 }
 
 void USART2_IRQHandler (void) {
     #ifdef USE_UART_DEBUG
+    RUN_TIME_ISR_ENTER();
+
     UARTx_ISRHandler(eUartDriver_Debug);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
     #endif
 }
 
+#ifdef USE_UART_USART3
+void USART3_IRQHandler (void) {
+    RUN_TIME_ISR_ENTER();
+
+    UARTx_ISRHandler(eUartDriver_Usart3);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
+}
+#endif
+
+#ifdef USE_UART_UART4
+void UART4_IRQHandler (void) {
+    RUN_TIME_ISR_ENTER();
+
+    UARTx_ISRHandler(eUartDriver_Uart4);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
+}
+#endif
+
+#ifdef USE_UART_UART5
+void UART5_IRQHandler (void) {
+    RUN_TIME_ISR_ENTER();
+
+    UARTx_ISRHandler(eUartDriver_Uart5);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
+}
+#endif
+
+#ifdef USE_UART_USART6
+void USART6_IRQHandler (void) {
+    RUN_TIME_ISR_ENTER();
+
+    UARTx_ISRHandler(eUartDriver_Usart6);
+
+    RUN_TIME_ISR_EXIT(eRunTimeIsr_Uart);
+}
+#endif
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
-bool UART_Driver_Init (const eUartDriver_t uart, const eUartBaudrate_t baudrate) {
+bool UART_Driver_Init (const eUartDriver_t uart, const eUartBaudrate_t baudrate, void (*isr_callback) (void *isr_callback_context, const eUartDriver_Flags_t), void *isr_callback_context) {
     if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
         return false;
     }
@@ -177,24 +844,64 @@ bool UART_Driver_Init (const eUartDriver_t uart, const eUartBaudrate_t baudrate)
 
     LL_USART_ConfigAsyncMode(g_static_uart_lut[uart].periph);
 
+    g_dynamic_uart_lut[uart].isr_callback = isr_callback;
+    g_dynamic_uart_lut[uart].isr_callback_context = isr_callback_context;
+
+    /* The ISR callbacks may use RTOS calls, keep the priority within configMAX_SYSCALL_INTERRUPT_PRIORITY */
+    NVIC_SetPriority(g_static_uart_lut[uart].nvic, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 5, 0));
     NVIC_EnableIRQ(g_static_uart_lut[uart].nvic);
 
     if (g_static_uart_lut[uart].direction == LL_USART_DIRECTION_RX || g_static_uart_lut[uart].direction == LL_USART_DIRECTION_TX_RX) {
-        LL_USART_EnableIT_RXNE(g_static_uart_lut[uart].periph);
+        if (g_rx_ring_buffer[uart] == NULL) {
+            return false;
+        }
 
-        g_ring_buffer[uart] = Ring_Buffer_Init(g_static_uart_lut[uart].ring_buffer_capacity);
+        if (g_static_uart_lut[uart].rx_dma_stream != eDmaDriver_First) {
+            #ifdef USE_UART_RX_DMA
+            if (!UART_Driver_RxDmaInit(uart)) {
+                return false;
+            }
+            #endif
+        } else {
+            LL_USART_EnableIT_RXNE(g_static_uart_lut[uart].periph);
+        }
+    }
+
+    LL_USART_Enable(g_static_uart_lut[uart].periph);
+
+    return true;
+}
+
+bool UART_Driver_ReceiveByte (const eUartDriver_t uart, uint8_t *data) {
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return false;
+    }
 
-        if (g_ring_buffer[uart] == NULL) {
+    if (!LL_USART_IsEnabled(g_static_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    if (data == NULL) {
+        return false;
+    }
+
+    if (!Ring_Buffer_Pop(g_rx_ring_buffer[uart], data)) {
+        #ifdef USE_UART_RX_DMA
+        /* Bytes the DMA wrote since the last HT, TC or IDLE event are not published yet */
+        if ((UART_Driver_RxDmaPoll(uart) == 0) || !Ring_Buffer_Pop(g_rx_ring_buffer[uart], data)) {
             return false;
         }
+        #else
+        return false;
+        #endif
     }
 
-    LL_USART_Enable(g_static_uart_lut[uart].periph);
+    UART_Driver_RxResume(uart);
 
     return true;
 }
 
-bool UART_Driver_SendByte (const eUartDriver_t uart, const uint8_t data) {
+bool UART_Driver_ReceiveBytes (const eUartDriver_t uart, uint8_t *data, const size_t size, size_t *received) {
     if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
         return false;
     }
@@ -203,31 +910,47 @@ bool UART_Driver_SendByte (const eUartDriver_t uart, const uint8_t data) {
         return false;
     }
 
-    while (!LL_USART_IsActiveFlag_TXE(g_static_uart_lut[uart].periph)) {}
+    if ((data == NULL) || (size == 0) || (received == NULL)) {
+        return false;
+    }
+
+    *received = Ring_Buffer_PopBlock(g_rx_ring_buffer[uart], data, size);
+
+    #ifdef USE_UART_RX_DMA
+    if ((*received == 0) && (UART_Driver_RxDmaPoll(uart) > 0)) {
+        *received = Ring_Buffer_PopBlock(g_rx_ring_buffer[uart], data, size);
+    }
+    #endif
+
+    if (*received == 0) {
+        return false;
+    }
+
+    UART_Driver_RxResume(uart);
 
-    LL_USART_TransmitData8(g_static_uart_lut[uart].periph, data);
     return true;
 }
 
-bool UART_Driver_SendBytes (const eUartDriver_t uart, uint8_t *data, const size_t size) {
+/* With DMA reception the ring fill is otherwise only seen on HT, TC and IDLE, polling keeps RTS and the consumer current */
+bool UART_Driver_RxPoll (const eUartDriver_t uart) {
     if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
         return false;
     }
 
-    if ((data == NULL) || (size == 0)) {
+    if (!LL_USART_IsEnabled(g_static_uart_lut[uart].periph)) {
         return false;
     }
 
-    for (size_t i = 0; i < size; i++) {
-        if (!UART_Driver_SendByte(uart, data[i])) {
-            return false;
-        }
+    #ifdef USE_UART_RX_DMA
+    if (UART_Driver_RxDmaPoll(uart) > 0) {
+        UART_Driver_Notify(uart, eUartDriver_Flags_RxData);
     }
+    #endif
 
     return true;
 }
 
-bool UART_Driver_ReceiveByte (const eUartDriver_t uart, uint8_t *data) {
+bool UART_Driver_Write (const eUartDriver_t uart, const uint8_t *data, const size_t size, size_t *written) {
     if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
         return false;
     }
@@ -236,11 +959,94 @@ bool UART_Driver_ReceiveByte (const eUartDriver_t uart, uint8_t *data) {
         return false;
     }
 
-    if (data == NULL) {
+    if ((data == NULL) || (size == 0) || (written == NULL)) {
         return false;
     }
 
-    return Ring_Buffer_Pop(g_ring_buffer[uart], data);
+    *written = Ring_Buffer_PushBlock(g_tx_ring_buffer[uart], data, size);
+
+    if (*written == 0) {
+        return true;
+    }
+
+    /* CR1 is also modified from the ISR */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    LL_USART_EnableIT_TXE(g_static_uart_lut[uart].periph);
+
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+bool UART_Driver_GetTxCapacity (const eUartDriver_t uart, size_t *capacity) {
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return false;
+    }
+
+    if (capacity == NULL) {
+        return false;
+    }
+
+    *capacity = Ring_Buffer_GetCapacity(g_tx_ring_buffer[uart]);
+
+    return true;
+}
+
+/**
+ * Returns true when size bytes of the TX ring are free. Otherwise eUartDriver_Flags_TxSpace is raised once the ISR has
+ * drained that much, a request replaces the previous one. size can not exceed the ring capacity.
+ */
+bool UART_Driver_RequestTxSpace (const eUartDriver_t uart, const size_t size) {
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return false;
+    }
+
+    if ((size == 0) || (size > Ring_Buffer_GetCapacity(g_tx_ring_buffer[uart]))) {
+        return false;
+    }
+
+    /* Armed before the check, a pop between the two can not be missed, at worst the flag is raised needlessly */
+    g_dynamic_uart_lut[uart].tx_space_wanted = size;
+
+    if (Ring_Buffer_GetFree(g_tx_ring_buffer[uart]) < size) {
+        return false;
+    }
+
+    g_dynamic_uart_lut[uart].tx_space_wanted = 0;
+
+    return true;
+}
+
+bool UART_Driver_IsTxIdle (const eUartDriver_t uart) {
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return false;
+    }
+
+    if (!Ring_Buffer_IsEmpty(g_tx_ring_buffer[uart])) {
+        return false;
+    }
+
+    if (LL_USART_IsEnabledIT_TXE(g_static_uart_lut[uart].periph) || LL_USART_IsEnabledIT_TC(g_static_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    return true;
+}
+
+bool UART_Driver_GetStats (const eUartDriver_t uart, sUartDriver_Stats_t *stats) {
+    if ((uart <= eUartDriver_First) || (uart >= eUartDriver_Last)) {
+        return false;
+    }
+
+    if (stats == NULL) {
+        return false;
+    }
+
+    *stats = g_dynamic_uart_lut[uart].stats;
+
+    return true;
 }
 
 #endif
@@ -30,8 +30,55 @@ typedef enum eUartDriver {
     eUartDriver_uRos,
     #endif
 
+    #ifdef USE_UART_USART3
+    eUartDriver_Usart3,
+    #endif
+
+    #ifdef USE_UART_UART4
+    eUartDriver_Uart4,
+    #endif
+
+    #ifdef USE_UART_UART5
+    eUartDriver_Uart5,
+    #endif
+
+    #ifdef USE_UART_USART6
+    eUartDriver_Usart6,
+    #endif
+
     eUartDriver_Last
 } eUartDriver_t;
+
+typedef enum eUartDriver_Flags {
+    eUartDriver_Flags_First = 0,
+    eUartDriver_Flags_TxComplete = eUartDriver_Flags_First,
+    eUartDriver_Flags_RxData,
+    eUartDriver_Flags_TxSpace,
+    eUartDriver_Flags_Last
+} eUartDriver_Flags_t;
+
+/**
+ * What happens to a received byte when the RX ring is full.
+ * FlowControl leaves the byte in the data register and stops reading until there is room again,
+ * the next byte shows up as an overrun error unless RTS/CTS already held the sender off.
+ */
+typedef enum eUartDriver_Overflow {
+    eUartDriver_Overflow_First = 0,
+    eUartDriver_Overflow_DropNewest = eUartDriver_Overflow_First,
+    eUartDriver_Overflow_DropOldest,
+    eUartDriver_Overflow_FlowControl,
+    eUartDriver_Overflow_Last
+} eUartDriver_Overflow_t;
+
+/* ring_overflows counts dropped bytes in interrupt mode and overrun events with DMA reception, dma_errors counts stream restarts */
+typedef struct sUartDriver_Stats {
+    uint32_t overrun_errors;
+    uint32_t framing_errors;
+    uint32_t noise_errors;
+    uint32_t parity_errors;
+    uint32_t ring_overflows;
+    uint32_t dma_errors;
+} sUartDriver_Stats_t;
 /* clang-format on */
 
 /**********************************************************************************************************************
@@ -42,9 +89,14 @@ typedef enum eUartDriver {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-bool UART_Driver_Init (const eUartDriver_t uart, const eUartBaudrate_t baudrate);
-bool UART_Driver_SendByte (const eUartDriver_t uart, const uint8_t data);
-bool UART_Driver_SendBytes (const eUartDriver_t uart, uint8_t *data, const size_t size);
+bool UART_Driver_Init (const eUartDriver_t uart, const eUartBaudrate_t baudrate, void (*isr_callback) (void *isr_callback_context, const eUartDriver_Flags_t), void *isr_callback_context);
 bool UART_Driver_ReceiveByte (const eUartDriver_t uart, uint8_t *data);
+bool UART_Driver_ReceiveBytes (const eUartDriver_t uart, uint8_t *data, const size_t size, size_t *received);
+bool UART_Driver_RxPoll (const eUartDriver_t uart);
+bool UART_Driver_Write (const eUartDriver_t uart, const uint8_t *data, const size_t size, size_t *written);
+bool UART_Driver_GetTxCapacity (const eUartDriver_t uart, size_t *capacity);
+bool UART_Driver_RequestTxSpace (const eUartDriver_t uart, const size_t size);
+bool UART_Driver_IsTxIdle (const eUartDriver_t uart);
+bool UART_Driver_GetStats (const eUartDriver_t uart, sUartDriver_Stats_t *stats);
 
 #endif /* __UART_DRIVER__H__ */
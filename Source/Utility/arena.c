@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "arena.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define ARENA_ALIGN_UP(x) (((x) + (ARENA_ALIGNMENT - 1U)) & ~((size_t) ARENA_ALIGNMENT - 1U))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* The buffer must be aligned to ARENA_ALIGNMENT */
+bool Arena_Init (sArena_t *arena, uint8_t *buffer, const size_t size) {
+    if ((arena == NULL) || (buffer == NULL) || (size == 0)) {
+        return false;
+    }
+
+    if (((uintptr_t) buffer % ARENA_ALIGNMENT) != 0) {
+        return false;
+    }
+
+    arena->buffer = buffer;
+    arena->size = size;
+    arena->used = 0;
+
+    return true;
+}
+
+/* Bump allocation, single owner. Memory is not cleared and is only given back by Arena_Reset */
+void *Arena_Allocate (sArena_t *arena, const size_t size) {
+    if ((arena == NULL) || (arena->buffer == NULL) || (size == 0)) {
+        return NULL;
+    }
+
+    size_t offset = ARENA_ALIGN_UP(arena->used);
+
+    if ((offset > arena->size) || (size > (arena->size - offset))) {
+        return NULL;
+    }
+
+    arena->used = offset + size;
+
+    return &arena->buffer[offset];
+}
+
+void Arena_Reset (sArena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->used = 0;
+
+    return;
+}
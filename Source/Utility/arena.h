@@ -0,0 +1,41 @@
+#ifndef SOURCE_UTILITY_ARENA_H_
+#define SOURCE_UTILITY_ARENA_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#define ARENA_ALIGNMENT 8U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sArena {
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+} sArena_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool Arena_Init (sArena_t *arena, uint8_t *buffer, const size_t size);
+void *Arena_Allocate (sArena_t *arena, const size_t size);
+void Arena_Reset (sArena_t *arena);
+
+#endif /* SOURCE_UTILITY_ARENA_H_ */
@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "bitmap_pool.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Marks every slot free, must not race with Acquire or Release */
+bool Bitmap_Pool_Init (sBitmapPool_t *pool, const size_t slot_count) {
+    if (pool == NULL) {
+        return false;
+    }
+
+    if ((slot_count == 0) || (slot_count > BITMAP_POOL_MAX_SLOTS)) {
+        return false;
+    }
+
+    pool->slot_count = slot_count;
+
+    atomic_store_explicit(&pool->free, (uint_least32_t) ((1ULL << slot_count) - 1U), memory_order_release);
+
+    return true;
+}
+
+bool Bitmap_Pool_Acquire (sBitmapPool_t *pool, size_t *slot) {
+    if ((pool == NULL) || (slot == NULL)) {
+        return false;
+    }
+
+    uint_least32_t free_mask = atomic_load_explicit(&pool->free, memory_order_acquire);
+
+    while (free_mask != 0) {
+        uint32_t lowest = __builtin_ctz(free_mask);
+
+        if (!atomic_compare_exchange_weak_explicit(&pool->free, &free_mask, (free_mask & ~(1UL << lowest)), memory_order_acq_rel, memory_order_acquire)) {
+            continue;
+        }
+
+        *slot = lowest;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool Bitmap_Pool_Release (sBitmapPool_t *pool, const size_t slot) {
+    if (pool == NULL) {
+        return false;
+    }
+
+    if (slot >= pool->slot_count) {
+        return false;
+    }
+
+    uint_least32_t slot_mask = 1UL << slot;
+
+    if ((atomic_fetch_or_explicit(&pool->free, slot_mask, memory_order_acq_rel) & slot_mask) != 0) {
+        return false;
+    }
+
+    return true;
+}
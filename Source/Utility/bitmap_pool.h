@@ -0,0 +1,46 @@
+#ifndef SOURCE_UTILITY_BITMAP_POOL_H_
+#define SOURCE_UTILITY_BITMAP_POOL_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#define BITMAP_POOL_MAX_SLOTS 32U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**
+ * Lock free allocator of slot indexes, one bit per slot is set while the slot is free.
+ * Any thread can acquire and release, the caller maps the slot to its own storage.
+ */
+/* clang-format off */
+typedef struct sBitmapPool {
+    atomic_uint_least32_t free;
+    size_t slot_count;
+} sBitmapPool_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool Bitmap_Pool_Init (sBitmapPool_t *pool, const size_t slot_count);
+bool Bitmap_Pool_Acquire (sBitmapPool_t *pool, size_t *slot);
+/// Fails for a slot out of range and for a slot that is already free
+bool Bitmap_Pool_Release (sBitmapPool_t *pool, const size_t slot);
+
+#endif /* SOURCE_UTILITY_BITMAP_POOL_H_ */
@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "cobs.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define COBS_MAX_CODE 0xFFU
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/// Returns the encoded length (without the trailing delimiter) or 0 if the destination is too small
+size_t COBS_Encode (const uint8_t *source, const size_t length, uint8_t *destination, const size_t destination_size) {
+    if ((source == NULL) || (destination == NULL)) {
+        return 0;
+    }
+
+    if (destination_size < COBS_ENCODED_MAX_SIZE(length)) {
+        return 0;
+    }
+
+    size_t code_index = 0;
+    size_t write_index = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < length; i++) {
+        if (source[i] != COBS_DELIMITER) {
+            destination[write_index++] = source[i];
+            code++;
+        }
+
+        if ((source[i] == COBS_DELIMITER) || (code == COBS_MAX_CODE)) {
+            destination[code_index] = code;
+            code_index = write_index++;
+            code = 1;
+        }
+    }
+
+    destination[code_index] = code;
+
+    return write_index;
+}
+
+void COBS_Decoder_Reset (sCobsDecoder_t *decoder) {
+    if (decoder == NULL) {
+        return;
+    }
+
+    decoder->remaining = 0;
+    decoder->is_zero_pending = false;
+
+    return;
+}
+
+/**
+ * Decodes one byte of the stream. Returns eCobsDecode_Byte when *output holds a decoded byte,
+ * eCobsDecode_FrameEnd when the delimiter was received.
+ */
+eCobsDecode_t COBS_Decoder_Push (sCobsDecoder_t *decoder, const uint8_t input, uint8_t *output) {
+    if ((decoder == NULL) || (output == NULL)) {
+        return eCobsDecode_None;
+    }
+
+    if (input == COBS_DELIMITER) {
+        COBS_Decoder_Reset(decoder);
+
+        return eCobsDecode_FrameEnd;
+    }
+
+    if (decoder->remaining > 0) {
+        decoder->remaining--;
+        *output = input;
+
+        return eCobsDecode_Byte;
+    }
+
+    /* Code byte, the zero implied by the previous block is only emitted once the frame continues */
+    bool is_zero_pending = decoder->is_zero_pending;
+
+    decoder->remaining = input - 1;
+    decoder->is_zero_pending = (input != COBS_MAX_CODE);
+
+    if (!is_zero_pending) {
+        return eCobsDecode_None;
+    }
+
+    *output = 0x00U;
+
+    return eCobsDecode_Byte;
+}
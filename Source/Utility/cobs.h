@@ -0,0 +1,51 @@
+#ifndef SOURCE_UTILITY_COBS_H_
+#define SOURCE_UTILITY_COBS_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/// Worst case encoded size of a frame of n bytes, without the trailing 0x00 delimiter
+#define COBS_ENCODED_MAX_SIZE(n) ((n) + ((n) / 254U) + 1U)
+
+#define COBS_DELIMITER 0x00U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef enum eCobsDecode {
+    eCobsDecode_First = 0,
+    eCobsDecode_None = eCobsDecode_First,
+    eCobsDecode_Byte,
+    eCobsDecode_FrameEnd,
+    eCobsDecode_Last
+} eCobsDecode_t;
+
+typedef struct sCobsDecoder {
+    uint8_t remaining;
+    bool is_zero_pending;
+} sCobsDecoder_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+size_t COBS_Encode (const uint8_t *source, const size_t length, uint8_t *destination, const size_t destination_size);
+void COBS_Decoder_Reset (sCobsDecoder_t *decoder);
+eCobsDecode_t COBS_Decoder_Push (sCobsDecoder_t *decoder, const uint8_t input, uint8_t *output);
+
+#endif /* SOURCE_UTILITY_COBS_H_ */
@@ -0,0 +1,58 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "crc.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/* Nibble table, 32 bytes of flash instead of 512 for the byte table */
+/* clang-format off */
+static const uint16_t g_crc16_nibble_lut[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, const size_t length) {
+    if (data == NULL) {
+        return crc;
+    }
+
+    for (size_t position = 0; position < length; position++) {
+        crc = (uint16_t) ((crc << 4) ^ g_crc16_nibble_lut[((crc >> 12) ^ (data[position] >> 4)) & 0x0FU]);
+        crc = (uint16_t) ((crc << 4) ^ g_crc16_nibble_lut[((crc >> 12) ^ (data[position] & 0x0FU)) & 0x0FU]);
+    }
+
+    return crc;
+}
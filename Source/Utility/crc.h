@@ -0,0 +1,31 @@
+#ifndef SOURCE_UTILITY_CRC_H_
+#define SOURCE_UTILITY_CRC_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#define CRC16_INITIAL_VALUE 0xFFFFU
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+/// CRC-16/CCITT-FALSE (polynomial 0x1021), pass CRC16_INITIAL_VALUE or the result of the previous block as crc
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, const size_t length);
+
+#endif /* SOURCE_UTILITY_CRC_H_ */
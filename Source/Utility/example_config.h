@@ -18,9 +18,14 @@
 /// -- UART / Debug console
 #define USE_UART_DEBUG                            // Enable debug UART interface
 #define USE_UART_UROS_TX                          // Enable uROS UART transport
+//#define USE_UART_USART3                         // Enable USART3 link (TX PC10, RX PC11), not on STM32F401/F411
+//#define USE_UART_UART4                          // Enable UART4 link (TX PA0, RX PA1), not on STM32F401/F411
+//#define USE_UART_UART5                          // Enable UART5 link (TX PC12, RX PD2), not on STM32F401/F411
+//#define USE_UART_USART6                         // Enable USART6 link (TX PC6, RX PC7)
 
 /// -- DEBUG
 #define ENABLE_DEBUG                              // Enable debug messages
+//#define ENABLE_DEBUG_DEFERRED                   // Queue binary trace records, decode them on the host with Tools/trace_decoder.py
 
 /// -- I²C bus
 #define USE_I2C1                                  // Enable I2C1 peripheral
@@ -31,6 +36,7 @@
 /// -- CLI
 #define ENABLE_CLI                                // Enable Command Line Interface (CLI) support
 #define INCLUDE_PROJECT_CLI                       // Include custom CLI commands from project_cli_lut.h
+//#define ENABLE_CLI_RPC                          // Binary request/response mode on the debug UART (CLI command rpc, Tools/cli_rpc.py)
 
 /// -- LEDs
 #define USE_ONBOARD_LED                           // Enable on-board LED
@@ -55,6 +61,9 @@
 #define USE_MOTOR_A                               // Enable Motor A
 #define USE_MOTOR_B                               // Enable Motor B
 
+/// -- RTOS
+//#define USE_STATIC_RTOS_OBJECTS                 // Framework owned control blocks, stacks and queues (needs configSUPPORT_STATIC_ALLOCATION)
+
 //==============================================================================
 // SYSTEM TIMING
 //------------------------------------------------------------------------------
@@ -66,16 +75,111 @@
 // UART CONFIGURATION
 //------------------------------------------------------------------------------
 
-#if defined(USE_UART_DEBUG) || defined(USE_UART_UROS_TX)
+#if defined(USE_UART_DEBUG) || defined(USE_UART_UROS_TX) || defined(USE_UART_USART3) || defined(USE_UART_UART4) || defined(USE_UART_UART5) || defined(USE_UART_USART6)
 #define USE_UART
 #endif
 
 #ifdef USE_UART_DEBUG
+/// RX buffer size (bytes), must be a power of two
 #define UART_DEBUG_BUFFER_CAPACITY 256
+/// TX queue size (bytes), must be a power of two
+#define UART_DEBUG_TX_BUFFER_CAPACITY 512
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_DEBUG_FRAMING eUartFraming_Delimiter
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_DEBUG_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl), DMA reception always drops the oldest data
+#define UART_DEBUG_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+/// Receive through circular DMA with idle-line detection instead of an interrupt per byte
+#define UART_DEBUG_RX_DMA
+/// RTS/CTS flow control (CTS on PA0, RTS on PA1), the pins are shared with the WS2812B strips
+//#define UART_DEBUG_FLOW_CONTROL
 #endif
 
 #ifdef USE_UART_UROS_TX
+/// RX buffer size (bytes), must be a power of two
 #define UART_UROS_BUFFER_CAPACITY 64
+/// TX queue size (bytes), must be a power of two
+#define UART_UROS_TX_BUFFER_CAPACITY 256
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_UROS_FRAMING eUartFraming_Cobs
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_UROS_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl), DMA reception always drops the oldest data
+#define UART_UROS_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+/// Enable uROS reception (RX on PA10)
+//#define USE_UART_UROS_RX
+#ifdef USE_UART_UROS_RX
+#define UART_UROS_RX_DMA
+#endif
+/// RTS/CTS flow control (CTS on PA11, RTS on PA12), requires USE_UART_UROS_RX
+//#define UART_UROS_FLOW_CONTROL
+#endif
+
+#ifdef USE_UART_USART3
+/// RX buffer size (bytes), must be a power of two
+#define UART_USART3_BUFFER_CAPACITY 128
+/// TX queue size (bytes), must be a power of two
+#define UART_USART3_TX_BUFFER_CAPACITY 128
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_USART3_FRAMING eUartFraming_Delimiter
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_USART3_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl)
+#define UART_USART3_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+
+#ifdef USE_UART_UART4
+/// RX buffer size (bytes), must be a power of two
+#define UART_UART4_BUFFER_CAPACITY 128
+/// TX queue size (bytes), must be a power of two
+#define UART_UART4_TX_BUFFER_CAPACITY 128
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_UART4_FRAMING eUartFraming_Delimiter
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_UART4_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl)
+#define UART_UART4_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+
+#ifdef USE_UART_UART5
+/// RX buffer size (bytes), must be a power of two
+#define UART_UART5_BUFFER_CAPACITY 128
+/// TX queue size (bytes), must be a power of two
+#define UART_UART5_TX_BUFFER_CAPACITY 128
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_UART5_FRAMING eUartFraming_Delimiter
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_UART5_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl)
+#define UART_UART5_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+
+#ifdef USE_UART_USART6
+/// RX buffer size (bytes), must be a power of two
+#define UART_USART6_BUFFER_CAPACITY 128
+/// TX queue size (bytes), must be a power of two
+#define UART_USART6_TX_BUFFER_CAPACITY 128
+/// RX message framing (eUartFraming_Delimiter, eUartFraming_LengthPrefix or eUartFraming_Cobs)
+#define UART_USART6_FRAMING eUartFraming_Delimiter
+/// Received messages that can be held at once, queued or loaned (max 32)
+#define UART_USART6_MESSAGE_POOL_SIZE 4
+/// Full RX ring policy (eUartDriver_Overflow_DropNewest, _DropOldest or _FlowControl)
+#define UART_USART6_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+
+#if defined(UART_DEBUG_RX_DMA) || defined(UART_UROS_RX_DMA)
+#define USE_UART_RX_DMA
+#endif
+
+#if defined(UART_DEBUG_FLOW_CONTROL) || defined(UART_UROS_FLOW_CONTROL)
+#define USE_UART_FLOW_CONTROL
+/// RTS is released at the high and asserted again at the low RX ring fill level (%)
+/// With DMA reception the fill level is also polled every UART_RTS_POLL_MS, the room above the high watermark has to
+/// hold the bytes of one poll period and the ones the sender has in flight
+#define UART_RTS_HIGH_WATERMARK_PERCENT 50
+#define UART_RTS_LOW_WATERMARK_PERCENT 25
+#define UART_RTS_POLL_MS 1
 #endif
 
 //==============================================================================
@@ -219,11 +323,104 @@
 #define DEFAULT_MOTOR_SPEED 60
 #endif
 
+//==============================================================================
+// DEBUG TRACE CONFIGURATION
+//------------------------------------------------------------------------------
+
+#ifdef ENABLE_DEBUG
+/// Traces below this level are compiled out (0 info, 1 warning, 2 error)
+#define DEBUG_LEVEL_FLOOR 0
+/// Runtime threshold of every module after boot, changed with the log_level command (3 mutes)
+#define DEBUG_LEVEL_DEFAULT 0
+/// Project modules that can get a level of their own with TRACE_REGISTER_MODULE, the others share the PROJECT level
+#define DEBUG_PROJECT_MODULE_COUNT 8
+#endif
+
+#ifdef ENABLE_DEBUG_DEFERRED
+/// Records waiting for the log thread, a full ring drops new records (power of two)
+#define DEBUG_DEFERRED_RECORD_COUNT 32
+/// Raw argument bytes per record
+#define DEBUG_DEFERRED_PAYLOAD_SIZE 48
+/// Characters copied per %s argument
+#define DEBUG_DEFERRED_MAX_STRING 24
+#define DEBUG_DEFERRED_FLUSH_PERIOD_MS 10
+/// TRACE_ISR records, a full ring overwrites the oldest record (power of two)
+#define DEBUG_DEFERRED_ISR_RECORD_COUNT 32
+#endif
+
+//==============================================================================
+// HEAP CONFIGURATION
+//------------------------------------------------------------------------------
+
+/// Blocks per fixed size pool, tried before the general heap (0 disables the size class, max 65535)
+#define HEAP_POOL_16_BLOCKS 32
+#define HEAP_POOL_32_BLOCKS 16
+#define HEAP_POOL_64_BLOCKS 8
+#define HEAP_POOL_128_BLOCKS 4
+#define HEAP_POOL_256_BLOCKS 2
+/// Record size and call site of every allocation, for leak hunting (costs RAM and a lock per call)
+//#define ENABLE_HEAP_TRACKING
+#ifdef ENABLE_HEAP_TRACKING
+#define HEAP_TRACKING_MAX_ALLOCATIONS 64
+#define HEAP_TRACKING_MAX_CALL_SITES 32
+#endif
+
+//==============================================================================
+// SPAN TRACE CONFIGURATION
+//------------------------------------------------------------------------------
+
+/// Record SPAN_* timeline events, dump them with trace_dump and convert with Tools/span_to_chrome.py
+//#define ENABLE_SPAN_TRACE
+#ifdef ENABLE_SPAN_TRACE
+/// Newest events kept for the dump (power of two)
+#define SPAN_TRACE_EVENT_COUNT 256
+#endif
+
+//==============================================================================
+// STACK MONITOR CONFIGURATION
+//------------------------------------------------------------------------------
+
+/// Sample the stack high-water mark of every framework thread (needs INCLUDE_uxTaskGetStackHighWaterMark)
+//#define ENABLE_STACK_MONITOR
+#ifdef ENABLE_STACK_MONITOR
+#define STACK_MONITOR_MAX_THREADS 12
+#define STACK_MONITOR_PERIOD_MS 1000
+/// Warn on the trace output once less than this share of a stack was left (%)
+#define STACK_MONITOR_WARNING_PERCENT 10
+/// Headroom added to the observed peak when suggesting a stack size (%)
+#define STACK_MONITOR_MARGIN_PERCENT 25
+#endif
+
+//==============================================================================
+// RUN TIME STATS CONFIGURATION
+//------------------------------------------------------------------------------
+
+/**
+ * Per-thread CPU load, context switches and ISR time over a sliding window (CLI command top).
+ * FreeRTOSConfig.h has to route the kernel hooks to Utility/run_time_stats.h:
+ *   #define configUSE_TRACE_FACILITY 1
+ *   #define configGENERATE_RUN_TIME_STATS 1
+ *   #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() configureTimerForRunTimeStats()
+ *   #define portGET_RUN_TIME_COUNTER_VALUE() getRunTimeCounterValue()
+ *   #define traceTASK_SWITCHED_IN() Run_Time_Stats_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber)
+ */
+//#define ENABLE_RUN_TIME_STATS
+#ifdef ENABLE_RUN_TIME_STATS
+#define RUN_TIME_STATS_MAX_THREADS 16
+/// Run time counter ticks at SYSTEM_CLOCK_HZ >> shift, the counter wraps after 2^32 ticks
+#define RUN_TIME_STATS_COUNTER_SHIFT 4
+#define RUN_TIME_STATS_WINDOW_MS 2000
+/// The window slides in steps of RUN_TIME_STATS_WINDOW_MS / RUN_TIME_STATS_WINDOW_SLOTS
+#define RUN_TIME_STATS_WINDOW_SLOTS 4
+#endif
+
 //==============================================================================
 // CLI SETTINGS
 //------------------------------------------------------------------------------
 
 #define CLI_COMMAND_MESSAGE_CAPACITY 20
-#define RESPONSE_MESSAGE_CAPACITY 128
+#define RESPONSE_MESSAGE_CAPACITY 128             // Reply chunk, longer replies are sent as they fill it
+#define CLI_COMMAND_ARENA_COUNT 8                 // Commands that can wait in the APP queues at once (max 32)
+#define CLI_COMMAND_ARENA_SIZE 32                 // Bytes of task payload per command
 
 #endif /* FRAMEWORK_UTILITY_EXAMPLE_CONFIG_H_ */
@@ -12,10 +12,194 @@
 #include PROJECT_CONFIG_H
 #define SYSTEM_MS_TICS (SYSTEM_CLOCK_HZ / 1000)
 
+/* Defaults for settings a project config written before they existed does not define */
+#ifndef DEBUG_LEVEL_FLOOR
+#define DEBUG_LEVEL_FLOOR 0
+#endif
+#ifndef DEBUG_LEVEL_DEFAULT
+#define DEBUG_LEVEL_DEFAULT 0
+#endif
+#ifndef DEBUG_PROJECT_MODULE_COUNT
+#define DEBUG_PROJECT_MODULE_COUNT 8
+#endif
+
+#ifdef USE_UART_DEBUG
+#ifndef UART_DEBUG_TX_BUFFER_CAPACITY
+#define UART_DEBUG_TX_BUFFER_CAPACITY 512
+#endif
+#ifndef UART_DEBUG_FRAMING
+#define UART_DEBUG_FRAMING eUartFraming_Delimiter
+#endif
+#ifndef UART_DEBUG_MESSAGE_POOL_SIZE
+#define UART_DEBUG_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_DEBUG_RX_OVERFLOW_POLICY
+#define UART_DEBUG_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_UROS_TX
+#ifndef UART_UROS_TX_BUFFER_CAPACITY
+#define UART_UROS_TX_BUFFER_CAPACITY 256
+#endif
+#ifndef UART_UROS_FRAMING
+#define UART_UROS_FRAMING eUartFraming_Cobs
+#endif
+#ifndef UART_UROS_MESSAGE_POOL_SIZE
+#define UART_UROS_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_UROS_RX_OVERFLOW_POLICY
+#define UART_UROS_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_USART3
+#ifndef UART_USART3_TX_BUFFER_CAPACITY
+#define UART_USART3_TX_BUFFER_CAPACITY 128
+#endif
+#ifndef UART_USART3_FRAMING
+#define UART_USART3_FRAMING eUartFraming_Delimiter
+#endif
+#ifndef UART_USART3_MESSAGE_POOL_SIZE
+#define UART_USART3_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_USART3_RX_OVERFLOW_POLICY
+#define UART_USART3_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_UART4
+#ifndef UART_UART4_TX_BUFFER_CAPACITY
+#define UART_UART4_TX_BUFFER_CAPACITY 128
+#endif
+#ifndef UART_UART4_FRAMING
+#define UART_UART4_FRAMING eUartFraming_Delimiter
+#endif
+#ifndef UART_UART4_MESSAGE_POOL_SIZE
+#define UART_UART4_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_UART4_RX_OVERFLOW_POLICY
+#define UART_UART4_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_UART5
+#ifndef UART_UART5_TX_BUFFER_CAPACITY
+#define UART_UART5_TX_BUFFER_CAPACITY 128
+#endif
+#ifndef UART_UART5_FRAMING
+#define UART_UART5_FRAMING eUartFraming_Delimiter
+#endif
+#ifndef UART_UART5_MESSAGE_POOL_SIZE
+#define UART_UART5_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_UART5_RX_OVERFLOW_POLICY
+#define UART_UART5_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_USART6
+#ifndef UART_USART6_TX_BUFFER_CAPACITY
+#define UART_USART6_TX_BUFFER_CAPACITY 128
+#endif
+#ifndef UART_USART6_FRAMING
+#define UART_USART6_FRAMING eUartFraming_Delimiter
+#endif
+#ifndef UART_USART6_MESSAGE_POOL_SIZE
+#define UART_USART6_MESSAGE_POOL_SIZE 4
+#endif
+#ifndef UART_USART6_RX_OVERFLOW_POLICY
+#define UART_USART6_RX_OVERFLOW_POLICY eUartDriver_Overflow_DropNewest
+#endif
+#endif
+
+#ifdef USE_UART_FLOW_CONTROL
+#ifndef UART_RTS_POLL_MS
+#define UART_RTS_POLL_MS 1
+#endif
+#endif
+
+#ifdef ENABLE_CLI
+#ifndef CLI_COMMAND_ARENA_COUNT
+#define CLI_COMMAND_ARENA_COUNT 8
+#endif
+#ifndef CLI_COMMAND_ARENA_SIZE
+#define CLI_COMMAND_ARENA_SIZE 32
+#endif
+#endif
+
 #if defined(USE_MOTOR) && defined(USE_PWM_LED)
 #error "USE_MOTOR and USE_PWM_LED cannot be used together."
 #endif
 
+#if defined(USE_UART_RX_DMA) && !defined(USE_DMA)
+#error "UART RX DMA requires USE_DMA."
+#endif
+
+#if defined(UART_DEBUG_FLOW_CONTROL) && defined(USE_WS2812B)
+#error "UART_DEBUG_FLOW_CONTROL and USE_WS2812B cannot be used together."
+#endif
+
+#if defined(USE_UART_UART4) && (defined(USE_WS2812B) || defined(UART_DEBUG_FLOW_CONTROL))
+#error "USE_UART_UART4 shares PA0 and PA1 with USE_WS2812B and UART_DEBUG_FLOW_CONTROL."
+#endif
+
+#if defined(UART_UROS_FLOW_CONTROL) && !defined(USE_UART_UROS_RX)
+#error "UART_UROS_FLOW_CONTROL requires USE_UART_UROS_RX."
+#endif
+
+#if defined(ENABLE_DEBUG) && ((DEBUG_LEVEL_FLOOR < 0) || (DEBUG_LEVEL_FLOOR > 2))
+#error "DEBUG_LEVEL_FLOOR must be between 0 and 2."
+#endif
+
+#if defined(ENABLE_DEBUG) && ((DEBUG_LEVEL_DEFAULT < 0) || (DEBUG_LEVEL_DEFAULT > 3))
+#error "DEBUG_LEVEL_DEFAULT must be between 0 and 3."
+#endif
+
+#if defined(ENABLE_DEBUG_DEFERRED) && !defined(ENABLE_DEBUG)
+#error "ENABLE_DEBUG_DEFERRED requires ENABLE_DEBUG."
+#endif
+
+#if defined(ENABLE_DEBUG_DEFERRED) && ((DEBUG_DEFERRED_RECORD_COUNT & (DEBUG_DEFERRED_RECORD_COUNT - 1)) != 0)
+#error "DEBUG_DEFERRED_RECORD_COUNT must be a power of two."
+#endif
+
+#if defined(ENABLE_DEBUG_DEFERRED) && (DEBUG_DEFERRED_PAYLOAD_SIZE > 255)
+#error "DEBUG_DEFERRED_PAYLOAD_SIZE must fit in one byte."
+#endif
+
+#if defined(ENABLE_DEBUG_DEFERRED) && ((DEBUG_DEFERRED_ISR_RECORD_COUNT & (DEBUG_DEFERRED_ISR_RECORD_COUNT - 1)) != 0)
+#error "DEBUG_DEFERRED_ISR_RECORD_COUNT must be a power of two."
+#endif
+
+#if defined(ENABLE_SPAN_TRACE) && (!defined(ENABLE_DEBUG) || !defined(ENABLE_CLI))
+#error "ENABLE_SPAN_TRACE requires ENABLE_DEBUG and ENABLE_CLI."
+#endif
+
+#if defined(ENABLE_SPAN_TRACE) && ((SPAN_TRACE_EVENT_COUNT & (SPAN_TRACE_EVENT_COUNT - 1)) != 0)
+#error "SPAN_TRACE_EVENT_COUNT must be a power of two."
+#endif
+
+#if defined(ENABLE_RUN_TIME_STATS) && (!defined(ENABLE_DEBUG) || !defined(ENABLE_CLI))
+#error "ENABLE_RUN_TIME_STATS requires ENABLE_DEBUG and ENABLE_CLI."
+#endif
+
+#if defined(ENABLE_RUN_TIME_STATS) && ((RUN_TIME_STATS_WINDOW_SLOTS < 1) || ((RUN_TIME_STATS_WINDOW_MS / RUN_TIME_STATS_WINDOW_SLOTS) < 10))
+#error "RUN_TIME_STATS_WINDOW_SLOTS must be at least 1 with slots of at least 10 ms."
+#endif
+
+#if defined(ENABLE_RUN_TIME_STATS) && ((RUN_TIME_STATS_WINDOW_MS * (SYSTEM_CLOCK_HZ / 1000)) > 0xFFFFFFFF)
+#error "RUN_TIME_STATS_WINDOW_MS must be shorter than one wrap of the 32-bit cycle counter."
+#endif
+
+#if defined(ENABLE_CLI_RPC) && (!defined(ENABLE_CLI) || !defined(USE_UART_DEBUG))
+#error "ENABLE_CLI_RPC requires ENABLE_CLI and USE_UART_DEBUG."
+#endif
+
+#if defined(ENABLE_CLI) && ((CLI_COMMAND_ARENA_COUNT < 1) || (CLI_COMMAND_ARENA_COUNT > 32))
+#error "CLI_COMMAND_ARENA_COUNT must be between 1 and 32."
+#endif
+
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
@@ -4,23 +4,17 @@
 
 #include "ring_buffer.h"
 
+#include <string.h>
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
 
-/* clang-format off */
-struct sRingBufferDesc {
-    size_t buffer_capacity;
-    size_t head;
-    size_t tail;
-    size_t count;
-    uint8_t *buffer;
-};
-/* clang-format on */
 
 /**********************************************************************************************************************
  * Private constants
@@ -47,14 +41,27 @@ struct sRingBufferDesc {
  *********************************************************************************************************************/
 
 RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity) {
+    return Ring_Buffer_InitWithPolicy(buffer_capacity, eRingBufferPolicy_Reject);
+}
+
+RingBuffer_Handle Ring_Buffer_InitWithPolicy (size_t buffer_capacity, const eRingBufferPolicy_t policy) {
+    if (!RING_BUFFER_IS_POWER_OF_TWO(buffer_capacity)) {
+        return NULL;
+    }
+
+    if ((policy < eRingBufferPolicy_First) || (policy >= eRingBufferPolicy_Last)) {
+        return NULL;
+    }
+
     RingBuffer_Handle ring_buffer = malloc(sizeof(struct sRingBufferDesc));
 
     if (ring_buffer == NULL) {
-        free(ring_buffer);
         return NULL;
     }
 
     ring_buffer->buffer_capacity = buffer_capacity;
+    ring_buffer->mask = buffer_capacity - 1;
+    ring_buffer->policy = policy;
 
     ring_buffer->buffer = malloc(buffer_capacity);
 
@@ -63,9 +70,8 @@ RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity) {
         return NULL;
     }
 
-    ring_buffer->head = 0;
-    ring_buffer->tail = 0;
-    ring_buffer->count = 0;
+    atomic_init(&ring_buffer->head, 0);
+    atomic_init(&ring_buffer->tail, 0);
 
     return ring_buffer;
 }
@@ -87,7 +93,7 @@ bool Ring_Buffer_DeInit (RingBuffer_Handle ring_buffer) {
 
 bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer) {
     if (ring_buffer != NULL) {
-        return ring_buffer->count == ring_buffer->buffer_capacity;
+        return Ring_Buffer_GetCount(ring_buffer) == ring_buffer->buffer_capacity;
     }
 
     return false;
@@ -95,7 +101,7 @@ bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer) {
 
 bool Ring_Buffer_IsEmpty (RingBuffer_Handle ring_buffer) {
     if (ring_buffer != NULL) {
-        return ring_buffer->count == 0;
+        return Ring_Buffer_GetCount(ring_buffer) == 0;
     }
 
     return false;
@@ -105,22 +111,48 @@ bool Ring_Buffer_Push (RingBuffer_Handle ring_buffer, uint8_t data) {
     if (ring_buffer == NULL) {
         return false;
     }
-    
-    ring_buffer->buffer[ring_buffer->head] = data;
-    ring_buffer->head++;
 
-    if (ring_buffer->count < ring_buffer->buffer_capacity){
-        ring_buffer->count++;
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    if ((head - tail) == ring_buffer->buffer_capacity) {
+        return false;
+    }
+
+    ring_buffer->buffer[head & ring_buffer->mask] = data;
+
+    atomic_store_explicit(&ring_buffer->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+bool Ring_Buffer_PushOverwrite (RingBuffer_Handle ring_buffer, uint8_t data, bool *is_overwritten) {
+    if ((ring_buffer == NULL) || (is_overwritten == NULL)) {
+        return false;
     }
 
-    if (ring_buffer->head == (ring_buffer->buffer_capacity)) {
-        ring_buffer->head = 0;
+    if (ring_buffer->policy != eRingBufferPolicy_Overwrite) {
+        return false;
     }
 
-    if (Ring_Buffer_IsFull(ring_buffer)) {
-        ring_buffer->tail = ring_buffer->head;
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    *is_overwritten = false;
+
+    /* Tail has to move before the slot is written, a consumer reading that slot then fails its compare-and-swap and retries */
+    while ((head - tail) == ring_buffer->buffer_capacity) {
+        if (atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, tail + 1, memory_order_acq_rel, memory_order_acquire)) {
+            *is_overwritten = true;
+
+            break;
+        }
     }
-    
+
+    ring_buffer->buffer[head & ring_buffer->mask] = data;
+
+    atomic_store_explicit(&ring_buffer->head, head + 1, memory_order_release);
+
     return true;
 }
 
@@ -129,20 +161,240 @@ bool Ring_Buffer_Pop (RingBuffer_Handle ring_buffer, uint8_t *data) {
         return false;
     }
 
-    if (Ring_Buffer_IsEmpty(ring_buffer)) {
+    if (ring_buffer->policy == eRingBufferPolicy_Reject) {
+        size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+        if (head == tail) {
+            return false;
+        }
+
+        *data = ring_buffer->buffer[tail & ring_buffer->mask];
+
+        atomic_store_explicit(&ring_buffer->tail, tail + 1, memory_order_release);
+
+        return true;
+    }
+
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    uint8_t value = 0;
+
+    do {
+        size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+        if (head == tail) {
+            return false;
+        }
+
+        value = ring_buffer->buffer[tail & ring_buffer->mask];
+    } while (!atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, tail + 1, memory_order_acq_rel, memory_order_acquire));
+
+    *data = value;
+
+    return true;
+}
+
+size_t Ring_Buffer_PushBlock (RingBuffer_Handle ring_buffer, const uint8_t *data, const size_t size) {
+    if ((ring_buffer == NULL) || (data == NULL) || (size == 0)) {
+        return 0;
+    }
+
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    size_t free_space = ring_buffer->buffer_capacity - (head - tail);
+    size_t length = (size < free_space) ? size : free_space;
+
+    if (length == 0) {
+        return 0;
+    }
+
+    size_t index = head & ring_buffer->mask;
+    size_t first_span = ring_buffer->buffer_capacity - index;
+
+    if (first_span > length) {
+        first_span = length;
+    }
+
+    memcpy(&ring_buffer->buffer[index], data, first_span);
+    memcpy(ring_buffer->buffer, &data[first_span], length - first_span);
+
+    atomic_store_explicit(&ring_buffer->head, head + length, memory_order_release);
+
+    return length;
+}
+
+size_t Ring_Buffer_PopBlock (RingBuffer_Handle ring_buffer, uint8_t *data, const size_t size) {
+    if ((ring_buffer == NULL) || (data == NULL) || (size == 0)) {
+        return 0;
+    }
+
+    if (ring_buffer->policy == eRingBufferPolicy_Reject) {
+        size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+        size_t count = head - tail;
+        size_t length = (size < count) ? size : count;
+
+        if (length == 0) {
+            return 0;
+        }
+
+        size_t index = tail & ring_buffer->mask;
+        size_t first_span = ring_buffer->buffer_capacity - index;
+
+        if (first_span > length) {
+            first_span = length;
+        }
+
+        memcpy(data, &ring_buffer->buffer[index], first_span);
+        memcpy(&data[first_span], ring_buffer->buffer, length - first_span);
+
+        atomic_store_explicit(&ring_buffer->tail, tail + length, memory_order_release);
+
+        return length;
+    }
+
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    while (true) {
+        size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+        size_t count = head - tail;
+
+        /* Ring_Buffer_SyncHead moved head and tail past an overrun in between the two loads */
+        if (count > ring_buffer->buffer_capacity) {
+            tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+            continue;
+        }
+
+        size_t length = (size < count) ? size : count;
+
+        if (length == 0) {
+            return 0;
+        }
+
+        size_t index = tail & ring_buffer->mask;
+        size_t first_span = ring_buffer->buffer_capacity - index;
+
+        if (first_span > length) {
+            first_span = length;
+        }
+
+        memcpy(data, &ring_buffer->buffer[index], first_span);
+        memcpy(&data[first_span], ring_buffer->buffer, length - first_span);
+
+        if (atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, tail + length, memory_order_acq_rel, memory_order_acquire)) {
+            return length;
+        }
+    }
+}
+
+size_t Ring_Buffer_GetCount (RingBuffer_Handle ring_buffer) {
+    if (ring_buffer == NULL) {
+        return 0;
+    }
+
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+size_t Ring_Buffer_GetFree (RingBuffer_Handle ring_buffer) {
+    if (ring_buffer == NULL) {
+        return 0;
+    }
+
+    return ring_buffer->buffer_capacity - Ring_Buffer_GetCount(ring_buffer);
+}
+
+size_t Ring_Buffer_GetCapacity (RingBuffer_Handle ring_buffer) {
+    if (ring_buffer == NULL) {
+        return 0;
+    }
+
+    return ring_buffer->buffer_capacity;
+}
+
+uint8_t *Ring_Buffer_GetStorage (RingBuffer_Handle ring_buffer) {
+    if (ring_buffer == NULL) {
+        return NULL;
+    }
+
+    return ring_buffer->buffer;
+}
+
+/**
+ * For producers that write the storage directly (e.g. circular DMA). Publishes everything up to write_count, the
+ * producer's free running byte count, so a full lap of the storage is not mistaken for no data. A count behind the
+ * head is ignored. Returns false if the producer has overrun unread data: the tail then moves to the oldest byte
+ * still in the storage and only the overwritten bytes are lost.
+ * Must not be preempted by the consumer, e.g. call it from an ISR or with interrupts masked. The ring must have been
+ * created with eRingBufferPolicy_Overwrite.
+ */
+bool Ring_Buffer_SyncHead (RingBuffer_Handle ring_buffer, const size_t write_count, size_t *published) {
+    if ((ring_buffer == NULL) || (published == NULL)) {
         return false;
     }
 
-    *data = ring_buffer->buffer[ring_buffer->tail];
-    ring_buffer->tail++;
+    *published = 0;
 
-    if (ring_buffer->count > 0){
-        ring_buffer->count--;
+    if (ring_buffer->policy != eRingBufferPolicy_Overwrite) {
+        return false;
     }
 
-    if (ring_buffer->tail == (ring_buffer->buffer_capacity)) {
-        ring_buffer->tail = 0;
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t written = write_count - head;
+
+    if ((written == 0) || (written > (SIZE_MAX / 2))) {
+        return true;
     }
 
-    return true;
+    *published = (written < ring_buffer->buffer_capacity) ? written : ring_buffer->buffer_capacity;
+
+    atomic_store_explicit(&ring_buffer->head, write_count, memory_order_release);
+
+    bool is_overrun = false;
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    /* A consumer reading the overwritten bytes fails its compare-and-swap and retries */
+    while ((write_count - tail) > ring_buffer->buffer_capacity) {
+        if (atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, write_count - ring_buffer->buffer_capacity, memory_order_acq_rel, memory_order_acquire)) {
+            is_overrun = true;
+
+            break;
+        }
+    }
+
+    return !is_overrun;
+}
+
+/**
+ * For direct producers that start over at the first byte of the storage (e.g. a restarted DMA stream).
+ * Unread data is dropped and head and tail move to the start of the next lap, which is returned as the write count
+ * of storage index 0. Same calling context and ring policy as Ring_Buffer_SyncHead.
+ */
+size_t Ring_Buffer_ResyncHead (RingBuffer_Handle ring_buffer, size_t *dropped) {
+    if ((ring_buffer == NULL) || (dropped == NULL)) {
+        return 0;
+    }
+
+    *dropped = 0;
+
+    if (ring_buffer->policy != eRingBufferPolicy_Overwrite) {
+        return 0;
+    }
+
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t lap = (head + ring_buffer->mask) & ~ring_buffer->mask;
+
+    atomic_store_explicit(&ring_buffer->head, lap, memory_order_release);
+
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    do {
+        *dropped = head - tail;
+    } while (!atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, lap, memory_order_acq_rel, memory_order_acquire));
+
+    return lap;
 }
@@ -8,15 +8,80 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+#define RING_BUFFER_IS_POWER_OF_TWO(x) (((x) != 0) && (((x) & ((x) - 1)) == 0))
+
+/**
+ * Defines a ring buffer with static storage, no heap is used. The handle is `&name`.
+ *
+ * Example:
+ *     RING_BUFFER_DEFINE(g_rx_ring_buffer, 256);
+ *     Ring_Buffer_Push(&g_rx_ring_buffer, data);
+ */
+#define RING_BUFFER_DEFINE(name, capacity) RING_BUFFER_DEFINE_WITH_POLICY(name, capacity, eRingBufferPolicy_Reject)
+
+/* Same as RING_BUFFER_DEFINE, for a ring the producer may overwrite (see eRingBufferPolicy_t) */
+#define RING_BUFFER_DEFINE_WITH_POLICY(name, capacity, ring_policy) \
+    _Static_assert(RING_BUFFER_IS_POWER_OF_TWO(capacity), #name " capacity must be a power of two"); \
+    static uint8_t name##_storage[(capacity)]; \
+    static struct sRingBufferDesc name = { \
+        .buffer_capacity = (capacity), \
+        .mask = (capacity) - 1, \
+        .policy = (ring_policy), \
+        .head = 0, \
+        .tail = 0, \
+        .buffer = name##_storage \
+    }
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+/**
+ * What the producer may do when the ring is full, fixed when the ring is created.
+ * eRingBufferPolicy_Reject: plain single-producer/single-consumer ring, Push fails when the buffer is full.
+ * eRingBufferPolicy_Overwrite: PushOverwrite, Ring_Buffer_SyncHead and Ring_Buffer_ResyncHead may also move the tail
+ * to drop the oldest data. The consumer then pops with compare-and-swap, which costs more per call.
+ */
+typedef enum eRingBufferPolicy {
+    eRingBufferPolicy_First = 0,
+    eRingBufferPolicy_Reject = eRingBufferPolicy_First,
+    eRingBufferPolicy_Overwrite,
+    eRingBufferPolicy_Last
+} eRingBufferPolicy_t;
+
+/**
+ * Single-producer/single-consumer ring buffer.
+ *
+ * One context may push (e.g. the UART ISR) while another pops (e.g. the UART FSM thread) without locking.
+ * Capacity must be a power of two. Push does not overwrite; it fails when the buffer is full.
+ * PushOverwrite drops the oldest byte instead, it may be used from the producer while the consumer pops, but only on a
+ * ring created with eRingBufferPolicy_Overwrite.
+ */
+/* 
+ * head and tail are free running counters, only the producer writes head.
+ * With eRingBufferPolicy_Reject only the consumer writes tail, with a plain release store.
+ * With eRingBufferPolicy_Overwrite the consumer moves tail with compare-and-swap, so the producer can also move it
+ * forward to drop the oldest byte.
+ * The fill level is (head - tail), the index into the storage is (counter & mask).
+ * Fields are private, the struct is only exposed so RING_BUFFER_DEFINE can place it in static memory.
+ */
+/* clang-format off */
+struct sRingBufferDesc {
+    size_t buffer_capacity;
+    size_t mask;
+    eRingBufferPolicy_t policy;
+    atomic_size_t head;
+    atomic_size_t tail;
+    uint8_t *buffer;
+};
+/* clang-format on */
+
 typedef struct sRingBufferDesc *RingBuffer_Handle;
 
 /**********************************************************************************************************************
@@ -28,10 +93,20 @@ typedef struct sRingBufferDesc *RingBuffer_Handle;
  *********************************************************************************************************************/
 
 RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity);
+RingBuffer_Handle Ring_Buffer_InitWithPolicy (size_t buffer_capacity, const eRingBufferPolicy_t policy);
 bool Ring_Buffer_DeInit (RingBuffer_Handle ring_buffer);
 bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer);
 bool Ring_Buffer_IsEmpty (RingBuffer_Handle ring_buffer);
 bool Ring_Buffer_Push (RingBuffer_Handle ring_buffer, uint8_t data);
+bool Ring_Buffer_PushOverwrite (RingBuffer_Handle ring_buffer, uint8_t data, bool *is_overwritten);
 bool Ring_Buffer_Pop (RingBuffer_Handle ring_buffer, uint8_t *data);
+size_t Ring_Buffer_PushBlock (RingBuffer_Handle ring_buffer, const uint8_t *data, const size_t size);
+size_t Ring_Buffer_PopBlock (RingBuffer_Handle ring_buffer, uint8_t *data, const size_t size);
+size_t Ring_Buffer_GetCount (RingBuffer_Handle ring_buffer);
+size_t Ring_Buffer_GetFree (RingBuffer_Handle ring_buffer);
+size_t Ring_Buffer_GetCapacity (RingBuffer_Handle ring_buffer);
+uint8_t *Ring_Buffer_GetStorage (RingBuffer_Handle ring_buffer);
+bool Ring_Buffer_SyncHead (RingBuffer_Handle ring_buffer, const size_t write_count, size_t *published);
+size_t Ring_Buffer_ResyncHead (RingBuffer_Handle ring_buffer, size_t *dropped);
 
 #endif /* SOURCE_DRIVER_RING_BUFFER_H_ */
@@ -0,0 +1,55 @@
+#ifndef SOURCE_UTILITY_RTOS_STATIC_H_
+#define SOURCE_UTILITY_RTOS_STATIC_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "framework_config.h"
+
+#ifdef USE_STATIC_RTOS_OBJECTS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#endif
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**
+ * Fill cb_mem/cb_size, stack_mem/stack_size and mq_mem/mq_size of the CMSIS-RTOS2 attributes.
+ * Without USE_STATIC_RTOS_OBJECTS the storage is not referenced and the RTOS heap is used.
+ */
+#ifdef USE_STATIC_RTOS_OBJECTS
+#if (configSUPPORT_STATIC_ALLOCATION != 1)
+#error "USE_STATIC_RTOS_OBJECTS requires configSUPPORT_STATIC_ALLOCATION set to 1 in FreeRTOSConfig.h."
+#endif
+
+#define RTOS_STATIC_MEM(storage) ((void*) &(storage))
+#define RTOS_STATIC_SIZE(storage) sizeof(storage)
+#else
+#define RTOS_STATIC_MEM(storage) NULL
+#define RTOS_STATIC_SIZE(storage) 0U
+#endif
+
+/// Thread stacks must be 8 byte aligned
+#define RTOS_STACK_LENGTH(stack_size) ((stack_size) / sizeof(uint64_t))
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+#endif /* SOURCE_UTILITY_RTOS_STATIC_H_ */
@@ -0,0 +1,157 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "run_time_stats.h"
+
+#ifdef ENABLE_RUN_TIME_STATS
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#ifdef __linux__
+#include <time.h>
+#else
+#include "dwt_driver.h"
+#endif
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sRunTimeIsr {
+    atomic_uint_least32_t cycles;
+    atomic_uint_least32_t count;
+} sRunTimeIsr_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/* clang-format off */
+static const char *g_run_time_isr_name_lut[eRunTimeIsr_Last] = {
+    [eRunTimeIsr_Uart] = "uart",
+    [eRunTimeIsr_Dma] = "dma",
+    [eRunTimeIsr_I2c] = "i2c"
+};
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static sRunTimeIsr_t g_run_time_isr[eRunTimeIsr_Last] = {0};
+static atomic_uint_least32_t g_run_time_switches[RUN_TIME_STATS_MAX_THREADS] = {0};
+
+static uint32_t g_run_time_last_cycles = 0;
+static uint32_t g_run_time_wraps = 0;
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Called by the kernel through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS when the scheduler starts */
+void configureTimerForRunTimeStats (void) {
+    #ifndef __linux__
+    DWT_Driver_Init();
+    #endif
+
+    g_run_time_last_cycles = Run_Time_Stats_GetCycles();
+    g_run_time_wraps = 0;
+
+    return;
+}
+
+/**
+ * Called by the kernel on every context switch with interrupts masked. The 32-bit cycle counter is extended by
+ * counting its wraps, so a switch has to happen at least once per wrap period (the CPU_API sampler guarantees that).
+ */
+unsigned long getRunTimeCounterValue (void) {
+    uint32_t cycles = Run_Time_Stats_GetCycles();
+
+    if (cycles < g_run_time_last_cycles) {
+        g_run_time_wraps++;
+    }
+
+    g_run_time_last_cycles = cycles;
+
+    uint64_t total = ((uint64_t) g_run_time_wraps << 32) | cycles;
+
+    return (unsigned long) (uint32_t) (total >> RUN_TIME_STATS_COUNTER_SHIFT);
+}
+
+/* Core clock cycles, on a Linux host the monotonic clock scaled to SYSTEM_CLOCK_HZ */
+uint32_t Run_Time_Stats_GetCycles (void) {
+    #ifdef __linux__
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint64_t nanoseconds = ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+
+    return (uint32_t) ((nanoseconds * (SYSTEM_CLOCK_HZ / 1000000UL)) / 1000ULL);
+    #else
+    return DWT_Driver_GetCycles();
+    #endif
+}
+
+/* A nested interrupt is accounted to both the preempted and the preempting source */
+void Run_Time_Stats_IsrExit (const eRunTimeIsr_t source, const uint32_t start) {
+    if ((source < eRunTimeIsr_First) || (source >= eRunTimeIsr_Last)) {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&g_run_time_isr[source].cycles, Run_Time_Stats_GetCycles() - start, memory_order_relaxed);
+    atomic_fetch_add_explicit(&g_run_time_isr[source].count, 1, memory_order_relaxed);
+
+    return;
+}
+
+/* Called through traceTASK_SWITCHED_IN, task numbers beyond RUN_TIME_STATS_MAX_THREADS share a counter */
+void Run_Time_Stats_TaskSwitchedIn (const uint32_t task_number) {
+    atomic_fetch_add_explicit(&g_run_time_switches[task_number % RUN_TIME_STATS_MAX_THREADS], 1, memory_order_relaxed);
+
+    return;
+}
+
+uint32_t Run_Time_Stats_GetSwitches (const uint32_t task_number) {
+    return atomic_load_explicit(&g_run_time_switches[task_number % RUN_TIME_STATS_MAX_THREADS], memory_order_relaxed);
+}
+
+/* Free running totals, callers work with the difference of two reads */
+bool Run_Time_Stats_GetIsr (const eRunTimeIsr_t source, sRunTimeIsrStats_t *stats) {
+    if ((source < eRunTimeIsr_First) || (source >= eRunTimeIsr_Last) || (stats == NULL)) {
+        return false;
+    }
+
+    stats->cycles = atomic_load_explicit(&g_run_time_isr[source].cycles, memory_order_relaxed);
+    stats->count = atomic_load_explicit(&g_run_time_isr[source].count, memory_order_relaxed);
+
+    return true;
+}
+
+const char *Run_Time_Stats_GetIsrName (const eRunTimeIsr_t source) {
+    if ((source < eRunTimeIsr_First) || (source >= eRunTimeIsr_Last)) {
+        return NULL;
+    }
+
+    return g_run_time_isr_name_lut[source];
+}
+
+#endif
@@ -4,14 +4,45 @@
  * Includes
  *********************************************************************************************************************/
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "framework_config.h"
+
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+/**
+ * Bracket an interrupt handler to account its time to a source, compiles out without ENABLE_RUN_TIME_STATS.
+ * Place RUN_TIME_ISR_ENTER first in the handler and RUN_TIME_ISR_EXIT on its only return path.
+ */
+#ifdef ENABLE_RUN_TIME_STATS
+#define RUN_TIME_ISR_ENTER() const uint32_t run_time_isr_start = Run_Time_Stats_GetCycles()
+#define RUN_TIME_ISR_EXIT(source) Run_Time_Stats_IsrExit((source), run_time_isr_start)
+#else
+#define RUN_TIME_ISR_ENTER() ((void) 0)
+#define RUN_TIME_ISR_EXIT(source) ((void) 0)
+#endif
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef enum eRunTimeIsr {
+    eRunTimeIsr_First = 0,
+    eRunTimeIsr_Uart = eRunTimeIsr_First,
+    eRunTimeIsr_Dma,
+    eRunTimeIsr_I2c,
+    eRunTimeIsr_Last
+} eRunTimeIsr_t;
+
+typedef struct sRunTimeIsrStats {
+    uint32_t cycles;
+    uint32_t count;
+} sRunTimeIsrStats_t;
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -23,4 +54,11 @@
 void configureTimerForRunTimeStats (void);
 unsigned long getRunTimeCounterValue (void);
 
+uint32_t Run_Time_Stats_GetCycles (void);
+void Run_Time_Stats_IsrExit (const eRunTimeIsr_t source, const uint32_t start);
+void Run_Time_Stats_TaskSwitchedIn (const uint32_t task_number);
+uint32_t Run_Time_Stats_GetSwitches (const uint32_t task_number);
+bool Run_Time_Stats_GetIsr (const eRunTimeIsr_t source, sRunTimeIsrStats_t *stats);
+const char *Run_Time_Stats_GetIsrName (const eRunTimeIsr_t source);
+
 #endif /* SOURCE_UTILITY_RUN_TIME_STATS_H_ */
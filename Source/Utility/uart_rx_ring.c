@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "uart_rx_ring.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define WATERMARK(capacity, percent) (((capacity) * (percent)) / 100U)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* The stream has to start at the first storage byte with NDTR at the ring capacity, unread data is dropped */
+bool UART_Rx_Ring_DmaStart (sUartRxDma_t *rx_dma, RingBuffer_Handle ring_buffer) {
+    if ((rx_dma == NULL) || (ring_buffer == NULL)) {
+        return false;
+    }
+
+    rx_dma->ring_buffer = ring_buffer;
+
+    UART_Rx_Ring_DmaRestart(rx_dma);
+
+    return true;
+}
+
+/**
+ * Moves the ring head to the DMA write position, returns the number of bytes that became readable.
+ * is_lap_complete is set from the TC interrupt, the stream has wrapped since. is_overrun is set when unread data was
+ * overwritten, only the overwritten bytes are lost.
+ */
+size_t UART_Rx_Ring_DmaSync (sUartRxDma_t *rx_dma, const size_t remaining, const bool is_lap_complete, bool *is_overrun) {
+    if ((rx_dma == NULL) || (is_overrun == NULL)) {
+        return 0;
+    }
+
+    size_t capacity = Ring_Buffer_GetCapacity(rx_dma->ring_buffer);
+    size_t published = 0;
+
+    if (is_lap_complete) {
+        rx_dma->lap += capacity;
+    }
+
+    size_t write_count = rx_dma->lap + (capacity - remaining);
+
+    /* Behind the last sync means the stream wrapped and its TC is still pending */
+    if ((write_count - rx_dma->count) > (SIZE_MAX / 2)) {
+        write_count += capacity;
+    }
+
+    *is_overrun = !Ring_Buffer_SyncHead(rx_dma->ring_buffer, write_count, &published);
+
+    rx_dma->count = write_count;
+
+    return published;
+}
+
+/* After a transfer error the stream is reloaded and starts over at the first storage byte, returns the dropped bytes */
+size_t UART_Rx_Ring_DmaRestart (sUartRxDma_t *rx_dma) {
+    if (rx_dma == NULL) {
+        return 0;
+    }
+
+    size_t dropped = 0;
+
+    rx_dma->lap = Ring_Buffer_ResyncHead(rx_dma->ring_buffer, &dropped);
+    rx_dma->count = rx_dma->lap;
+
+    return dropped;
+}
+
+/* Producer side of RTS flow control, true once the fill level reached percent of the capacity */
+bool UART_Rx_Ring_IsAboveWatermark (RingBuffer_Handle ring_buffer, const uint32_t percent) {
+    if (ring_buffer == NULL) {
+        return false;
+    }
+
+    return Ring_Buffer_GetCount(ring_buffer) >= WATERMARK(Ring_Buffer_GetCapacity(ring_buffer), percent);
+}
+
+/* Consumer side of RTS flow control, true once the fill level dropped to percent of the capacity */
+bool UART_Rx_Ring_IsBelowWatermark (RingBuffer_Handle ring_buffer, const uint32_t percent) {
+    if (ring_buffer == NULL) {
+        return false;
+    }
+
+    return Ring_Buffer_GetCount(ring_buffer) <= WATERMARK(Ring_Buffer_GetCapacity(ring_buffer), percent);
+}
@@ -0,0 +1,48 @@
+#ifndef SOURCE_UTILITY_UART_RX_RING_H_
+#define SOURCE_UTILITY_UART_RX_RING_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ring_buffer.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**
+ * Circular DMA reception into a ring buffer, without the hardware. The caller reads NDTR and passes it as remaining.
+ * The ring must be created with eRingBufferPolicy_Overwrite, its storage is the DMA memory.
+ * All functions run in the DMA/USART interrupt context or with those interrupts masked.
+ */
+/* clang-format off */
+typedef struct sUartRxDma {
+    RingBuffer_Handle ring_buffer;
+    /* Write count of the first storage byte in the current lap, and the count published last */
+    size_t lap;
+    size_t count;
+} sUartRxDma_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool UART_Rx_Ring_DmaStart (sUartRxDma_t *rx_dma, RingBuffer_Handle ring_buffer);
+size_t UART_Rx_Ring_DmaSync (sUartRxDma_t *rx_dma, const size_t remaining, const bool is_lap_complete, bool *is_overrun);
+size_t UART_Rx_Ring_DmaRestart (sUartRxDma_t *rx_dma);
+bool UART_Rx_Ring_IsAboveWatermark (RingBuffer_Handle ring_buffer, const uint32_t percent);
+bool UART_Rx_Ring_IsBelowWatermark (RingBuffer_Handle ring_buffer, const uint32_t percent);
+
+#endif /* SOURCE_UTILITY_UART_RX_RING_H_ */
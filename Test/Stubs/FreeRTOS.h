@@ -0,0 +1,23 @@
+#ifndef TEST_STUBS_FREERTOS_H_
+#define TEST_STUBS_FREERTOS_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* The FreeRTOSConfig.h settings the host builds check, the kernel calls belong to the program */
+#define configGENERATE_RUN_TIME_STATS 1
+#define configUSE_TRACE_FACILITY 1
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+typedef unsigned long UBaseType_t;
+
+#endif /* TEST_STUBS_FREERTOS_H_ */
@@ -0,0 +1,53 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "cmsis_os2.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+osMutexId_t osMutexNew (const osMutexAttr_t *attr) {
+    pthread_mutex_t *mutex = malloc(sizeof(pthread_mutex_t));
+    pthread_mutexattr_t mutex_attr;
+
+    if (mutex == NULL) {
+        return NULL;
+    }
+
+    pthread_mutexattr_init(&mutex_attr);
+
+    if ((attr != NULL) && ((attr->attr_bits & osMutexRecursive) != 0)) {
+        pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+    }
+
+    pthread_mutex_init(mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    return mutex;
+}
+
+/* Only 0 and osWaitForever are told apart, any other timeout waits forever */
+osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout) {
+    if (mutex_id == NULL) {
+        return osErrorParameter;
+    }
+
+    if (timeout == 0) {
+        return (pthread_mutex_trylock(mutex_id) == 0) ? osOK : osErrorResource;
+    }
+
+    return (pthread_mutex_lock(mutex_id) == 0) ? osOK : osError;
+}
+
+osStatus_t osMutexRelease (osMutexId_t mutex_id) {
+    if (mutex_id == NULL) {
+        return osErrorParameter;
+    }
+
+    return (pthread_mutex_unlock(mutex_id) == 0) ? osOK : osErrorResource;
+}
@@ -0,0 +1,75 @@
+#ifndef TEST_STUBS_CMSIS_OS2_H_
+#define TEST_STUBS_CMSIS_OS2_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* The part of CMSIS-RTOS2 the host builds use, mutexes are pthread mutexes, threads and delays belong to the program */
+#define osWaitForever 0xFFFFFFFFU
+
+#define osMutexRecursive 0x00000001U
+#define osMutexPrioInherit 0x00000002U
+#define osMutexRobust 0x00000008U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+typedef enum {
+    osOK = 0,
+    osError = -1,
+    osErrorTimeout = -2,
+    osErrorResource = -3,
+    osErrorParameter = -4
+} osStatus_t;
+
+typedef enum {
+    osPriorityNone = 0,
+    osPriorityIdle = 1,
+    osPriorityLow = 8,
+    osPriorityNormal = 24,
+    osPriorityHigh = 40,
+    osPriorityRealtime = 48
+} osPriority_t;
+
+typedef void *osMutexId_t;
+typedef void *osThreadId_t;
+typedef void (*osThreadFunc_t) (void *argument);
+
+typedef struct {
+    const char *name;
+    uint32_t attr_bits;
+    void *cb_mem;
+    uint32_t cb_size;
+} osMutexAttr_t;
+
+typedef struct {
+    const char *name;
+    uint32_t attr_bits;
+    void *cb_mem;
+    uint32_t cb_size;
+    void *stack_mem;
+    uint32_t stack_size;
+    osPriority_t priority;
+} osThreadAttr_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+osMutexId_t osMutexNew (const osMutexAttr_t *attr);
+osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease (osMutexId_t mutex_id);
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr);
+osStatus_t osThreadYield (void);
+osStatus_t osDelay (uint32_t ticks);
+
+#endif /* TEST_STUBS_CMSIS_OS2_H_ */
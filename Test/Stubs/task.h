@@ -0,0 +1,27 @@
+#ifndef TEST_STUBS_TASK_H_
+#define TEST_STUBS_TASK_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "FreeRTOS.h"
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* The fields of the kernel task status the framework reads, the run time counter is the pre V10.4.4 uint32_t */
+typedef struct xTASK_STATUS {
+    void *xHandle;
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    uint32_t ulRunTimeCounter;
+} TaskStatus_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+UBaseType_t uxTaskGetSystemState (TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime);
+
+#endif /* TEST_STUBS_TASK_H_ */
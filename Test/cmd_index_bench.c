@@ -0,0 +1,240 @@
+/**
+ * Host benchmark of command lookup through the CMD_API hash index against the linear strncmp scan it replaced.
+ *
+ * Tables of 10 to 500 commands are generated with names that share prefixes the way the CLI tables do. Every command
+ * is looked up in turn with arguments attached, plus one unknown command per lap. The legacy scan is the old
+ * CMD_API_FindCommand run over the framework table and then the project table, each holding half of the commands.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cmd_api.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define BENCH_COMMANDS_MAX 500U
+#define BENCH_LOOKUPS 2000000UL
+#define BENCH_NAME_SIZE 32U
+#define BENCH_QUERY_SIZE 48U
+#define BENCH_RESPONSE_SIZE 64U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sBenchQuery {
+    char text[BENCH_QUERY_SIZE];
+    size_t size;
+    int expected;
+} sBenchQuery_t;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static bool Bench_Handler (sMessage_t arguments, sMessage_t *response);
+static bool Legacy_CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size);
+static bool Legacy_Find (sMessage_t command, sMessage_t *response, const size_t command_count);
+static void Bench_BuildTables (const size_t command_count);
+static double Bench_Seconds (void);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const char *g_modules[] = {"led", "motor", "uart", "heap", "io", "ws2812b", "debug", "span", "tof", "i2c"};
+static const char *g_actions[] = {"set", "get", "start", "stop", "config", "stats", "reset", "pulse", "blink", "level"};
+
+static const size_t g_command_counts[] = {10U, 25U, 50U, 100U, 250U, 500U};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static char g_names[BENCH_COMMANDS_MAX][BENCH_NAME_SIZE];
+/* Entry 0 of each table is the unused eCli*Cmd_First */
+static sCmdDesc_t g_framework_lut[(BENCH_COMMANDS_MAX / 2U) + 1U];
+static sCmdDesc_t g_project_lut[(BENCH_COMMANDS_MAX / 2U) + 1U];
+static sCmdDesc_t *g_index_slots[CMD_API_INDEX_CAPACITY(BENCH_COMMANDS_MAX)];
+static sBenchQuery_t g_queries[BENCH_COMMANDS_MAX + 1U];
+static int g_hit = 0;
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* The argument text is the number of the command */
+static bool Bench_Handler (sMessage_t arguments, sMessage_t *response) {
+    int number = 0;
+
+    for (size_t position = 0; position < arguments.size; position++) {
+        number = (number * 10) + (arguments.data[position] - '0');
+    }
+
+    g_hit = number;
+    response->data[0] = '\0';
+
+    return true;
+}
+
+/* CMD_API_FindCommand before the index */
+static bool Legacy_CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size) {
+    if ((response == NULL) || (command_lut == NULL)) {
+        return false;
+    }
+
+    if (response->data == NULL) {
+        return false;
+    }
+
+    for (size_t command_number = 1; command_number < command_lut_size; command_number++) {
+        if (strncmp(command.data, command_lut[command_number].command, command_lut[command_number].command_lenght) != 0) {
+            continue;
+        }
+
+        command.data += command_lut[command_number].command_lenght;
+        command.size -= command_lut[command_number].command_lenght;
+
+        return command_lut[command_number].handler(command, response);
+    }
+
+    snprintf(response->data, response->size, "Invalid command\n");
+
+    return false;
+}
+
+/* CLI_APP_Thread tried the framework table first, then the project table */
+static bool Legacy_Find (sMessage_t command, sMessage_t *response, const size_t command_count) {
+    size_t framework_count = command_count / 2U;
+
+    if (Legacy_CMD_API_FindCommand(command, response, g_framework_lut, framework_count + 1U)) {
+        return true;
+    }
+
+    return Legacy_CMD_API_FindCommand(command, response, g_project_lut, (command_count - framework_count) + 1U);
+}
+
+static void Bench_BuildTables (const size_t command_count) {
+    size_t framework_count = command_count / 2U;
+
+    memset(g_framework_lut, 0, sizeof(g_framework_lut));
+    memset(g_project_lut, 0, sizeof(g_project_lut));
+
+    for (size_t command = 0; command < command_count; command++) {
+        size_t module = command % (sizeof(g_modules) / sizeof(g_modules[0]));
+        size_t action = (command / (sizeof(g_modules) / sizeof(g_modules[0]))) % (sizeof(g_actions) / sizeof(g_actions[0]));
+        size_t variant = command / ((sizeof(g_modules) / sizeof(g_modules[0])) * (sizeof(g_actions) / sizeof(g_actions[0])));
+        int length = 0;
+
+        if (variant == 0) {
+            length = snprintf(g_names[command], BENCH_NAME_SIZE, "%s_%s:", g_modules[module], g_actions[action]);
+        } else {
+            length = snprintf(g_names[command], BENCH_NAME_SIZE, "%s_%s%zu:", g_modules[module], g_actions[action], variant);
+        }
+
+        sCmdDesc_t *command_desc = (command < framework_count) ? &g_framework_lut[command + 1U] : &g_project_lut[(command - framework_count) + 1U];
+
+        command_desc->command = g_names[command];
+        command_desc->command_lenght = (size_t) length;
+        command_desc->handler = Bench_Handler;
+
+        g_queries[command].size = (size_t) snprintf(g_queries[command].text, BENCH_QUERY_SIZE, "%s%zu", g_names[command], command);
+        g_queries[command].expected = (int) command;
+    }
+
+    g_queries[command_count].size = (size_t) snprintf(g_queries[command_count].text, BENCH_QUERY_SIZE, "led_unknown:1");
+    g_queries[command_count].expected = -1;
+
+    return;
+}
+
+static double Bench_Seconds (void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double) now.tv_sec + ((double) now.tv_nsec / 1e9));
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    char response_buffer[BENCH_RESPONSE_SIZE];
+    sMessage_t legacy_response = {.data = response_buffer, .size = sizeof(response_buffer)};
+    sCmdWriter_t response = {0};
+
+    CMD_API_Writer_Init(&response, response_buffer, sizeof(response_buffer), NULL);
+
+    printf("%8s %16s %16s %9s\n", "commands", "linear ns/call", "index ns/call", "speedup");
+
+    for (size_t count = 0; count < (sizeof(g_command_counts) / sizeof(g_command_counts[0])); count++) {
+        size_t command_count = g_command_counts[count];
+        size_t framework_count = command_count / 2U;
+        sCmdIndex_t index = {0};
+
+        Bench_BuildTables(command_count);
+
+        if (!CMD_API_Index_Init(&index, g_index_slots, CMD_API_INDEX_CAPACITY(command_count)) || !CMD_API_Index_Add(&index, g_framework_lut, framework_count + 1U) || !CMD_API_Index_Add(&index, g_project_lut, (command_count - framework_count) + 1U)) {
+            printf("FAIL: index of %zu commands not built\n", command_count);
+
+            return 1;
+        }
+
+        /* Both find the same handler, the unknown command in neither */
+        for (size_t query = 0; query <= command_count; query++) {
+            sMessage_t command = {.data = g_queries[query].text, .size = g_queries[query].size};
+            bool is_legacy_found = false;
+            bool is_found = false;
+
+            g_hit = -1;
+            is_legacy_found = Legacy_Find(command, &legacy_response, command_count);
+
+            int legacy_hit = g_hit;
+
+            g_hit = -1;
+            CMD_API_Writer_Reset(&response);
+            is_found = CMD_API_FindCommand(command, &response, &index);
+
+            if ((is_legacy_found != is_found) || (legacy_hit != g_queries[query].expected) || (g_hit != g_queries[query].expected)) {
+                printf("FAIL: %s: linear %d, index %d, expected %d\n", g_queries[query].text, legacy_hit, g_hit, g_queries[query].expected);
+
+                return 1;
+            }
+        }
+
+        double start = Bench_Seconds();
+
+        for (size_t lookup = 0; lookup < BENCH_LOOKUPS; lookup++) {
+            sBenchQuery_t *query = &g_queries[lookup % (command_count + 1U)];
+
+            Legacy_Find((sMessage_t) {.data = query->text, .size = query->size}, &legacy_response, command_count);
+        }
+
+        double legacy_seconds = Bench_Seconds() - start;
+
+        start = Bench_Seconds();
+
+        for (size_t lookup = 0; lookup < BENCH_LOOKUPS; lookup++) {
+            sBenchQuery_t *query = &g_queries[lookup % (command_count + 1U)];
+
+            CMD_API_Writer_Reset(&response);
+            CMD_API_FindCommand((sMessage_t) {.data = query->text, .size = query->size}, &response, &index);
+        }
+
+        double index_seconds = Bench_Seconds() - start;
+
+        printf("%8zu %16.1f %16.1f %8.1fx\n", command_count, (legacy_seconds * 1e9) / (double) BENCH_LOOKUPS, (index_seconds * 1e9) / (double) BENCH_LOOKUPS, legacy_seconds / index_seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,473 @@
+/**
+ * Host simulation of the CPU_API sampler over a recorded schedule.
+ *
+ * The recording gives, for every slot of RUN_TIME_STATS_WINDOW_MS / RUN_TIME_STATS_WINDOW_SLOTS, the run time and
+ * the number of bursts of each thread and the calls and length of each interrupt source, the idle thread gets the rest
+ * of the slot. The kernel is simulated on a simulated clock: clock_gettime is replaced so run_time_stats.c reads it,
+ * every burst is a context switch through getRunTimeCounterValue and Run_Time_Stats_TaskSwitchedIn like the kernel
+ * hooks, interrupts preempt the idle thread between RUN_TIME_ISR_ENTER and RUN_TIME_ISR_EXIT.
+ * CPU_API_Thread runs unchanged. Its osDelay checks every report against the recording, the 32-bit cycle counter
+ * wraps in the second slot and a thread is created with the window already full.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cmsis_os2.h"
+#include "task.h"
+#include "cpu_api.h"
+#include "debug_api.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define SLOT_MS (RUN_TIME_STATS_WINDOW_MS / RUN_TIME_STATS_WINDOW_SLOTS)
+#define SLOT_US (SLOT_MS * 1000ULL)
+#define NS_PER_CYCLE (1000000000ULL / SYSTEM_CLOCK_HZ)
+
+/* The cycle counter wraps 750 ms in */
+#define START_CYCLES (0x100000000ULL - ((SYSTEM_CLOCK_HZ / 4ULL) * 3ULL))
+
+#define SLOT_COUNT (sizeof(g_sim_recording) / sizeof(g_sim_recording[0]))
+
+/* The thread run time goes through the counter shift, the interrupt cycles are exact */
+#define LOAD_TOLERANCE_PERMILLE 1U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef enum eSimTask {
+    eSimTask_First = 0,
+    eSimTask_Sampler = eSimTask_First,
+    eSimTask_Idle,
+    eSimTask_Cli,
+    eSimTask_Led,
+    eSimTask_Motor,
+    eSimTask_Last
+} eSimTask_t;
+
+typedef struct sSimBurst {
+    uint32_t run_us;
+    uint32_t bursts;
+} sSimBurst_t;
+
+typedef struct sSimIsr {
+    uint32_t calls;
+    uint32_t cycles;
+} sSimIsr_t;
+
+typedef struct sSimSlot {
+    sSimBurst_t thread[eSimTask_Last];
+    sSimIsr_t isr[eRunTimeIsr_Last];
+} sSimSlot_t;
+
+typedef struct sSimTask {
+    const char *name;
+    uint32_t run_time;
+    bool is_created;
+} sSimTask_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/* clang-format off */
+static const sSimSlot_t g_sim_recording[] = {
+    {.thread = {[eSimTask_Idle] = {0, 40}, [eSimTask_Cli] = {120000, 30}, [eSimTask_Led] = {50000, 100}}, .isr = {[eRunTimeIsr_Uart] = {200, 900}, [eRunTimeIsr_Dma] = {20, 2400}}},
+    {.thread = {[eSimTask_Idle] = {0, 40}, [eSimTask_Cli] = {300000, 60}, [eSimTask_Led] = {50000, 100}}, .isr = {[eRunTimeIsr_Uart] = {1500, 900}, [eRunTimeIsr_Dma] = {150, 2400}}},
+    {.thread = {[eSimTask_Idle] = {0, 50}, [eSimTask_Cli] = {20000, 10}, [eSimTask_Led] = {50000, 100}}, .isr = {[eRunTimeIsr_Uart] = {100, 900}, [eRunTimeIsr_Dma] = {10, 2400}, [eRunTimeIsr_I2c] = {40, 6000}}},
+    {.thread = {[eSimTask_Idle] = {0, 50}, [eSimTask_Cli] = {20000, 10}, [eSimTask_Led] = {50000, 100}}, .isr = {[eRunTimeIsr_Uart] = {100, 900}, [eRunTimeIsr_Dma] = {10, 2400}, [eRunTimeIsr_I2c] = {40, 6000}}},
+    {.thread = {[eSimTask_Idle] = {0, 40}, [eSimTask_Cli] = {60000, 20}, [eSimTask_Led] = {50000, 100}, [eSimTask_Motor] = {150000, 250}}, .isr = {[eRunTimeIsr_Uart] = {300, 900}, [eRunTimeIsr_Dma] = {30, 2400}, [eRunTimeIsr_I2c] = {400, 6000}}},
+    {.thread = {[eSimTask_Idle] = {0, 40}, [eSimTask_Cli] = {20000, 10}, [eSimTask_Led] = {50000, 100}, [eSimTask_Motor] = {200000, 250}}, .isr = {[eRunTimeIsr_Uart] = {100, 950}, [eRunTimeIsr_Dma] = {10, 2400}, [eRunTimeIsr_I2c] = {400, 6000}}},
+    {.thread = {[eSimTask_Idle] = {0, 20}, [eSimTask_Led] = {50000, 100}, [eSimTask_Motor] = {380000, 250}}, .isr = {[eRunTimeIsr_I2c] = {400, 6000}}},
+    {.thread = {[eSimTask_Idle] = {0, 40}, [eSimTask_Cli] = {20000, 10}, [eSimTask_Led] = {50000, 100}, [eSimTask_Motor] = {100000, 250}}, .isr = {[eRunTimeIsr_Uart] = {100, 900}, [eRunTimeIsr_Dma] = {10, 2400}, [eRunTimeIsr_I2c] = {400, 6000}}}
+};
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static sSimTask_t g_sim_task[eSimTask_Last] = {
+    [eSimTask_Sampler] = {.name = "CPU_API_Thread", .is_created = true},
+    [eSimTask_Idle] = {.name = "IDLE", .is_created = true},
+    [eSimTask_Cli] = {.name = "CLI_APP_Thread"},
+    [eSimTask_Led] = {.name = "LED_APP_Thread"},
+    [eSimTask_Motor] = {.name = "Motor_APP_Thread"}
+};
+
+static uint64_t g_sim_ns = START_CYCLES * NS_PER_CYCLE;
+static eSimTask_t g_sim_current = eSimTask_Sampler;
+static uint32_t g_sim_switched_in = 0;
+
+static osThreadFunc_t g_sim_thread = NULL;
+static jmp_buf g_sim_end;
+static size_t g_sim_played = 0;
+static size_t g_sim_failures = 0;
+static size_t g_sim_warnings = 0;
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+uint8_t g_debug_api_module_level[eTraceModule_Last] = {0};
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Fail (const char *what, const char *name, const uint32_t value, const uint32_t expected);
+static void Sim_Switch (const eSimTask_t task);
+static void Sim_Isr (const eRunTimeIsr_t source, const uint32_t cycles);
+static void Sim_PlaySlot (const sSimSlot_t *slot);
+static void Sim_CheckReport (void);
+static void Sim_PrintTop (void);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Fail (const char *what, const char *name, const uint32_t value, const uint32_t expected) {
+    printf("window after slot %zu, %s %s: %lu, expected %lu\n", g_sim_played, name, what, (unsigned long) value, (unsigned long) expected);
+
+    g_sim_failures++;
+
+    return;
+}
+
+/* vTaskSwitchContext, called for every burst even when the same thread is picked again */
+static void Sim_Switch (const eSimTask_t task) {
+    uint32_t now = (uint32_t) getRunTimeCounterValue();
+
+    g_sim_task[g_sim_current].run_time += now - g_sim_switched_in;
+    g_sim_switched_in = now;
+    g_sim_current = task;
+    g_sim_task[task].is_created = true;
+
+    Run_Time_Stats_TaskSwitchedIn((uint32_t) task + 1U);
+
+    return;
+}
+
+static void Sim_Isr (const eRunTimeIsr_t source, const uint32_t cycles) {
+    RUN_TIME_ISR_ENTER();
+
+    g_sim_ns += (uint64_t) cycles * NS_PER_CYCLE;
+
+    RUN_TIME_ISR_EXIT(source);
+
+    return;
+}
+
+/* Round robin over the bursts of the slot, the interrupts are spread over the idle bursts */
+static void Sim_PlaySlot (const sSimSlot_t *slot) {
+    uint64_t busy_us = 0;
+    uint32_t rounds = 0;
+
+    for (eSimTask_t task = eSimTask_Idle; task < eSimTask_Last; task++) {
+        if (task != eSimTask_Idle) {
+            busy_us += slot->thread[task].run_us;
+        }
+
+        if (slot->thread[task].bursts > rounds) {
+            rounds = slot->thread[task].bursts;
+        }
+    }
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (eSimTask_t task = eSimTask_Idle; task < eSimTask_Last; task++) {
+            uint32_t bursts = slot->thread[task].bursts;
+
+            if (round >= bursts) {
+                continue;
+            }
+
+            uint64_t run_ns = ((task == eSimTask_Idle) ? (SLOT_US - busy_us) : slot->thread[task].run_us) * 1000ULL;
+            uint64_t burst_ns = run_ns / bursts;
+
+            if (round == (bursts - 1U)) {
+                burst_ns = run_ns - (burst_ns * (bursts - 1U));
+            }
+
+            Sim_Switch(task);
+
+            if (task == eSimTask_Idle) {
+                for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+                    uint64_t calls = slot->isr[source].calls;
+                    uint64_t burst_calls = ((calls * (round + 1U)) / bursts) - ((calls * round) / bursts);
+                    uint64_t isr_ns = burst_calls * slot->isr[source].cycles * NS_PER_CYCLE;
+
+                    if (isr_ns > burst_ns) {
+                        Sim_Fail("interrupt time over the idle burst", Run_Time_Stats_GetIsrName(source), (uint32_t) isr_ns, (uint32_t) burst_ns);
+
+                        isr_ns = burst_ns;
+                    }
+
+                    for (uint64_t call = 0; call < burst_calls; call++) {
+                        Sim_Isr(source, slot->isr[source].cycles);
+                    }
+
+                    burst_ns -= isr_ns;
+                }
+            }
+
+            g_sim_ns += burst_ns;
+        }
+    }
+
+    Sim_Switch(eSimTask_Sampler);
+
+    return;
+}
+
+/* The report over the last RUN_TIME_STATS_WINDOW_SLOTS played slots */
+static void Sim_CheckReport (void) {
+    size_t window = (g_sim_played < RUN_TIME_STATS_WINDOW_SLOTS) ? g_sim_played : RUN_TIME_STATS_WINDOW_SLOTS;
+    uint64_t run_us[eSimTask_Last] = {0};
+    uint32_t switches[eSimTask_Last] = {0};
+    sRunTimeIsrStats_t isr[eRunTimeIsr_Last] = {0};
+    size_t thread_count = 0;
+
+    for (size_t index = g_sim_played - window; index < g_sim_played; index++) {
+        const sSimSlot_t *slot = &g_sim_recording[index];
+
+        run_us[eSimTask_Idle] += SLOT_US;
+        switches[eSimTask_Sampler]++;
+
+        for (eSimTask_t task = eSimTask_Idle; task < eSimTask_Last; task++) {
+            if (task != eSimTask_Idle) {
+                run_us[task] += slot->thread[task].run_us;
+                run_us[eSimTask_Idle] -= slot->thread[task].run_us;
+            }
+
+            switches[task] += slot->thread[task].bursts;
+        }
+
+        for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+            isr[source].cycles += slot->isr[source].calls * slot->isr[source].cycles;
+            isr[source].count += slot->isr[source].calls;
+        }
+    }
+
+    for (eSimTask_t task = eSimTask_First; task < eSimTask_Last; task++) {
+        if (g_sim_task[task].is_created) {
+            thread_count++;
+        }
+    }
+
+    if (CPU_API_GetWindowMs() != (window * SLOT_MS)) {
+        Sim_Fail("ms", "window", CPU_API_GetWindowMs(), window * SLOT_MS);
+    }
+
+    if (CPU_API_GetThreadCount() != thread_count) {
+        Sim_Fail("count", "thread", CPU_API_GetThreadCount(), thread_count);
+    }
+
+    uint32_t previous_load = UINT32_MAX;
+
+    for (size_t thread = 0; thread < CPU_API_GetThreadCount(); thread++) {
+        sCpuThreadStats_t stats = {0};
+        eSimTask_t task = eSimTask_First;
+
+        CPU_API_GetThreadStats(thread, &stats);
+
+        /* Names are cut to CPU_API_THREAD_NAME_LENGTH like the kernel cuts them to configMAX_TASK_NAME_LEN */
+        while ((task < eSimTask_Last) && (strncmp(stats.name, g_sim_task[task].name, CPU_API_THREAD_NAME_LENGTH - 1U) != 0)) {
+            task++;
+        }
+
+        if (task == eSimTask_Last) {
+            Sim_Fail("unknown thread", stats.name, thread, 0);
+
+            continue;
+        }
+
+        uint32_t load_permille = (uint32_t) ((run_us[task] * 1000U) / (window * SLOT_US));
+
+        if ((stats.load_permille + LOAD_TOLERANCE_PERMILLE < load_permille) || (stats.load_permille > load_permille + LOAD_TOLERANCE_PERMILLE)) {
+            Sim_Fail("load permille", stats.name, stats.load_permille, load_permille);
+        }
+
+        if (stats.load_permille > previous_load) {
+            Sim_Fail("load permille out of order", stats.name, stats.load_permille, previous_load);
+        }
+
+        if (stats.switches != switches[task]) {
+            Sim_Fail("switches", stats.name, stats.switches, switches[task]);
+        }
+
+        previous_load = stats.load_permille;
+    }
+
+    for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+        sCpuIsrStats_t stats = {0};
+
+        CPU_API_GetIsrStats(source, &stats);
+
+        uint32_t load_permille = (uint32_t) (((uint64_t) isr[source].cycles * 1000U) / (window * SLOT_MS * SYSTEM_MS_TICS));
+        uint32_t average_cycles = (isr[source].count != 0) ? (isr[source].cycles / isr[source].count) : 0;
+
+        if (stats.load_permille != load_permille) {
+            Sim_Fail("isr load permille", stats.name, stats.load_permille, load_permille);
+        }
+
+        if (stats.count != isr[source].count) {
+            Sim_Fail("isr calls", stats.name, stats.count, isr[source].count);
+        }
+
+        if (stats.average_cycles != average_cycles) {
+            Sim_Fail("isr cycles avg", stats.name, stats.average_cycles, average_cycles);
+        }
+    }
+
+    return;
+}
+
+/* The lines of CLI_APP_Cpu_Handlers_Top */
+static void Sim_PrintTop (void) {
+    printf("Last %u ms\n", (unsigned int) CPU_API_GetWindowMs());
+
+    for (size_t thread = 0; thread < CPU_API_GetThreadCount(); thread++) {
+        sCpuThreadStats_t stats = {0};
+
+        if (!CPU_API_GetThreadStats(thread, &stats)) {
+            continue;
+        }
+
+        printf("%s: %u.%u%% cpu, %u switches\n", stats.name, (unsigned int) (stats.load_permille / 10U), (unsigned int) (stats.load_permille % 10U), (unsigned int) stats.switches);
+    }
+
+    for (eRunTimeIsr_t source = eRunTimeIsr_First; source < eRunTimeIsr_Last; source++) {
+        sCpuIsrStats_t stats = {0};
+
+        if (!CPU_API_GetIsrStats(source, &stats)) {
+            continue;
+        }
+
+        printf("isr %s: %u.%u%% cpu, %u calls, %u cycles avg\n", stats.name, (unsigned int) (stats.load_permille / 10U), (unsigned int) (stats.load_permille % 10U), (unsigned int) stats.count, (unsigned int) stats.average_cycles);
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Run_Time_Stats_GetCycles reads the simulated clock */
+int clock_gettime (clockid_t clock_id, struct timespec *now) {
+    now->tv_sec = (time_t) (g_sim_ns / 1000000000ULL);
+    now->tv_nsec = (long) (g_sim_ns % 1000000000ULL);
+
+    return 0;
+}
+
+UBaseType_t uxTaskGetSystemState (TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime) {
+    UBaseType_t count = 0;
+
+    for (eSimTask_t task = eSimTask_First; task < eSimTask_Last; task++) {
+        if (!g_sim_task[task].is_created) {
+            continue;
+        }
+
+        if (count == uxArraySize) {
+            return 0;
+        }
+
+        pxTaskStatusArray[count].xHandle = &g_sim_task[task];
+        pxTaskStatusArray[count].pcTaskName = g_sim_task[task].name;
+        pxTaskStatusArray[count].xTaskNumber = (UBaseType_t) task + 1U;
+        pxTaskStatusArray[count].ulRunTimeCounter = g_sim_task[task].run_time;
+        count++;
+    }
+
+    *pulTotalRunTime = (uint32_t) getRunTimeCounterValue();
+
+    return count;
+}
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+    g_sim_thread = func;
+
+    return &g_sim_task[eSimTask_Sampler];
+}
+
+osStatus_t osThreadYield (void) {
+    return osOK;
+}
+
+/* The sampler sleeps for one slot, the recording plays in the meantime */
+osStatus_t osDelay (uint32_t ticks) {
+    if (ticks != SLOT_MS) {
+        Sim_Fail("sampler period", "osDelay", ticks, SLOT_MS);
+    }
+
+    if (g_sim_played == 0) {
+        if (CPU_API_GetWindowMs() != 0) {
+            Sim_Fail("ms before two samples", "window", CPU_API_GetWindowMs(), 0);
+        }
+    } else {
+        Sim_CheckReport();
+    }
+
+    if (g_sim_played == SLOT_COUNT) {
+        longjmp(g_sim_end, 1);
+    }
+
+    Sim_PlaySlot(&g_sim_recording[g_sim_played]);
+
+    g_sim_played++;
+
+    return osOK;
+}
+
+bool Debug_API_Print (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...) {
+    g_sim_warnings++;
+
+    return true;
+}
+
+int main (void) {
+    configureTimerForRunTimeStats();
+
+    g_sim_switched_in = (uint32_t) getRunTimeCounterValue();
+
+    if (!CPU_API_Init() || (g_sim_thread == NULL)) {
+        printf("FAIL: CPU_API_Init\n");
+
+        return 1;
+    }
+
+    if (setjmp(g_sim_end) == 0) {
+        g_sim_thread(NULL);
+    }
+
+    Sim_PrintTop();
+
+    printf("%zu slots of %u ms, %zu reports checked\n", g_sim_played, (unsigned int) SLOT_MS, g_sim_played);
+
+    if (g_sim_warnings > 0) {
+        printf("FAIL: %zu unexpected traces\n", g_sim_warnings);
+
+        return 1;
+    }
+
+    if (g_sim_failures > 0) {
+        printf("FAIL: %zu report values off the recording\n", g_sim_failures);
+
+        return 1;
+    }
+
+    printf("pass\n");
+
+    return 0;
+}
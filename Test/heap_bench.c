@@ -0,0 +1,316 @@
+/**
+ * Host benchmark of the allocation latency of Heap_API against the calloc behind a mutex it replaced.
+ *
+ * Every thread keeps a working set of blocks between 1 and 256 bytes and replaces a random one per round, so the heap
+ * sees the alloc/free mix of the CLI and message paths. Each call is timed on its own, the report is the latency
+ * distribution per implementation with one thread and with several threads contending. The legacy allocator takes the
+ * mutex with a 0 timeout like the code it replaces did, under contention those calls fail instead of waiting.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cmsis_os2.h"
+#include "heap_api.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define BENCH_THREADS_MAX 4U
+#define BENCH_ROUNDS 200000U
+#define BENCH_WORKING_SET 12U
+#define BENCH_SIZE_MAX 256U
+
+/* 1 ns buckets up to 1 us, everything slower lands in the last one */
+#define LATENCY_BUCKETS 1001U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sBenchAllocator {
+    const char *name;
+    void *(*allocate) (const size_t number_of_elements, const size_t size);
+    bool (*free) (void *pointer_to_memory);
+} sBenchAllocator_t;
+
+typedef struct sLatency {
+    uint64_t buckets[LATENCY_BUCKETS];
+    uint64_t count;
+    uint64_t max_ns;
+    uint64_t failed;
+} sLatency_t;
+
+typedef struct sBenchThread {
+    const sBenchAllocator_t *allocator;
+    uint32_t seed;
+    sLatency_t allocate_latency;
+    sLatency_t free_latency;
+} sBenchThread_t;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void *Legacy_Heap_MemoryAllocate (const size_t number_of_elements, const size_t size);
+static bool Legacy_Heap_Free (void *pointer_to_memory);
+static void *Bench_HeapApiAllocate (const size_t number_of_elements, const size_t size);
+static uint64_t Bench_Nanoseconds (void);
+static void Bench_Record (sLatency_t *latency, const uint64_t ns);
+static void Bench_Merge (sLatency_t *total, const sLatency_t *latency);
+static uint64_t Bench_Percentile (const sLatency_t *latency, const double percentile);
+static void *Bench_Thread (void *arg);
+static void Bench_Report (const char *name, const size_t thread_count, const sLatency_t *allocate_latency, const sLatency_t *free_latency);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const osMutexAttr_t g_legacy_heap_mutex_attributes = {.name = "Legacy_Heap_mutex", .attr_bits = osMutexRecursive | osMutexPrioInherit, .cb_mem = NULL, .cb_size = 0U};
+
+static const sBenchAllocator_t g_allocators[] = {
+    {.name = "calloc + mutex (legacy)", .allocate = Legacy_Heap_MemoryAllocate, .free = Legacy_Heap_Free},
+    {.name = "Heap_API pools", .allocate = Bench_HeapApiAllocate, .free = Heap_API_Free}
+};
+
+static const size_t g_thread_counts[] = {1U, BENCH_THREADS_MAX};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static osMutexId_t g_legacy_heap_mutex = NULL;
+static uint64_t g_timer_overhead_ns = 0;
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Heap_API_MemoryAllocate and Heap_API_Free before the pools, MUTEX_TIMEOUT was 0 */
+static void *Legacy_Heap_MemoryAllocate (const size_t number_of_elements, const size_t size) {
+    if ((number_of_elements == 0) || (size == 0)) {
+        return NULL;
+    }
+
+    if (g_legacy_heap_mutex == NULL) {
+        return NULL;
+    }
+
+    if (osMutexAcquire(g_legacy_heap_mutex, 0U) != osOK) {
+        return NULL;
+    }
+
+    void *allocated_memory = calloc(number_of_elements, size);
+
+    osMutexRelease(g_legacy_heap_mutex);
+
+    return allocated_memory;
+}
+
+static bool Legacy_Heap_Free (void *pointer_to_memory) {
+    if (pointer_to_memory == NULL) {
+        return false;
+    }
+
+    if (osMutexAcquire(g_legacy_heap_mutex, 0U) != osOK) {
+        return false;
+    }
+
+    free(pointer_to_memory);
+
+    osMutexRelease(g_legacy_heap_mutex);
+
+    return true;
+}
+
+static void *Bench_HeapApiAllocate (const size_t number_of_elements, const size_t size) {
+    return Heap_API_Calloc(number_of_elements, size);
+}
+
+static uint64_t Bench_Nanoseconds (void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec);
+}
+
+static void Bench_Record (sLatency_t *latency, const uint64_t ns) {
+    uint64_t net_ns = (ns > g_timer_overhead_ns) ? (ns - g_timer_overhead_ns) : 0;
+
+    latency->buckets[(net_ns < (LATENCY_BUCKETS - 1U)) ? net_ns : (LATENCY_BUCKETS - 1U)]++;
+    latency->count++;
+
+    if (net_ns > latency->max_ns) {
+        latency->max_ns = net_ns;
+    }
+
+    return;
+}
+
+static void Bench_Merge (sLatency_t *total, const sLatency_t *latency) {
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        total->buckets[bucket] += latency->buckets[bucket];
+    }
+
+    total->count += latency->count;
+    total->failed += latency->failed;
+
+    if (latency->max_ns > total->max_ns) {
+        total->max_ns = latency->max_ns;
+    }
+
+    return;
+}
+
+static uint64_t Bench_Percentile (const sLatency_t *latency, const double percentile) {
+    uint64_t target = (uint64_t) ((double) latency->count * percentile);
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += latency->buckets[bucket];
+
+        if (seen > target) {
+            return (bucket < (LATENCY_BUCKETS - 1U)) ? bucket : latency->max_ns;
+        }
+    }
+
+    return latency->max_ns;
+}
+
+static void *Bench_Thread (void *arg) {
+    sBenchThread_t *thread = arg;
+    uint8_t *working_set[BENCH_WORKING_SET] = {NULL};
+    size_t sizes[BENCH_WORKING_SET] = {0};
+
+    for (size_t round = 0; round < BENCH_ROUNDS; round++) {
+        thread->seed = (thread->seed * 1103515245U) + 12345U;
+
+        size_t slot = (thread->seed >> 8) % BENCH_WORKING_SET;
+
+        if (working_set[slot] != NULL) {
+            /* The block still has to hold what was written into it */
+            if (working_set[slot][sizes[slot] - 1U] != (uint8_t) sizes[slot]) {
+                printf("FAIL: %s: block of %zu bytes corrupted\n", thread->allocator->name, sizes[slot]);
+                exit(1);
+            }
+
+            uint64_t start = Bench_Nanoseconds();
+            bool is_freed = thread->allocator->free(working_set[slot]);
+
+            Bench_Record(&thread->free_latency, Bench_Nanoseconds() - start);
+
+            if (!is_freed) {
+                /* Kept, it is freed on the next visit of the slot */
+                thread->free_latency.failed++;
+
+                continue;
+            }
+
+            working_set[slot] = NULL;
+        }
+
+        sizes[slot] = 1U + ((thread->seed >> 16) % BENCH_SIZE_MAX);
+
+        uint64_t start = Bench_Nanoseconds();
+
+        working_set[slot] = thread->allocator->allocate(1U, sizes[slot]);
+
+        Bench_Record(&thread->allocate_latency, Bench_Nanoseconds() - start);
+
+        if (working_set[slot] == NULL) {
+            thread->allocate_latency.failed++;
+
+            continue;
+        }
+
+        working_set[slot][sizes[slot] - 1U] = (uint8_t) sizes[slot];
+    }
+
+    /* The legacy free may fail under contention, retried until the working set is gone */
+    for (size_t slot = 0; slot < BENCH_WORKING_SET; slot++) {
+        while ((working_set[slot] != NULL) && !thread->allocator->free(working_set[slot])) {
+        }
+    }
+
+    return NULL;
+}
+
+static void Bench_Report (const char *name, const size_t thread_count, const sLatency_t *allocate_latency, const sLatency_t *free_latency) {
+    printf("%-24s %zu thread%s  alloc p50 %3lu  p99 %4lu  p99.9 %4lu  max %7lu ns, %6lu failed | free p50 %3lu  p99 %4lu  max %7lu ns, %6lu failed\n", name, thread_count, (thread_count == 1U) ? " " : "s", (unsigned long) Bench_Percentile(allocate_latency, 0.5), (unsigned long) Bench_Percentile(allocate_latency, 0.99), (unsigned long) Bench_Percentile(allocate_latency, 0.999), (unsigned long) allocate_latency->max_ns, (unsigned long) allocate_latency->failed, (unsigned long) Bench_Percentile(free_latency, 0.5), (unsigned long) Bench_Percentile(free_latency, 0.99), (unsigned long) free_latency->max_ns, (unsigned long) free_latency->failed);
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    static sBenchThread_t threads[BENCH_THREADS_MAX];
+
+    g_legacy_heap_mutex = osMutexNew(&g_legacy_heap_mutex_attributes);
+
+    if ((g_legacy_heap_mutex == NULL) || !Heap_API_Init()) {
+        printf("FAIL: heap not initialized\n");
+
+        return 1;
+    }
+
+    /* Cost of the two clock reads around each call, taken off every sample */
+    g_timer_overhead_ns = UINT64_MAX;
+
+    for (size_t i = 0; i < 10000U; i++) {
+        uint64_t start = Bench_Nanoseconds();
+        uint64_t overhead = Bench_Nanoseconds() - start;
+
+        if (overhead < g_timer_overhead_ns) {
+            g_timer_overhead_ns = overhead;
+        }
+    }
+
+    printf("%u rounds per thread, %u live blocks of 1 to %u bytes, %lu ns timer overhead removed\n", BENCH_ROUNDS, BENCH_WORKING_SET, BENCH_SIZE_MAX, (unsigned long) g_timer_overhead_ns);
+
+    for (size_t count = 0; count < (sizeof(g_thread_counts) / sizeof(g_thread_counts[0])); count++) {
+        for (size_t allocator = 0; allocator < (sizeof(g_allocators) / sizeof(g_allocators[0])); allocator++) {
+            sLatency_t allocate_latency = {0};
+            sLatency_t free_latency = {0};
+            pthread_t thread_ids[BENCH_THREADS_MAX];
+
+            for (size_t thread = 0; thread < g_thread_counts[count]; thread++) {
+                memset(&threads[thread], 0, sizeof(threads[thread]));
+                threads[thread].allocator = &g_allocators[allocator];
+                threads[thread].seed = 1U + (uint32_t) thread;
+
+                pthread_create(&thread_ids[thread], NULL, Bench_Thread, &threads[thread]);
+            }
+
+            for (size_t thread = 0; thread < g_thread_counts[count]; thread++) {
+                pthread_join(thread_ids[thread], NULL);
+
+                Bench_Merge(&allocate_latency, &threads[thread].allocate_latency);
+                Bench_Merge(&free_latency, &threads[thread].free_latency);
+            }
+
+            Bench_Report(g_allocators[allocator].name, g_thread_counts[count], &allocate_latency, &free_latency);
+        }
+    }
+
+    for (eHeapPool_t pool = (eHeapPool_First + 1); pool < eHeapPool_Last; pool++) {
+        sHeapPoolStats_t stats = {0};
+
+        if (Heap_API_GetPoolStats(pool, &stats) && (stats.in_use != 0)) {
+            printf("FAIL: pool of %zu byte blocks still has %zu in use\n", stats.block_size, stats.in_use);
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
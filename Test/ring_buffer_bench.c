@@ -0,0 +1,331 @@
+/**
+ * Host micro-benchmark of the per-byte cost of the ring buffer against the implementation it replaced.
+ *
+ * The legacy ring is the heap allocated one with a shared count and compare-and-reset wrapping, copied here with its
+ * functions kept out of line like the ones in ring_buffer.c. Every variant fills a ring and drains it again, pushes
+ * and pops are timed apart. Rings created with eRingBufferPolicy_Overwrite are measured on their own, their pop is a
+ * compare-and-swap.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "ring_buffer.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define BENCH_CAPACITY 256U
+#define BENCH_BLOCK_SIZE 32U
+#define BENCH_BYTES (32UL * 1024UL * 1024UL)
+#define BENCH_ROUNDS 3U
+
+#define NOINLINE __attribute__((noinline))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sLegacyRingBufferDesc {
+    size_t buffer_capacity;
+    size_t head;
+    size_t tail;
+    size_t count;
+    uint8_t *buffer;
+} sLegacyRingBufferDesc_t;
+
+typedef struct sBenchTime {
+    double push_seconds;
+    double pop_seconds;
+} sBenchTime_t;
+
+typedef uint32_t (*Bench_Fp_t) (sBenchTime_t *time);
+
+typedef struct sBenchCase {
+    const char *name;
+    Bench_Fp_t run;
+} sBenchCase_t;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static sLegacyRingBufferDesc_t *Legacy_Ring_Buffer_Init (size_t buffer_capacity);
+static bool Legacy_Ring_Buffer_IsFull (sLegacyRingBufferDesc_t *ring_buffer);
+static bool Legacy_Ring_Buffer_IsEmpty (sLegacyRingBufferDesc_t *ring_buffer);
+static bool Legacy_Ring_Buffer_Push (sLegacyRingBufferDesc_t *ring_buffer, uint8_t data);
+static bool Legacy_Ring_Buffer_Pop (sLegacyRingBufferDesc_t *ring_buffer, uint8_t *data);
+static uint32_t Bench_Legacy (sBenchTime_t *time);
+static uint32_t Bench_Bytes (RingBuffer_Handle ring_buffer, sBenchTime_t *time);
+static uint32_t Bench_HeapBytes (sBenchTime_t *time);
+static uint32_t Bench_StaticBytes (sBenchTime_t *time);
+static uint32_t Bench_OverwriteBytes (sBenchTime_t *time);
+static uint32_t Bench_StaticBlocks (sBenchTime_t *time);
+static double Bench_Seconds (void);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const sBenchCase_t g_bench_cases[] = {
+    {.name = "legacy Push/Pop (malloc, modulo)", .run = Bench_Legacy},
+    {.name = "Ring_Buffer_Init Push/Pop", .run = Bench_HeapBytes},
+    {.name = "RING_BUFFER_DEFINE Push/Pop", .run = Bench_StaticBytes},
+    {.name = "eRingBufferPolicy_Overwrite Push/Pop", .run = Bench_OverwriteBytes},
+    {.name = "RING_BUFFER_DEFINE PushBlock/PopBlock", .run = Bench_StaticBlocks}
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+RING_BUFFER_DEFINE(g_static_ring_buffer, BENCH_CAPACITY);
+RING_BUFFER_DEFINE_WITH_POLICY(g_overwrite_ring_buffer, BENCH_CAPACITY, eRingBufferPolicy_Overwrite);
+
+static sLegacyRingBufferDesc_t *g_legacy_ring_buffer = NULL;
+static RingBuffer_Handle g_heap_ring_buffer = NULL;
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static NOINLINE sLegacyRingBufferDesc_t *Legacy_Ring_Buffer_Init (size_t buffer_capacity) {
+    sLegacyRingBufferDesc_t *ring_buffer = malloc(sizeof(sLegacyRingBufferDesc_t));
+
+    if (ring_buffer == NULL) {
+        return NULL;
+    }
+
+    ring_buffer->buffer_capacity = buffer_capacity;
+    ring_buffer->buffer = malloc(buffer_capacity);
+
+    if (ring_buffer->buffer == NULL) {
+        free(ring_buffer);
+        return NULL;
+    }
+
+    ring_buffer->head = 0;
+    ring_buffer->tail = 0;
+    ring_buffer->count = 0;
+
+    return ring_buffer;
+}
+
+static NOINLINE bool Legacy_Ring_Buffer_IsFull (sLegacyRingBufferDesc_t *ring_buffer) {
+    if (ring_buffer != NULL) {
+        return ring_buffer->count == ring_buffer->buffer_capacity;
+    }
+
+    return false;
+}
+
+static NOINLINE bool Legacy_Ring_Buffer_IsEmpty (sLegacyRingBufferDesc_t *ring_buffer) {
+    if (ring_buffer != NULL) {
+        return ring_buffer->count == 0;
+    }
+
+    return false;
+}
+
+static NOINLINE bool Legacy_Ring_Buffer_Push (sLegacyRingBufferDesc_t *ring_buffer, uint8_t data) {
+    if (ring_buffer == NULL) {
+        return false;
+    }
+
+    ring_buffer->buffer[ring_buffer->head] = data;
+    ring_buffer->head++;
+
+    if (ring_buffer->count < ring_buffer->buffer_capacity) {
+        ring_buffer->count++;
+    }
+
+    if (ring_buffer->head == (ring_buffer->buffer_capacity)) {
+        ring_buffer->head = 0;
+    }
+
+    if (Legacy_Ring_Buffer_IsFull(ring_buffer)) {
+        ring_buffer->tail = ring_buffer->head;
+    }
+
+    return true;
+}
+
+static NOINLINE bool Legacy_Ring_Buffer_Pop (sLegacyRingBufferDesc_t *ring_buffer, uint8_t *data) {
+    if ((ring_buffer == NULL) || (data == NULL)) {
+        return false;
+    }
+
+    if (Legacy_Ring_Buffer_IsEmpty(ring_buffer)) {
+        return false;
+    }
+
+    *data = ring_buffer->buffer[ring_buffer->tail];
+    ring_buffer->tail++;
+
+    if (ring_buffer->count > 0) {
+        ring_buffer->count--;
+    }
+
+    if (ring_buffer->tail == (ring_buffer->buffer_capacity)) {
+        ring_buffer->tail = 0;
+    }
+
+    return true;
+}
+
+/* The legacy Push overwrites once full, the ring is never filled past its capacity so every variant does the same */
+static uint32_t Bench_Legacy (sBenchTime_t *time) {
+    uint32_t checksum = 0;
+    uint8_t data = 0;
+
+    for (size_t done = 0; done < BENCH_BYTES; done += BENCH_CAPACITY) {
+        double start = Bench_Seconds();
+
+        for (size_t i = 0; i < BENCH_CAPACITY; i++) {
+            Legacy_Ring_Buffer_Push(g_legacy_ring_buffer, (uint8_t) (done + i));
+        }
+
+        double pushed = Bench_Seconds();
+
+        while (Legacy_Ring_Buffer_Pop(g_legacy_ring_buffer, &data)) {
+            checksum += data;
+        }
+
+        time->push_seconds += pushed - start;
+        time->pop_seconds += Bench_Seconds() - pushed;
+    }
+
+    return checksum;
+}
+
+static uint32_t Bench_Bytes (RingBuffer_Handle ring_buffer, sBenchTime_t *time) {
+    uint32_t checksum = 0;
+    uint8_t data = 0;
+
+    for (size_t done = 0; done < BENCH_BYTES; done += BENCH_CAPACITY) {
+        double start = Bench_Seconds();
+
+        for (size_t i = 0; i < BENCH_CAPACITY; i++) {
+            Ring_Buffer_Push(ring_buffer, (uint8_t) (done + i));
+        }
+
+        double pushed = Bench_Seconds();
+
+        while (Ring_Buffer_Pop(ring_buffer, &data)) {
+            checksum += data;
+        }
+
+        time->push_seconds += pushed - start;
+        time->pop_seconds += Bench_Seconds() - pushed;
+    }
+
+    return checksum;
+}
+
+static uint32_t Bench_HeapBytes (sBenchTime_t *time) {
+    return Bench_Bytes(g_heap_ring_buffer, time);
+}
+
+static uint32_t Bench_StaticBytes (sBenchTime_t *time) {
+    return Bench_Bytes(&g_static_ring_buffer, time);
+}
+
+/* Pops with compare-and-swap since the producer may move the tail */
+static uint32_t Bench_OverwriteBytes (sBenchTime_t *time) {
+    return Bench_Bytes(&g_overwrite_ring_buffer, time);
+}
+
+static uint32_t Bench_StaticBlocks (sBenchTime_t *time) {
+    uint8_t block[BENCH_CAPACITY];
+    uint32_t checksum = 0;
+
+    for (size_t done = 0; done < BENCH_BYTES; done += BENCH_CAPACITY) {
+        for (size_t i = 0; i < BENCH_CAPACITY; i++) {
+            block[i] = (uint8_t) (done + i);
+        }
+
+        double start = Bench_Seconds();
+
+        for (size_t i = 0; i < BENCH_CAPACITY; i += BENCH_BLOCK_SIZE) {
+            Ring_Buffer_PushBlock(&g_static_ring_buffer, &block[i], BENCH_BLOCK_SIZE);
+        }
+
+        double pushed = Bench_Seconds();
+        size_t popped = 0;
+        size_t received = 0;
+
+        while ((popped = Ring_Buffer_PopBlock(&g_static_ring_buffer, &block[received], BENCH_BLOCK_SIZE)) > 0) {
+            received += popped;
+        }
+
+        time->push_seconds += pushed - start;
+        time->pop_seconds += Bench_Seconds() - pushed;
+
+        for (size_t i = 0; i < received; i++) {
+            checksum += block[i];
+        }
+    }
+
+    return checksum;
+}
+
+static double Bench_Seconds (void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double) now.tv_sec + ((double) now.tv_nsec / 1e9));
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    uint32_t expected = 0;
+    sBenchTime_t legacy = {0};
+
+    g_legacy_ring_buffer = Legacy_Ring_Buffer_Init(BENCH_CAPACITY);
+    g_heap_ring_buffer = Ring_Buffer_Init(BENCH_CAPACITY);
+
+    if ((g_legacy_ring_buffer == NULL) || (g_heap_ring_buffer == NULL)) {
+        printf("FAIL: rings not created\n");
+
+        return 1;
+    }
+
+    printf("%-38s %14s %14s\n", "ns/byte (x legacy)", "push", "pop");
+
+    for (size_t bench = 0; bench < (sizeof(g_bench_cases) / sizeof(g_bench_cases[0])); bench++) {
+        sBenchTime_t best = {0};
+        uint32_t checksum = 0;
+
+        /* The fastest round is the one least disturbed by the host */
+        for (size_t round = 0; round < BENCH_ROUNDS; round++) {
+            sBenchTime_t time = {0};
+
+            checksum = g_bench_cases[bench].run(&time);
+
+            if ((round == 0) || ((time.push_seconds + time.pop_seconds) < (best.push_seconds + best.pop_seconds))) {
+                best = time;
+            }
+        }
+
+        if (bench == 0) {
+            expected = checksum;
+            legacy = best;
+        }
+
+        printf("%-38s %6.2f (%4.2fx) %6.2f (%4.2fx)%s\n", g_bench_cases[bench].name, (best.push_seconds * 1e9) / (double) BENCH_BYTES, legacy.push_seconds / best.push_seconds, (best.pop_seconds * 1e9) / (double) BENCH_BYTES, legacy.pop_seconds / best.pop_seconds, (checksum == expected) ? "" : ", CHECKSUM MISMATCH");
+
+        if (checksum != expected) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+/**
+ * Host stress test and throughput benchmark of the SPSC ring buffer.
+ *
+ * A producer thread pushes a counter pattern while the consumer thread pops and checks it, once byte by byte, once in
+ * blocks and once mixing both with odd sizes. The pattern mixes in the higher counter bits so a byte lost a whole lap
+ * is caught as well. Both ring policies are run, the overwrite one pops with compare-and-swap. Each run reports
+ * bytes/s, any lost or corrupted byte fails the test.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include "ring_buffer.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define STRESS_BYTES (16UL * 1024UL * 1024UL)
+#define BLOCK_MAX_SIZE 64U
+
+#define PATTERN(i) ((uint8_t) ((i) ^ ((i) >> 8) ^ ((i) >> 16)))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef enum eStressMode {
+    eStressMode_First = 0,
+    eStressMode_Byte = eStressMode_First,
+    eStressMode_Block,
+    eStressMode_Mixed,
+    eStressMode_Last
+} eStressMode_t;
+
+typedef struct sStressRun {
+    RingBuffer_Handle ring_buffer;
+    eStressMode_t mode;
+} sStressRun_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const char *g_mode_names[eStressMode_Last] = {
+    [eStressMode_Byte] = "byte",
+    [eStressMode_Block] = "block",
+    [eStressMode_Mixed] = "mixed"
+};
+
+static const char *g_policy_names[eRingBufferPolicy_Last] = {
+    [eRingBufferPolicy_Reject] = "reject",
+    [eRingBufferPolicy_Overwrite] = "overwrite"
+};
+
+static const size_t g_capacities[] = {16U, 256U, 4096U};
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static size_t Stress_BlockSize (const eStressMode_t mode, const size_t index);
+static void *Stress_Producer (void *arg);
+static size_t Stress_Consume (const sStressRun_t *run);
+static double Stress_Seconds (void);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Size 0 stands for a single Push or Pop, mixed mode cycles through every size from 0 to BLOCK_MAX_SIZE */
+static size_t Stress_BlockSize (const eStressMode_t mode, const size_t index) {
+    switch (mode) {
+        case eStressMode_Block: {
+            return BLOCK_MAX_SIZE;
+        }
+        case eStressMode_Mixed: {
+            return ((index * 7U) % (BLOCK_MAX_SIZE + 1U));
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+static void *Stress_Producer (void *arg) {
+    const sStressRun_t *run = arg;
+    uint8_t block[BLOCK_MAX_SIZE];
+    size_t sent = 0;
+    size_t round = 0;
+
+    while (sent < STRESS_BYTES) {
+        size_t size = Stress_BlockSize(run->mode, round++);
+
+        if (size == 0) {
+            if (Ring_Buffer_Push(run->ring_buffer, PATTERN(sent))) {
+                sent++;
+            } else {
+                sched_yield();
+            }
+
+            continue;
+        }
+
+        if (size > (STRESS_BYTES - sent)) {
+            size = STRESS_BYTES - sent;
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            block[i] = PATTERN(sent + i);
+        }
+
+        size_t pushed = Ring_Buffer_PushBlock(run->ring_buffer, block, size);
+
+        if (pushed == 0) {
+            sched_yield();
+        }
+
+        sent += pushed;
+    }
+
+    return NULL;
+}
+
+/* Returns the number of bytes received before the first mismatch */
+static size_t Stress_Consume (const sStressRun_t *run) {
+    uint8_t block[BLOCK_MAX_SIZE];
+    size_t received = 0;
+    size_t round = 0;
+
+    while (received < STRESS_BYTES) {
+        /* The consumer uses a different size sequence than the producer so the spans do not line up */
+        size_t size = Stress_BlockSize(run->mode, round++ + 3U);
+
+        if (size == 0) {
+            uint8_t byte = 0;
+
+            if (!Ring_Buffer_Pop(run->ring_buffer, &byte)) {
+                sched_yield();
+
+                continue;
+            }
+
+            if (byte != PATTERN(received)) {
+                return received;
+            }
+
+            received++;
+
+            continue;
+        }
+
+        size_t popped = Ring_Buffer_PopBlock(run->ring_buffer, block, size);
+
+        if (popped == 0) {
+            sched_yield();
+        }
+
+        for (size_t i = 0; i < popped; i++) {
+            if (block[i] != PATTERN(received + i)) {
+                return (received + i);
+            }
+        }
+
+        received += popped;
+    }
+
+    return received;
+}
+
+static double Stress_Seconds (void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double) now.tv_sec + ((double) now.tv_nsec / 1e9));
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    bool has_failed = false;
+
+    for (eRingBufferPolicy_t policy = eRingBufferPolicy_First; policy < eRingBufferPolicy_Last; policy++) {
+        for (size_t capacity = 0; capacity < (sizeof(g_capacities) / sizeof(g_capacities[0])); capacity++) {
+            for (eStressMode_t mode = eStressMode_First; mode < eStressMode_Last; mode++) {
+                sStressRun_t run = {.ring_buffer = Ring_Buffer_InitWithPolicy(g_capacities[capacity], policy), .mode = mode};
+                pthread_t producer;
+
+                if (run.ring_buffer == NULL) {
+                    printf("FAIL: ring of %zu bytes not created\n", g_capacities[capacity]);
+
+                    return 1;
+                }
+
+                double start = Stress_Seconds();
+
+                pthread_create(&producer, NULL, Stress_Producer, &run);
+
+                size_t received = Stress_Consume(&run);
+
+                if (received < STRESS_BYTES) {
+                    /* The producer may be stuck on a full ring, it is not joined */
+                    printf("FAIL: %s, capacity %zu, %s: byte %zu does not match\n", g_policy_names[policy], g_capacities[capacity], g_mode_names[mode], received);
+
+                    return 1;
+                }
+
+                pthread_join(producer, NULL);
+
+                double seconds = Stress_Seconds() - start;
+
+                printf("%-9s capacity %4zu, %-5s: %lu bytes in %.3f s, %7.1f MB/s, %s\n", g_policy_names[policy], g_capacities[capacity], g_mode_names[mode], STRESS_BYTES, seconds, ((double) STRESS_BYTES / seconds) / 1e6, Ring_Buffer_IsEmpty(run.ring_buffer) ? "empty" : "NOT EMPTY");
+
+                if (!Ring_Buffer_IsEmpty(run.ring_buffer)) {
+                    has_failed = true;
+                }
+
+                Ring_Buffer_DeInit(run.ring_buffer);
+            }
+        }
+    }
+
+    if (has_failed) {
+        printf("FAIL\n");
+
+        return 1;
+    }
+
+    printf("pass\n");
+
+    return 0;
+}
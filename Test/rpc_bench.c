@@ -0,0 +1,386 @@
+/**
+ * Host benchmark of the binary RPC path: request COBS decode, CMD_API_Rpc_Decode, CMD_API_Rpc_Execute with the reply
+ * streamed through a writer sink, CMD_API_Rpc_Encode and COBS_Encode of every reply frame, like CLI_APP_Rpc_Handle.
+ *
+ * Every reply is decoded again and checked: the frames but the last have CMD_RPC_FLAG_MORE set, the text put together
+ * matches what the handler wrote and the last frame carries the status. The CPU time per request is measured and the
+ * request rate the wire allows is worked out from the frame sizes, one request at a time and pipelined.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cmd_api.h"
+#include "cobs.h"
+#include "crc.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/* RESPONSE_MESSAGE_CAPACITY of the example config */
+#define BENCH_RESPONSE_CAPACITY 128U
+#define BENCH_RECORD_SIZE CMD_RPC_RESPONSE_MAX_SIZE(BENCH_RESPONSE_CAPACITY)
+#define BENCH_FRAME_SIZE (COBS_ENCODED_MAX_SIZE(BENCH_RECORD_SIZE) + 2U)
+#define BENCH_REQUEST_SIZE 128U
+#define BENCH_TEXT_SIZE 2048U
+#define BENCH_REQUESTS 200000UL
+/* Start and stop bit */
+#define BENCH_BITS_PER_BYTE 10U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sBenchCase {
+    const char *name;
+    uint16_t command_id;
+    uint32_t argument;
+    const char *text;
+    size_t argument_count;
+} sBenchCase_t;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static bool Bench_ReplyHandler (const sCmdArgs_t *arguments, sCmdWriter_t *response);
+static bool Bench_TextHandler (sMessage_t arguments, sMessage_t *response);
+static size_t Bench_EncodeRequest (const sBenchCase_t *bench_case, uint8_t *frame);
+static bool Bench_Sink (const char *data, const size_t size);
+static bool Bench_SendFrame (const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length);
+static void Bench_Handle (const uint8_t *frame, const size_t frame_size);
+static bool Bench_CheckReply (const eCmdRpcStatus_t expected_status, const char *expected_text);
+static double Bench_Seconds (void);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const sCmdArgDesc_t g_reply_arguments[] = {
+    CMD_ARG_UINT("bytes", 0, BENCH_TEXT_SIZE / 2U)
+};
+
+static const sBenchCase_t g_cases[] = {
+    {.name = "link check", .command_id = CMD_RPC_PING_ID},
+    {.name = "typed, no reply", .command_id = 1, .argument = 0, .argument_count = 1},
+    {.name = "typed, 100 B reply", .command_id = 1, .argument = 100, .argument_count = 1},
+    {.name = "typed, 600 B reply", .command_id = 1, .argument = 600, .argument_count = 1},
+    {.name = "text, 40 B reply", .command_id = 2, .text = " 40"},
+    {.name = "bad arguments", .command_id = 1, .argument = BENCH_TEXT_SIZE, .argument_count = 1}
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static sCmdDesc_t g_commands[] = {
+    {0},
+    {.command = "reply", .typed_handler = Bench_ReplyHandler, CMD_ARGUMENTS(g_reply_arguments)},
+    {.command = "text", .handler = Bench_TextHandler}
+};
+
+static char g_response_buffer[BENCH_RESPONSE_CAPACITY];
+static sCmdWriter_t g_response = {0};
+static uint16_t g_sequence = 0;
+static uint8_t g_record[BENCH_RECORD_SIZE];
+static uint8_t g_frame[BENCH_FRAME_SIZE];
+
+/* What the handlers wrote and what went out */
+static char g_expected_text[BENCH_TEXT_SIZE];
+static size_t g_expected_length = 0;
+static uint8_t g_wire[BENCH_TEXT_SIZE * 2U];
+static size_t g_wire_length = 0;
+static size_t g_frames = 0;
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Writes as many bytes of text as the argument asks for, in lines like the stats commands */
+static bool Bench_ReplyHandler (const sCmdArgs_t *arguments, sCmdWriter_t *response) {
+    size_t remaining = arguments->value[0].uint_value;
+
+    g_expected_length = 0;
+
+    while (remaining > 0) {
+        char line[32];
+        size_t length = (remaining < 20U) ? remaining : 20U;
+
+        snprintf(line, sizeof(line), "%0*zu", (int) length, remaining);
+
+        if (length > 1U) {
+            line[length - 1U] = '\n';
+        }
+
+        CMD_API_Writer_Printf(response, "%s", line);
+
+        memcpy(&g_expected_text[g_expected_length], line, length);
+        g_expected_length += length;
+        remaining -= length;
+    }
+
+    g_expected_text[g_expected_length] = '\0';
+
+    return true;
+}
+
+/* The argument text is the reply length */
+static bool Bench_TextHandler (sMessage_t arguments, sMessage_t *response) {
+    size_t length = 0;
+
+    for (size_t position = 0; position < arguments.size; position++) {
+        if ((arguments.data[position] >= '0') && (arguments.data[position] <= '9')) {
+            length = (length * 10U) + (size_t) (arguments.data[position] - '0');
+        }
+    }
+
+    if (length >= response->size) {
+        return false;
+    }
+
+    memset(response->data, 't', length);
+    response->data[length] = '\0';
+
+    memcpy(g_expected_text, response->data, length + 1U);
+    g_expected_length = length;
+
+    return true;
+}
+
+/* What Tools/cli_rpc.py sends, without the delimiters */
+static size_t Bench_EncodeRequest (const sBenchCase_t *bench_case, uint8_t *frame) {
+    uint8_t record[BENCH_REQUEST_SIZE];
+    size_t length = 0;
+
+    record[length++] = CMD_RPC_REQUEST_TAG;
+    record[length++] = (uint8_t) g_sequence;
+    record[length++] = (uint8_t) (g_sequence >> 8);
+    record[length++] = (uint8_t) bench_case->command_id;
+    record[length++] = (uint8_t) (bench_case->command_id >> 8);
+    record[length++] = (uint8_t) bench_case->argument_count;
+
+    for (size_t argument = 0; argument < bench_case->argument_count; argument++) {
+        for (size_t byte = 0; byte < sizeof(uint32_t); byte++) {
+            record[length++] = (uint8_t) (bench_case->argument >> (8U * byte));
+        }
+    }
+
+    if (bench_case->text != NULL) {
+        memcpy(&record[length], bench_case->text, strlen(bench_case->text));
+        length += strlen(bench_case->text);
+    }
+
+    uint16_t crc = CRC16_Update(CRC16_INITIAL_VALUE, record, length);
+
+    record[length++] = (uint8_t) crc;
+    record[length++] = (uint8_t) (crc >> 8);
+
+    return COBS_Encode(record, length, frame, BENCH_REQUEST_SIZE);
+}
+
+static bool Bench_Sink (const char *data, const size_t size) {
+    return Bench_SendFrame(eCmdRpcStatus_Ok, true, data, size);
+}
+
+/* CLI_APP_Rpc_SendFrame, the frame goes to g_wire instead of the UART */
+static bool Bench_SendFrame (const eCmdRpcStatus_t status, const bool has_more, const char *text, const size_t text_length) {
+    size_t record_length = CMD_API_Rpc_Encode(g_sequence, status, has_more, text, text_length, g_record, sizeof(g_record));
+
+    if (record_length == 0) {
+        return false;
+    }
+
+    size_t frame_length = 0;
+
+    g_frame[frame_length++] = COBS_DELIMITER;
+    frame_length += COBS_Encode(g_record, record_length, &g_frame[frame_length], (sizeof(g_frame) - frame_length - 1U));
+    g_frame[frame_length++] = COBS_DELIMITER;
+
+    if ((g_wire_length + frame_length) > sizeof(g_wire)) {
+        return false;
+    }
+
+    memcpy(&g_wire[g_wire_length], g_frame, frame_length);
+    g_wire_length += frame_length;
+    g_frames++;
+
+    return true;
+}
+
+/* UART_API COBS reception and CLI_APP_Rpc_Handle */
+static void Bench_Handle (const uint8_t *frame, const size_t frame_size) {
+    char message[BENCH_REQUEST_SIZE];
+    size_t message_size = 0;
+    sCobsDecoder_t decoder = {0};
+
+    COBS_Decoder_Reset(&decoder);
+
+    for (size_t position = 0; position <= frame_size; position++) {
+        uint8_t byte = 0;
+
+        if (COBS_Decoder_Push(&decoder, (position < frame_size) ? frame[position] : COBS_DELIMITER, &byte) == eCobsDecode_Byte) {
+            message[message_size++] = (char) byte;
+        }
+    }
+
+    sCmdRpcRequest_t request = {0};
+    eCmdRpcStatus_t status = CMD_API_Rpc_Decode((const uint8_t*) message, message_size, &request);
+
+    g_wire_length = 0;
+    g_frames = 0;
+    CMD_API_Writer_Reset(&g_response);
+
+    if ((status == eCmdRpcStatus_Ok) && (request.command_id != CMD_RPC_PING_ID)) {
+        request.text.data[request.text.size] = '\0';
+
+        status = CMD_API_Rpc_Execute(&g_commands[request.command_id], &request, &g_response);
+    }
+
+    Bench_SendFrame(status, false, g_response.buffer, g_response.length);
+
+    return;
+}
+
+/* Decodes g_wire the way Tools/cli_rpc.py does */
+static bool Bench_CheckReply (const eCmdRpcStatus_t expected_status, const char *expected_text) {
+    static char text[BENCH_TEXT_SIZE];
+    uint8_t record[BENCH_RECORD_SIZE];
+    size_t text_length = 0;
+    size_t record_length = 0;
+    size_t frames = 0;
+    sCobsDecoder_t decoder = {0};
+
+    COBS_Decoder_Reset(&decoder);
+
+    for (size_t position = 0; position < g_wire_length; position++) {
+        uint8_t byte = 0;
+        eCobsDecode_t result = COBS_Decoder_Push(&decoder, g_wire[position], &byte);
+
+        if (result == eCobsDecode_Byte) {
+            if (record_length == sizeof(record)) {
+                return false;
+            }
+
+            record[record_length++] = byte;
+
+            continue;
+        }
+
+        if ((result != eCobsDecode_FrameEnd) || (record_length == 0)) {
+            continue;
+        }
+
+        if (record_length < (CMD_RPC_RESPONSE_HEADER_SIZE + CMD_RPC_CRC_SIZE)) {
+            return false;
+        }
+
+        size_t payload_size = record_length - CMD_RPC_CRC_SIZE;
+        uint16_t crc = (uint16_t) (record[payload_size] | (record[payload_size + 1U] << 8));
+        bool is_last = (position + 1U) == g_wire_length;
+
+        if ((record[0] != CMD_RPC_RESPONSE_TAG) || (CRC16_Update(CRC16_INITIAL_VALUE, record, payload_size) != crc)) {
+            return false;
+        }
+
+        if (((record[1] | (record[2] << 8)) != g_sequence) || (((record[4] & CMD_RPC_FLAG_MORE) == 0) != is_last)) {
+            return false;
+        }
+
+        if ((is_last && (record[3] != expected_status)) || (!is_last && (record[3] != eCmdRpcStatus_Ok))) {
+            return false;
+        }
+
+        memcpy(&text[text_length], &record[CMD_RPC_RESPONSE_HEADER_SIZE], payload_size - CMD_RPC_RESPONSE_HEADER_SIZE);
+        text_length += payload_size - CMD_RPC_RESPONSE_HEADER_SIZE;
+        record_length = 0;
+        frames++;
+    }
+
+    text[text_length] = '\0';
+
+    if ((frames != g_frames) || (expected_text == NULL)) {
+        return expected_text == NULL;
+    }
+
+    return strcmp(text, expected_text) == 0;
+}
+
+static double Bench_Seconds (void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double) now.tv_sec + ((double) now.tv_nsec / 1e9));
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    const uint32_t baudrates[] = {115200U, 921600U};
+
+    CMD_API_Writer_Init(&g_response, g_response_buffer, sizeof(g_response_buffer), Bench_Sink);
+
+    printf("%-20s %7s %7s %6s %9s", "request", "req B", "reply B", "frames", "us/req");
+
+    for (size_t baudrate = 0; baudrate < (sizeof(baudrates) / sizeof(baudrates[0])); baudrate++) {
+        printf("  %6lu req/s, pipelined", (unsigned long) baudrates[baudrate]);
+    }
+
+    printf("\n");
+
+    for (size_t bench_case = 0; bench_case < (sizeof(g_cases) / sizeof(g_cases[0])); bench_case++) {
+        const sBenchCase_t *current = &g_cases[bench_case];
+        uint8_t request[BENCH_REQUEST_SIZE];
+
+        g_sequence = (uint16_t) (bench_case + 1U);
+        g_expected_length = 0;
+        g_expected_text[0] = '\0';
+
+        size_t request_length = Bench_EncodeRequest(current, request);
+
+        Bench_Handle(request, request_length);
+
+        bool is_rejected = (current->argument_count > 0) && (current->argument > (BENCH_TEXT_SIZE / 2U));
+        eCmdRpcStatus_t expected_status = is_rejected ? eCmdRpcStatus_Arguments : eCmdRpcStatus_Ok;
+
+        if (!Bench_CheckReply(expected_status, is_rejected ? NULL : g_expected_text)) {
+            printf("FAIL: %s: reply frames do not match\n", current->name);
+
+            return 1;
+        }
+
+        size_t reply_length = g_wire_length;
+        size_t frames = g_frames;
+        double start = Bench_Seconds();
+
+        for (size_t repeat = 0; repeat < BENCH_REQUESTS; repeat++) {
+            Bench_Handle(request, request_length);
+        }
+
+        double seconds = Bench_Seconds() - start;
+        /* Two delimiters around the request on the wire */
+        size_t request_wire = request_length + 2U;
+        size_t longer = (request_wire > reply_length) ? request_wire : reply_length;
+
+        printf("%-20s %7zu %7zu %6zu %9.2f", current->name, request_wire, reply_length, frames, (seconds * 1e6) / (double) BENCH_REQUESTS);
+
+        for (size_t baudrate = 0; baudrate < (sizeof(baudrates) / sizeof(baudrates[0])); baudrate++) {
+            double bytes_per_second = (double) baudrates[baudrate] / BENCH_BITS_PER_BYTE;
+
+            printf("  %12.0f %11.0f", bytes_per_second / (double) (request_wire + reply_length), bytes_per_second / (double) longer);
+        }
+
+        printf("\n");
+    }
+
+    printf("pass\n");
+
+    return 0;
+}
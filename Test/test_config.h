@@ -0,0 +1,21 @@
+#ifndef TEST_TEST_CONFIG_H_
+#define TEST_TEST_CONFIG_H_
+
+/* Project config of the host builds, only what the modules under test read */
+
+#define SYSTEM_CLOCK_HZ 100000000UL
+
+#define HEAP_POOL_16_BLOCKS 64
+#define HEAP_POOL_32_BLOCKS 64
+#define HEAP_POOL_64_BLOCKS 64
+#define HEAP_POOL_128_BLOCKS 64
+#define HEAP_POOL_256_BLOCKS 64
+
+#define ENABLE_CLI
+
+#define RUN_TIME_STATS_MAX_THREADS 8
+#define RUN_TIME_STATS_COUNTER_SHIFT 4
+#define RUN_TIME_STATS_WINDOW_MS 2000
+#define RUN_TIME_STATS_WINDOW_SLOTS 4
+
+#endif /* TEST_TEST_CONFIG_H_ */
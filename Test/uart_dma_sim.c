@@ -0,0 +1,421 @@
+/**
+ * Host simulation of circular DMA reception into the ring buffer through Ring_Buffer_SyncHead.
+ *
+ * The DMA model writes the ring storage at (capacity - NDTR), reloads NDTR after the last byte and raises HT and TC.
+ * The sync, TC and transfer error paths run through uart_rx_ring.c, the code UART_Driver_RxDmaPublish and
+ * UART_Driver_RxDmaRestart call, only the event dispatch of UART_Driver_RxDmaCallback is repeated here. The consumer
+ * checks every byte against the write count it was stored at, bytes may only go missing where Ring_Buffer_SyncHead
+ * reported an overrun or the stream was restarted.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include "ring_buffer.h"
+#include "uart_rx_ring.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define RX_CAPACITY 64U
+#define RANDOM_STEPS 2000000UL
+
+#define PATTERN(count) ((uint8_t) ((count) ^ ((count) >> 8) ^ ((count) >> 16) ^ 0x5AU))
+
+#define SIM_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL: %s:%d: %s\n", __func__, __LINE__, #condition); \
+            return false; \
+        } \
+    } while (0)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef bool (*Sim_Fp_t) (void);
+
+typedef struct sSimCase {
+    const char *name;
+    Sim_Fp_t run;
+} sSimCase_t;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Reset (void);
+static size_t Sim_DmaWrite (const size_t size);
+static void Sim_RxDmaSync (const bool is_lap_complete);
+static void Sim_DmaEvents (void);
+static void Sim_RxDmaRestart (void);
+static bool Sim_Consume (const size_t size, size_t *received);
+static uint32_t Sim_Random (void);
+static bool Sim_HalfAndFullLaps (void);
+static bool Sim_FullLapBetweenSyncs (void);
+static bool Sim_SyncWithTcPending (void);
+static bool Sim_Overrun (void);
+static bool Sim_OverrunWhileReading (void);
+static bool Sim_TransferErrorRestart (void);
+static bool Sim_RandomTraffic (void);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const sSimCase_t g_sim_cases[] = {
+    {.name = "HT and TC every half lap", .run = Sim_HalfAndFullLaps},
+    {.name = "full lap between two syncs", .run = Sim_FullLapBetweenSyncs},
+    {.name = "IDLE sync with TC pending", .run = Sim_SyncWithTcPending},
+    {.name = "overrun keeps the newest lap", .run = Sim_Overrun},
+    {.name = "overrun while the consumer reads", .run = Sim_OverrunWhileReading},
+    {.name = "transfer error restart", .run = Sim_TransferErrorRestart},
+    {.name = "random traffic", .run = Sim_RandomTraffic}
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+RING_BUFFER_DEFINE_WITH_POLICY(g_rx_ring_buffer, RX_CAPACITY, eRingBufferPolicy_Overwrite);
+
+/* The DMA stream */
+static size_t g_ndtr = RX_CAPACITY;
+static size_t g_written = 0;
+static bool g_is_ht_pending = false;
+static bool g_is_tc_pending = false;
+
+/* sUartDynamicDesc_t */
+static sUartRxDma_t g_rx_dma = {0};
+static size_t g_ring_overflows = 0;
+
+/* The write count of the oldest byte the consumer may still see, moved by overruns and restarts */
+static size_t g_oldest_intact = 0;
+static size_t g_expected = 0;
+static size_t g_published = 0;
+static size_t g_lapped_reads = 0;
+static uint32_t g_random = 12345U;
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Reset (void) {
+    UART_Rx_Ring_DmaStart(&g_rx_dma, &g_rx_ring_buffer);
+
+    g_written = g_rx_dma.lap;
+    g_ndtr = RX_CAPACITY;
+    g_is_ht_pending = false;
+    g_is_tc_pending = false;
+    g_ring_overflows = 0;
+    g_oldest_intact = g_rx_dma.lap;
+    g_expected = g_rx_dma.lap;
+    g_published = 0;
+    g_lapped_reads = 0;
+
+    return;
+}
+
+/* Stops early where it would raise an event while the same one is still pending, the DMA IRQ is never a lap late */
+static size_t Sim_DmaWrite (const size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if ((g_is_ht_pending || g_is_tc_pending) && ((g_ndtr == ((RX_CAPACITY / 2) + 1)) || (g_ndtr == 1))) {
+            return i;
+        }
+
+        Ring_Buffer_GetStorage(&g_rx_ring_buffer)[RX_CAPACITY - g_ndtr] = PATTERN(g_written);
+        g_written++;
+        g_ndtr--;
+
+        if (g_ndtr == (RX_CAPACITY / 2)) {
+            g_is_ht_pending = true;
+        }
+
+        if (g_ndtr == 0) {
+            g_ndtr = RX_CAPACITY;
+            g_is_tc_pending = true;
+        }
+    }
+
+    return size;
+}
+
+/* UART_Driver_RxDmaPublish */
+static void Sim_RxDmaSync (const bool is_lap_complete) {
+    bool is_overrun = false;
+
+    g_published += UART_Rx_Ring_DmaSync(&g_rx_dma, g_ndtr, is_lap_complete, &is_overrun);
+
+    if (is_overrun) {
+        g_ring_overflows++;
+        g_oldest_intact = g_rx_dma.count - RX_CAPACITY;
+    }
+
+    return;
+}
+
+/* DMAx_Streamx_ISRHandler, TC is handled before HT */
+static void Sim_DmaEvents (void) {
+    if (g_is_tc_pending) {
+        g_is_tc_pending = false;
+
+        Sim_RxDmaSync(true);
+    }
+
+    if (g_is_ht_pending) {
+        g_is_ht_pending = false;
+
+        Sim_RxDmaSync(false);
+    }
+
+    return;
+}
+
+/* UART_Driver_RxDmaRestart, the stream starts over at the first storage byte */
+static void Sim_RxDmaRestart (void) {
+    g_is_ht_pending = false;
+    g_is_tc_pending = false;
+    g_ndtr = RX_CAPACITY;
+
+    UART_Rx_Ring_DmaRestart(&g_rx_dma);
+
+    g_written = g_rx_dma.lap;
+    g_oldest_intact = g_rx_dma.lap;
+
+    return;
+}
+
+/**
+ * Returns false on a byte that does not match its write count. A byte the DMA already overwrote before the sync that
+ * reports the overrun comes from the newer lap, that can not be told apart in the ring and is only counted.
+ */
+static bool Sim_Consume (const size_t size, size_t *received) {
+    uint8_t block[RX_CAPACITY];
+
+    *received = Ring_Buffer_PopBlock(&g_rx_ring_buffer, block, (size < RX_CAPACITY) ? size : RX_CAPACITY);
+
+    if ((*received > 0) && (g_expected < g_oldest_intact)) {
+        g_expected = g_oldest_intact;
+    }
+
+    for (size_t i = 0; i < *received; i++) {
+        SIM_CHECK(g_expected < g_written);
+
+        if ((g_written - g_expected) > RX_CAPACITY) {
+            g_lapped_reads++;
+        } else {
+            SIM_CHECK(block[i] == PATTERN(g_expected));
+        }
+
+        g_expected++;
+    }
+
+    return true;
+}
+
+static uint32_t Sim_Random (void) {
+    g_random = (g_random * 1103515245U) + 12345U;
+
+    return (g_random >> 8);
+}
+
+static bool Sim_HalfAndFullLaps (void) {
+    size_t received = 0;
+
+    for (size_t lap = 0; lap < 8; lap++) {
+        SIM_CHECK(Sim_DmaWrite(RX_CAPACITY / 2) == (RX_CAPACITY / 2));
+        Sim_DmaEvents();
+        SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+        SIM_CHECK(received == (RX_CAPACITY / 2));
+    }
+
+    SIM_CHECK(g_ring_overflows == 0);
+
+    return true;
+}
+
+static bool Sim_FullLapBetweenSyncs (void) {
+    size_t received = 0;
+
+    /* The HT is lost, the TC alone publishes the whole lap and the ring is full, not overrun */
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    g_is_ht_pending = false;
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    Sim_DmaEvents();
+
+    SIM_CHECK(g_published == RX_CAPACITY);
+    SIM_CHECK(Ring_Buffer_IsFull(&g_rx_ring_buffer));
+    SIM_CHECK(g_ring_overflows == 0);
+    SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+    SIM_CHECK(received == RX_CAPACITY);
+
+    return true;
+}
+
+static bool Sim_SyncWithTcPending (void) {
+    size_t received = 0;
+
+    Sim_DmaWrite((RX_CAPACITY / 2) + 10);
+    Sim_DmaEvents();
+    SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+
+    /* NDTR wrapped but the TC is not handled yet, an IDLE sync lands in the next lap */
+    Sim_DmaWrite((RX_CAPACITY / 2) - 10 + 5);
+    SIM_CHECK(g_is_tc_pending);
+    Sim_RxDmaSync(false);
+    SIM_CHECK(Ring_Buffer_GetCount(&g_rx_ring_buffer) == ((RX_CAPACITY / 2) - 10 + 5));
+
+    /* The TC handler must not publish the lap a second time */
+    Sim_DmaEvents();
+    SIM_CHECK(Ring_Buffer_GetCount(&g_rx_ring_buffer) == ((RX_CAPACITY / 2) - 10 + 5));
+    SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+    SIM_CHECK(received == ((RX_CAPACITY / 2) - 10 + 5));
+    SIM_CHECK(g_ring_overflows == 0);
+
+    return true;
+}
+
+static bool Sim_Overrun (void) {
+    size_t received = 0;
+
+    Sim_DmaWrite(RX_CAPACITY / 4);
+    Sim_DmaEvents();
+
+    /* Nobody reads for two and a half laps */
+    for (size_t i = 0; i < 5; i++) {
+        Sim_DmaWrite(RX_CAPACITY / 2);
+        Sim_DmaEvents();
+    }
+
+    SIM_CHECK(g_ring_overflows > 0);
+    SIM_CHECK(Ring_Buffer_GetCount(&g_rx_ring_buffer) == RX_CAPACITY);
+    SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+    SIM_CHECK(received == RX_CAPACITY);
+    SIM_CHECK(g_expected == g_written);
+
+    return true;
+}
+
+static bool Sim_OverrunWhileReading (void) {
+    size_t received = 0;
+
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    Sim_DmaEvents();
+    SIM_CHECK(Sim_Consume(5, &received));
+
+    /* The consumer is part way through the ring when the DMA laps it */
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    Sim_DmaEvents();
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    Sim_DmaEvents();
+
+    SIM_CHECK(g_ring_overflows == 1);
+
+    while (true) {
+        SIM_CHECK(Sim_Consume(7, &received));
+
+        if (received == 0) {
+            break;
+        }
+    }
+
+    SIM_CHECK(g_expected == g_written);
+
+    return true;
+}
+
+static bool Sim_TransferErrorRestart (void) {
+    size_t received = 0;
+
+    Sim_DmaWrite((RX_CAPACITY / 2) + 9);
+    Sim_DmaEvents();
+    SIM_CHECK(Sim_Consume(3, &received));
+
+    /* The stream stops with bytes published and unpublished, it starts over at storage index 0 */
+    Sim_RxDmaRestart();
+    SIM_CHECK(Ring_Buffer_IsEmpty(&g_rx_ring_buffer));
+    SIM_CHECK((g_rx_dma.lap % RX_CAPACITY) == 0);
+
+    Sim_DmaWrite(RX_CAPACITY / 2);
+    Sim_DmaEvents();
+    SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+    SIM_CHECK(received == (RX_CAPACITY / 2));
+    SIM_CHECK(g_expected == g_written);
+
+    return true;
+}
+
+static bool Sim_RandomTraffic (void) {
+    size_t restarts = 0;
+    size_t received = 0;
+
+    for (size_t step = 0; step < RANDOM_STEPS; step++) {
+        uint32_t action = Sim_Random() % 100U;
+
+        if (action < 30U) {
+            Sim_DmaWrite(1U + (Sim_Random() % RX_CAPACITY));
+        } else if (action < 50U) {
+            Sim_DmaEvents();
+        } else if (action < 60U) {
+            /* IDLE or the RTS poll */
+            Sim_RxDmaSync(false);
+        } else if (action < 99U) {
+            SIM_CHECK(Sim_Consume(1U + (Sim_Random() % RX_CAPACITY), &received));
+        } else if ((Sim_Random() % 100U) == 0) {
+            Sim_RxDmaRestart();
+            restarts++;
+        }
+    }
+
+    /* Everything left is published and read */
+    Sim_DmaEvents();
+    Sim_RxDmaSync(false);
+
+    while (true) {
+        SIM_CHECK(Sim_Consume(RX_CAPACITY, &received));
+
+        if (received == 0) {
+            break;
+        }
+    }
+
+    SIM_CHECK(g_expected == g_written);
+
+    printf("    %lu steps, %zu bytes published, %zu overruns, %zu bytes read after the DMA lapped them, %zu restarts\n", RANDOM_STEPS, g_published, g_ring_overflows, g_lapped_reads, restarts);
+
+    return true;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    bool has_failed = false;
+
+    for (size_t sim = 0; sim < (sizeof(g_sim_cases) / sizeof(g_sim_cases[0])); sim++) {
+        Sim_Reset();
+
+        bool is_passed = g_sim_cases[sim].run();
+
+        printf("%-34s %s\n", g_sim_cases[sim].name, is_passed ? "ok" : "FAILED");
+
+        if (!is_passed) {
+            has_failed = true;
+        }
+    }
+
+    if (has_failed) {
+        printf("FAIL\n");
+
+        return 1;
+    }
+
+    printf("pass\n");
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * Host simulation of DMA reception with RTS flow control and a stalled consumer.
+ *
+ * One step is one byte time on the line. The DMA writes the ring storage and counts NDTR down, HT, TC and IDLE sync the
+ * ring head and check the RTS watermarks through uart_rx_ring.c like UART_Driver_RxDmaSync does. The sender honours
+ * RTS only after SENDER_LATENCY byte times, the bytes in its FIFO and on the wire still arrive. The consumer drains the
+ * ring, stalls for STALL_LENGTH byte times and resumes.
+ * Every stall start offset within a ring lap is run with and without the UART_RTS_POLL_MS poll and for each high
+ * watermark, the runs with the poll must not lose a byte.
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include "ring_buffer.h"
+#include "uart_rx_ring.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define RX_CAPACITY 256U
+#define RTS_LOW_WATERMARK_PERCENT 25U
+
+/* 1 ms at 115200 baud */
+#define POLL_PERIOD 12U
+/* USB serial adapters keep sending their FIFO after RTS is released */
+#define SENDER_LATENCY 16U
+#define STALL_LENGTH (4U * RX_CAPACITY)
+#define RUN_LENGTH (16U * RX_CAPACITY)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sSimResult {
+    size_t lost;
+    size_t overruns;
+    size_t peak_fill;
+} sSimResult_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+RING_BUFFER_DEFINE_WITH_POLICY(g_rx_ring_buffer, RX_CAPACITY, eRingBufferPolicy_Overwrite);
+
+static sUartRxDma_t g_rx_dma = {0};
+static size_t g_ndtr = RX_CAPACITY;
+static bool g_is_tc_pending = false;
+static bool g_is_rts_released = false;
+static uint32_t g_rts_high_watermark_percent = 0;
+static size_t g_overruns = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Reset (void);
+static void Sim_DmaWrite (const uint8_t byte);
+static void Sim_RxDmaSync (const bool is_lap_complete);
+static void Sim_RtsAssert (void);
+static sSimResult_t Sim_Run (const size_t stall_start, const bool is_polled);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Sim_Reset (void) {
+    UART_Rx_Ring_DmaStart(&g_rx_dma, &g_rx_ring_buffer);
+
+    g_ndtr = RX_CAPACITY;
+    g_is_tc_pending = false;
+    g_is_rts_released = false;
+    g_overruns = 0;
+
+    return;
+}
+
+static void Sim_DmaWrite (const uint8_t byte) {
+    Ring_Buffer_GetStorage(&g_rx_ring_buffer)[RX_CAPACITY - g_ndtr] = byte;
+
+    g_ndtr--;
+
+    if (g_ndtr == 0) {
+        g_ndtr = RX_CAPACITY;
+        g_is_tc_pending = true;
+    }
+
+    return;
+}
+
+/* UART_Driver_RxDmaPublish and UART_Driver_RtsRelease */
+static void Sim_RxDmaSync (const bool is_lap_complete) {
+    bool is_overrun = false;
+
+    UART_Rx_Ring_DmaSync(&g_rx_dma, g_ndtr, is_lap_complete, &is_overrun);
+
+    if (is_overrun) {
+        g_overruns++;
+    }
+
+    if (!g_is_rts_released && UART_Rx_Ring_IsAboveWatermark(&g_rx_ring_buffer, g_rts_high_watermark_percent)) {
+        g_is_rts_released = true;
+    }
+
+    return;
+}
+
+/* UART_Driver_RtsAssert */
+static void Sim_RtsAssert (void) {
+    if (g_is_rts_released && UART_Rx_Ring_IsBelowWatermark(&g_rx_ring_buffer, RTS_LOW_WATERMARK_PERCENT)) {
+        g_is_rts_released = false;
+    }
+
+    return;
+}
+
+static sSimResult_t Sim_Run (const size_t stall_start, const bool is_polled) {
+    bool rts_history[SENDER_LATENCY] = {false};
+    sSimResult_t result = {0};
+    size_t sent = 0;
+    size_t received = 0;
+    uint8_t expected = 0;
+    bool was_sending = false;
+
+    Sim_Reset();
+
+    for (size_t step = 0; step < RUN_LENGTH; step++) {
+        bool is_rts_seen = rts_history[step % SENDER_LATENCY];
+
+        rts_history[step % SENDER_LATENCY] = g_is_rts_released;
+
+        /* The line, then the DMA interrupts at the priority of the USART */
+        if (!is_rts_seen) {
+            Sim_DmaWrite((uint8_t) sent++);
+
+            /* The bytes the DMA wrote that the consumer did not read yet, published or not */
+            if ((sent - received) > result.peak_fill) {
+                result.peak_fill = sent - received;
+            }
+
+            if ((g_ndtr == (RX_CAPACITY / 2)) || g_is_tc_pending) {
+                bool is_lap_complete = g_is_tc_pending;
+
+                g_is_tc_pending = false;
+
+                Sim_RxDmaSync(is_lap_complete);
+            }
+        } else if (was_sending) {
+            Sim_RxDmaSync(false);
+        }
+
+        was_sending = !is_rts_seen;
+
+        if (is_polled && ((step % POLL_PERIOD) == 0)) {
+            Sim_RxDmaSync(false);
+        }
+
+        if ((step >= stall_start) && (step < (stall_start + STALL_LENGTH))) {
+            continue;
+        }
+
+        /* UART_Driver_ReceiveByte, the consumer polls once the ring looks empty */
+        uint8_t byte = 0;
+        bool is_received = Ring_Buffer_Pop(&g_rx_ring_buffer, &byte);
+
+        if (!is_received && is_polled) {
+            Sim_RxDmaSync(false);
+
+            is_received = Ring_Buffer_Pop(&g_rx_ring_buffer, &byte);
+        }
+
+        while (is_received) {
+            /* A lost byte shows up as a gap in the sequence */
+            uint8_t gap = (uint8_t) (byte - expected);
+
+            result.lost += gap;
+            received += gap + 1U;
+            expected = byte + 1;
+
+            Sim_RtsAssert();
+
+            is_received = Ring_Buffer_Pop(&g_rx_ring_buffer, &byte);
+        }
+    }
+
+    result.overruns = g_overruns;
+
+    return result;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+int main (void) {
+    const uint32_t high_watermark_percents[] = {50U, 75U};
+    bool has_failed = false;
+
+    for (size_t watermark = 0; watermark < (sizeof(high_watermark_percents) / sizeof(high_watermark_percents[0])); watermark++) {
+        g_rts_high_watermark_percent = high_watermark_percents[watermark];
+
+        for (size_t is_polled = 0; is_polled < 2; is_polled++) {
+            sSimResult_t worst = {0};
+            size_t failed_starts = 0;
+
+            for (size_t offset = 0; offset < RX_CAPACITY; offset++) {
+                sSimResult_t result = Sim_Run((2U * RX_CAPACITY) + offset, is_polled);
+
+                if ((result.lost > 0) || (result.overruns > 0)) {
+                    failed_starts++;
+                }
+
+                if (result.lost > worst.lost) {
+                    worst.lost = result.lost;
+                }
+
+                if (result.peak_fill > worst.peak_fill) {
+                    worst.peak_fill = result.peak_fill;
+                }
+            }
+
+            printf("high watermark %2lu%%, %-16s peak fill %3zu of %u, %3zu of %u stall offsets lose data, worst %zu bytes\n", (unsigned long) high_watermark_percents[watermark], is_polled ? "HT/TC/IDLE+poll:" : "HT/TC/IDLE:", worst.peak_fill, RX_CAPACITY, failed_starts, RX_CAPACITY, worst.lost);
+
+            if (is_polled && (failed_starts > 0)) {
+                has_failed = true;
+            }
+        }
+    }
+
+    if (has_failed) {
+        printf("FAIL: data lost with the poll\n");
+
+        return 1;
+    }
+
+    printf("pass\n");
+
+    return 0;
+}
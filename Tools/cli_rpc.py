@@ -0,0 +1,380 @@
+#!/usr/bin/env python3
+"""Send CLI commands over the binary RPC mode (ENABLE_CLI_RPC) and measure the request throughput.
+
+The CLI command rpc switches the debug UART to COBS encoded, 0x00 delimited frames (little endian, CRC-16/CCITT-FALSE
+over all preceding bytes):
+    request:  'Q', sequence (u16), command id (u16), argument count (u8), arguments (u32 each), argument text, crc (u16)
+    response: 'R', sequence (u16), status (u8), flags (u8), reply text, crc (u16)
+Command id 0 only answers, 0xFFFF returns to text commands. The other ids are the eCliFrameworkCmd values of the
+build, resolved from Source/APP/framework_cli_lut.h/.c and the project config, or given as numbers (project commands
+follow on from eCliFrameworkCmd_Last). Arguments are integers, r,g,b / h,s,v triplets are packed into one word and
+enum arguments take their index. Commands with a raw text handler take --text instead of arguments.
+
+Up to --window requests are kept in flight, the firmware buffers UART_DEBUG_MESSAGE_POOL_SIZE of them. A reply is
+split into frames of RESPONSE_MESSAGE_CAPACITY text, all but the last have the more flag set and the last one carries
+the status. Replies are printed for a single request, errors always go to stderr. Traces of the firmware still arrive
+as text in between the frames, --verbose prints them to stderr.
+
+    cli_rpc.py --port /dev/ttyUSB0 --config platform_config.h led_set 1
+    cli_rpc.py --port /dev/ttyUSB0 --config platform_config.h top
+    cli_rpc.py --port /dev/ttyUSB0 --config platform_config.h --repeat 500 --window 4 hsv 10,255,64
+    cli_rpc.py --port /dev/ttyUSB0 --benchmark 2000 --window 4
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+from trace_decoder import cobs_decode  # noqa: E402
+
+REQUEST_TAG = ord("Q")
+RESPONSE_TAG = ord("R")
+REQUEST_HEADER = struct.Struct("<BHHB")
+RESPONSE_HEADER = struct.Struct("<BHBB")
+FLAG_MORE = 0x01
+PING_ID = 0x0000
+EXIT_ID = 0xFFFF
+ARGUMENTS_MAX = 4
+STATUSES = ("ok", "failed", "frame", "command", "arguments")
+SOURCE = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "Source", "APP")
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+
+    return crc
+
+
+def cobs_encode(data):
+    output = bytearray([0])
+    code_index = 0
+
+    for byte in data:
+        if byte != 0:
+            output.append(byte)
+
+        if byte == 0 or len(output) - code_index == 0xFF:
+            output[code_index] = len(output) - code_index
+            code_index = len(output)
+            output.append(0)
+
+    output[code_index] = len(output) - code_index
+
+    return bytes(output)
+
+
+def encode_request(sequence, command_id, arguments, text=b""):
+    record = REQUEST_HEADER.pack(REQUEST_TAG, sequence, command_id, len(arguments))
+    record += b"".join(struct.pack("<I", argument & 0xFFFFFFFF) for argument in arguments)
+    record += text
+    record += struct.pack("<H", crc16(record))
+
+    return b"\0" + cobs_encode(record) + b"\0"
+
+
+def decode_response(record):
+    """Returns (sequence, status, flags, text) or None for anything that is not an intact response."""
+    if len(record) < RESPONSE_HEADER.size + 2 or record[0] != RESPONSE_TAG:
+        return None
+
+    if crc16(record[:-2]) != struct.unpack_from("<H", record, len(record) - 2)[0]:
+        return None
+
+    _, sequence, status, flags = RESPONSE_HEADER.unpack_from(record)
+
+    return sequence, status, flags, record[RESPONSE_HEADER.size:-2].decode("utf-8", "replace")
+
+
+def parse_argument(text):
+    components = text.split(",")
+
+    if len(components) == 1:
+        return int(text, 0)
+
+    if len(components) != 3:
+        raise ValueError("%s: expected one value or three components" % text)
+
+    value = 0
+
+    for component in components:
+        value = (value << 8) | (int(component, 0) & 0xFF)
+
+    return value
+
+
+def evaluate_condition(expression, defines):
+    """Enough of #if for the config files: defined(), !, && and ||, other identifiers count as 0."""
+    expression = re.sub(r"defined\s*\(?\s*(\w+)\s*\)?", lambda match: "1" if match.group(1) in defines else "0", expression)
+    expression = expression.replace("&&", " and ").replace("||", " or ")
+    expression = re.sub(r"!(?!=)", " not ", expression)
+    expression = re.sub(r"\b(?!and\b|or\b|not\b)[A-Za-z_]\w*", "0", expression)
+
+    try:
+        return bool(eval(expression, {"__builtins__": {}}))
+    except (SyntaxError, NameError, TypeError):
+        return False
+
+
+def read_defines(config_path):
+    """Names the config defines, following its #if blocks."""
+    defines = set()
+    conditions = []
+
+    with open(config_path) as config:
+        for line in config:
+            directive = re.match(r"\s*#\s*(ifdef|ifndef|if|else|endif|define)\b\s*(.*)", line.split("//", 1)[0])
+
+            if not directive:
+                continue
+
+            keyword, rest = directive.groups()
+
+            if keyword == "ifdef":
+                conditions.append(rest.strip() in defines)
+            elif keyword == "ifndef":
+                conditions.append(rest.strip() not in defines)
+            elif keyword == "if":
+                conditions.append(evaluate_condition(rest, defines))
+            elif keyword == "else":
+                conditions[-1] = not conditions[-1]
+            elif keyword == "endif":
+                conditions.pop()
+            elif all(conditions):
+                defines.add(rest.split()[0])
+
+    return defines
+
+
+def command_ids(defines):
+    """Maps command strings to eCliFrameworkCmd values, evaluating the #ifdef blocks of the enum."""
+    enum_ids = {}
+    conditions = []
+    value = 0
+
+    with open(os.path.join(SOURCE, "framework_cli_lut.h")) as header:
+        body = header.read().split("typedef enum eCliFrameworkCmd", 1)[1].split("}", 1)[0]
+
+    for line in body.splitlines():
+        line = line.split("//", 1)[0].strip()
+        directive = re.match(r"#\s*(ifdef|ifndef|else|endif)\s*(\w*)", line)
+
+        if directive:
+            keyword, name = directive.groups()
+
+            if keyword == "ifdef":
+                conditions.append(name in defines)
+            elif keyword == "ifndef":
+                conditions.append(name not in defines)
+            elif keyword == "else":
+                conditions[-1] = not conditions[-1]
+            else:
+                conditions.pop()
+
+            continue
+
+        match = re.match(r"(eCliFrameworkCmd_\w+)\s*(?:=\s*(\w+))?\s*,?", line)
+
+        if not match or not all(conditions):
+            continue
+
+        if match.group(2):
+            value = enum_ids.get(match.group(2), 0) if not match.group(2).isdigit() else int(match.group(2))
+
+        enum_ids[match.group(1)] = value
+        value += 1
+
+    with open(os.path.join(SOURCE, "framework_cli_lut.c")) as source:
+        text = source.read()
+
+    ids = {}
+
+    for enum_name, command in re.findall(r"\[(eCliFrameworkCmd_\w+)\]\s*=\s*\{\s*DEFINE_CMD\(\"([^\"]+)\"\)", text):
+        if enum_name in enum_ids:
+            ids[command.rstrip(":")] = enum_ids[enum_name]
+
+    return ids
+
+
+class Link:
+    def __init__(self, port, baud, verbose):
+        import serial
+
+        self.serial = serial.Serial(port, baud, timeout=0.01)
+        self.pending = bytearray()
+        self.verbose = verbose
+
+    def enter(self, attempts=10):
+        # A board left in RPC mode is sent back to text first
+        self.serial.write(encode_request(0, EXIT_ID, []))
+        time.sleep(0.05)
+        self.serial.write(b"\r\nrpc\r\n")
+
+        # The answer to the exit request carries sequence 0
+        for sequence in range(1, attempts + 1):
+            self.serial.write(encode_request(sequence, PING_ID, []))
+
+            deadline = time.monotonic() + 0.2
+
+            while time.monotonic() < deadline:
+                for response in self.responses():
+                    if response[0] == sequence:
+                        return True
+
+        return False
+
+    def leave(self):
+        self.serial.write(encode_request(0, EXIT_ID, []))
+        self.serial.flush()
+
+    def responses(self):
+        self.pending += self.serial.read(max(1, self.serial.in_waiting))
+
+        while True:
+            end = self.pending.find(b"\0")
+
+            if end < 0:
+                return
+
+            frame = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+
+            if not frame:
+                continue
+
+            response = None
+
+            try:
+                response = decode_response(cobs_decode(frame))
+            except ValueError:
+                pass
+
+            if response is not None:
+                yield response
+            elif self.verbose:
+                sys.stderr.write(frame.decode("utf-8", "replace"))
+
+    def run(self, command_id, arguments, count, window, text=b"", echo=False, timeout=1.0):
+        """Sends count requests with up to window in flight, returns ({status: count}, lost, seconds, latencies)."""
+        in_flight = {}
+        replies = {}
+        statuses = {}
+        latencies = []
+        sent = 0
+        lost = 0
+        start = time.monotonic()
+
+        while sent < count or in_flight:
+            while sent < count and len(in_flight) < window:
+                sequence = sent & 0xFFFF
+                self.serial.write(encode_request(sequence, command_id, arguments, text))
+                in_flight[sequence] = (time.monotonic(), time.monotonic())
+                sent += 1
+
+            for sequence, status, flags, reply in self.responses():
+                if sequence not in in_flight:
+                    continue
+
+                replies[sequence] = replies.get(sequence, "") + reply
+
+                # Every frame of a long reply restarts the timeout, the latency counts to the last one
+                if flags & FLAG_MORE:
+                    in_flight[sequence] = (in_flight[sequence][0], time.monotonic())
+                    continue
+
+                sent_at, _ = in_flight.pop(sequence)
+                reply = replies.pop(sequence)
+                latencies.append(time.monotonic() - sent_at)
+                statuses[status] = statuses.get(status, 0) + 1
+
+                if status != 0:
+                    sys.stderr.write("#%u %s: %s" % (sequence, STATUSES[status] if status < len(STATUSES) else status, reply))
+                elif echo:
+                    sys.stdout.write(reply)
+
+            now = time.monotonic()
+
+            for sequence in [key for key, (_, heard_at) in in_flight.items() if now - heard_at > timeout]:
+                del in_flight[sequence]
+                replies.pop(sequence, None)
+                lost += 1
+
+        return statuses, lost, time.monotonic() - start, latencies
+
+
+def report(name, count, result):
+    statuses, lost, seconds, latencies = result
+    latencies.sort()
+    median = latencies[len(latencies) // 2] * 1000.0 if latencies else 0.0
+
+    print("%s: %u requests in %.3f s, %.1f req/s, median latency %.2f ms, %u ok, %u lost"
+          % (name, count, seconds, count / seconds if seconds else 0.0, median, statuses.get(0, 0), lost))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", required=True, help="serial port of the debug UART (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--config", help="project config the firmware was built with, needed for command names")
+    parser.add_argument("--window", type=int, default=4, help="requests in flight")
+    parser.add_argument("--repeat", type=int, default=1)
+    parser.add_argument("--benchmark", type=int, metavar="COUNT", help="time COUNT link checks, one at a time and pipelined")
+    parser.add_argument("--stay", action="store_true", help="leave the board in RPC mode")
+    parser.add_argument("--verbose", action="store_true", help="print the text traces in between")
+    parser.add_argument("--text", default="", help="argument text of a command with a raw text handler")
+    parser.add_argument("command", nargs="?", help="command name or id")
+    parser.add_argument("arguments", nargs="*")
+    arguments = parser.parse_args()
+
+    if arguments.benchmark is None and arguments.command is None:
+        parser.error("a command or --benchmark is required")
+
+    command_id = PING_ID
+    values = [parse_argument(argument) for argument in arguments.arguments]
+
+    if len(values) > ARGUMENTS_MAX:
+        parser.error("at most %u arguments" % ARGUMENTS_MAX)
+
+    if arguments.command is not None:
+        try:
+            command_id = int(arguments.command, 0)
+        except ValueError:
+            if arguments.config is None:
+                parser.error("--config is needed to resolve command names")
+
+            ids = command_ids(read_defines(arguments.config))
+
+            if arguments.command not in ids:
+                parser.error("%s: unknown command, known: %s" % (arguments.command, ", ".join(sorted(ids))))
+
+            command_id = ids[arguments.command]
+
+    link = Link(arguments.port, arguments.baud, arguments.verbose)
+
+    if not link.enter():
+        sys.exit("no answer to RPC link checks")
+
+    try:
+        if arguments.benchmark is not None:
+            report("window 1", arguments.benchmark, link.run(PING_ID, [], arguments.benchmark, 1))
+            report("window %u" % arguments.window, arguments.benchmark, link.run(PING_ID, [], arguments.benchmark, arguments.window))
+
+        if arguments.command is not None:
+            result = link.run(command_id, values, arguments.repeat, arguments.window, arguments.text.encode("utf-8"), arguments.repeat == 1)
+            report(arguments.command, arguments.repeat, result)
+    finally:
+        if not arguments.stay:
+            link.leave()
+
+
+if __name__ == "__main__":
+    main()
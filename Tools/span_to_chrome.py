@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Convert a span trace dump (ENABLE_SPAN_TRACE, CLI command trace_dump) to Chrome trace JSON.
+
+The dump arrives COBS encoded and 0x00 delimited on the debug UART, interleaved with any other output:
+    header: 'H', magic "SPAN" (u32), clock Hz (u32), thread count (u32), event count (u32), overwritten events (u32)
+    thread: 'T', thread id (u32), thread name text
+    event:  'S', type (u8), timestamp cycles (u32), name (u32), thread id (u32), value (u32)
+Span names are addresses of string literals, resolved from the firmware ELF like Tools/trace_decoder.py does.
+Open the output in https://ui.perfetto.dev or chrome://tracing.
+
+    span_to_chrome.py --elf build/firmware.elf --port /dev/ttyUSB0 --output trace.json
+    span_to_chrome.py --elf build/firmware.elf --input capture.bin --output trace.json
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+from trace_decoder import ElfStrings, TableStrings, cobs_decode, frames  # noqa: E402
+
+HEADER = struct.Struct("<BIIIII")
+EVENT = struct.Struct("<BBIIII")
+MAGIC = 0x4E415053
+PHASES = ("B", "E", "C", "b", "e")
+PROCESS_ID = 1
+
+
+def read_dump(stream):
+    """Returns (clock_hz, overwritten, threads, events) of the first complete dump in the stream."""
+    header = None
+    threads = {}
+    events = []
+
+    for frame in frames(stream):
+        try:
+            record = cobs_decode(frame)
+        except ValueError:
+            continue
+
+        if len(record) == HEADER.size and record[0] == ord("H"):
+            tag, magic, clock_hz, thread_count, event_count, overwritten = HEADER.unpack(record)
+
+            if magic == MAGIC:
+                header = (clock_hz, thread_count, event_count, overwritten)
+                threads = {}
+                events = []
+
+                if event_count == 0:
+                    break
+
+            continue
+
+        if header is None:
+            continue
+
+        if len(threads) < header[1] and len(record) >= 5 and record[0] == ord("T"):
+            threads[struct.unpack_from("<I", record, 1)[0]] = record[5:].decode("utf-8", "replace")
+        elif len(record) == EVENT.size and record[0] == ord("S"):
+            events.append(EVENT.unpack(record)[1:])
+
+            if len(events) == header[2]:
+                break
+
+    if header is None:
+        raise ValueError("no span dump found")
+
+    if len(events) != header[2]:
+        sys.stderr.write("warning: dump truncated, %u of %u events\n" % (len(events), header[2]))
+
+    return header[0], header[3], threads, events
+
+
+def convert(clock_hz, threads, events, strings):
+    trace = []
+    elapsed = 0
+    previous = None
+
+    for event_type, timestamp, name_address, thread, value in events:
+        # 32-bit cycle counter, events are close enough in time that a signed delta unwraps it
+        if previous is not None:
+            delta = (timestamp - previous) & 0xFFFFFFFF
+            elapsed += delta - 0x100000000 if delta >= 0x80000000 else delta
+
+        previous = timestamp
+
+        if event_type >= len(PHASES):
+            continue
+
+        name = strings.get(name_address) or "0x%08x" % name_address
+        entry = {"name": name, "ph": PHASES[event_type], "ts": elapsed * 1e6 / clock_hz, "pid": PROCESS_ID, "tid": thread}
+
+        if PHASES[event_type] == "C":
+            entry["args"] = {"value": value}
+        elif PHASES[event_type] in ("b", "e"):
+            entry["cat"] = "async"
+            entry["id"] = value
+
+        trace.append(entry)
+
+    for thread, thread_name in threads.items():
+        trace.append({"name": "thread_name", "ph": "M", "pid": PROCESS_ID, "tid": thread, "args": {"name": thread_name}})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--elf", help="firmware ELF the dump was produced by")
+    source.add_argument("--table", help="JSON table of string addresses")
+    parser.add_argument("--input", help="captured byte stream, default stdin")
+    parser.add_argument("--port", help="serial port to read from (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--output", help="JSON file to write, default stdout")
+    arguments = parser.parse_args()
+
+    strings = ElfStrings(arguments.elf) if arguments.elf else TableStrings(arguments.table)
+
+    if arguments.port:
+        import serial
+
+        stream = serial.Serial(arguments.port, arguments.baud, timeout=None)
+    elif arguments.input:
+        stream = open(arguments.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    clock_hz, overwritten, threads, events = read_dump(stream)
+
+    if overwritten:
+        sys.stderr.write("note: %u older events were overwritten before the dump\n" % overwritten)
+
+    output = open(arguments.output, "w") if arguments.output else sys.stdout
+    json.dump(convert(clock_hz, threads, events, strings), output)
+    output.write("\n")
+
+
+if __name__ == "__main__":
+    main()
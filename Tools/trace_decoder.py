@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""Decode deferred trace records (ENABLE_DEBUG_DEFERRED) back into text.
+
+Records arrive COBS encoded and 0x00 delimited on the debug UART:
+    format (u32), module (u32), timestamp cycles (u32), line (u16), level (u8), packed arguments
+Format and module name are addresses of string literals, resolved from the firmware ELF
+or from a JSON table {"0x08001234": "text", ...}.
+
+Timestamps are DWT cycle counts. Each flush starts with a sync record carrying the kernel tick,
+so thread and TRACE_ISR records are printed as milliseconds on a common time base.
+CLI replies (Debug_API_Write) arrive as text records and are printed as they are.
+
+    trace_decoder.py --elf build/firmware.elf --port /dev/ttyUSB0 --baud 115200
+    trace_decoder.py --elf build/firmware.elf --input capture.bin --clock-hz 100000000
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+HEADER = struct.Struct("<IIIHB")
+LEVELS = ("INF", "WRN", "ERR", "ISR")
+DROPPED_FORMAT = 0
+SYNC_FORMAT = 1
+TEXT_FORMAT = 2
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|t|j|L)?([diuxXoceEfFgGaApsn%])")
+
+
+class ElfStrings:
+    """Reads NUL terminated strings from the allocated sections of a 32-bit little endian ELF."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            self.data = elf.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError("%s: not a 32-bit little endian ELF" % path)
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+
+        for index in range(shnum):
+            _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from("<IIIIII", self.data, shoff + index * shentsize)
+
+            # SHT_PROGBITS with SHF_ALLOC
+            if sh_type == 1 and (sh_flags & 0x2) and sh_size:
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+    def get(self, address):
+        for sh_addr, sh_offset, sh_size in self.sections:
+            if sh_addr <= address < sh_addr + sh_size:
+                start = sh_offset + (address - sh_addr)
+                end = self.data.find(b"\0", start, sh_offset + sh_size)
+
+                if end < 0:
+                    return None
+
+                return self.data[start:end].decode("utf-8", "replace")
+
+        return None
+
+
+class TableStrings:
+    def __init__(self, path):
+        with open(path) as table:
+            self.table = {int(key, 0): value for key, value in json.load(table).items()}
+
+    def get(self, address):
+        return self.table.get(address)
+
+
+def cobs_decode(frame):
+    output = bytearray()
+    index = 0
+
+    while index < len(frame):
+        code = frame[index]
+
+        if code == 0 or index + code > len(frame):
+            raise ValueError("invalid COBS frame")
+
+        output += frame[index + 1:index + code]
+        index += code
+
+        if code < 0xFF and index < len(frame):
+            output.append(0)
+
+    return bytes(output)
+
+
+def render(format_string, payload):
+    """Mirror of Debug_API_PackArguments: consume the payload in conversion order."""
+    offset = 0
+    output = []
+    position = 0
+
+    def take(size):
+        nonlocal offset
+
+        if offset + size > len(payload):
+            raise IndexError
+
+        value = payload[offset:offset + size]
+        offset += size
+
+        return value
+
+    for match in CONVERSION.finditer(format_string):
+        output.append(format_string[position:match.start()])
+        position = match.end()
+        flags, width, precision, length, conversion = match.groups()
+
+        if conversion == "%":
+            output.append("%")
+            continue
+
+        try:
+            if width == "*":
+                width = str(struct.unpack("<i", take(4))[0])
+
+            if precision == "*":
+                precision = str(struct.unpack("<i", take(4))[0])
+
+            spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+
+            if conversion in "diuxXoc":
+                size = 8 if length in ("ll", "j") else 4
+                value = int.from_bytes(take(size), "little", signed=(conversion in "di"))
+
+                if conversion == "c":
+                    output.append((spec + "c") % chr(value & 0xFF))
+                else:
+                    output.append((spec + conversion.replace("u", "d")) % value)
+            elif conversion in "eEfFgGaA":
+                value = struct.unpack("<d", take(8))[0]
+                output.append(value.hex() if conversion in "aA" else (spec + conversion) % value)
+            elif conversion == "p":
+                output.append("0x%08x" % struct.unpack("<I", take(4))[0])
+            elif conversion == "s":
+                string_length = take(1)[0]
+                output.append((spec + "s") % take(string_length).decode("utf-8", "replace"))
+        except IndexError:
+            output.append("<?>")
+
+    output.append(format_string[position:])
+
+    return "".join(output)
+
+
+class Clock:
+    """Maps 32-bit cycle counts to milliseconds using the last sync record."""
+
+    def __init__(self, clock_hz):
+        self.cycles_per_ms = clock_hz / 1000.0
+        self.sync_cycles = None
+        self.sync_ms = 0
+
+    def sync(self, cycles, milliseconds):
+        self.sync_cycles = cycles
+        self.sync_ms = milliseconds
+
+    def to_ms(self, cycles):
+        if self.sync_cycles is None:
+            return cycles / self.cycles_per_ms
+
+        # Records queued before the sync are older, the wrap aware difference keeps them negative
+        delta = (cycles - self.sync_cycles) & 0xFFFFFFFF
+
+        if delta >= 0x80000000:
+            delta -= 0x100000000
+
+        return self.sync_ms + delta / self.cycles_per_ms
+
+
+def decode_record(record, strings, clock):
+    if len(record) < HEADER.size:
+        return "<short record: %s>\n" % record.hex()
+
+    format_address, module_address, timestamp, line, level = HEADER.unpack_from(record)
+    payload = record[HEADER.size:]
+    milliseconds = clock.to_ms(timestamp)
+
+    if format_address == DROPPED_FORMAT:
+        dropped, = struct.unpack_from("<I", payload) if len(payload) >= 4 else (0,)
+
+        return "%10.3f [TRACE.WRN] %u records dropped\n" % (milliseconds / 1000.0, dropped)
+
+    if format_address == SYNC_FORMAT:
+        if len(payload) >= 4:
+            clock.sync(timestamp, struct.unpack_from("<I", payload)[0])
+
+        return ""
+
+    if format_address == TEXT_FORMAT:
+        return payload.decode("utf-8", "replace")
+
+    format_string = strings.get(format_address)
+    module = strings.get(module_address) if module_address else None
+
+    if format_string is None:
+        text = "<unknown format 0x%08x: %s>\n" % (format_address, payload.hex())
+    else:
+        text = render(format_string, payload)
+
+    level_name = LEVELS[level] if level < len(LEVELS) else "L%u" % level
+    prefix = "[%s.%s]" % (module or "?", level_name)
+
+    if level_name in ("ERR", "ISR"):
+        prefix += " (line: %u)" % line
+
+    return "%10.3f %s %s" % (milliseconds / 1000.0, prefix, text)
+
+
+def frames(stream):
+    pending = bytearray()
+
+    while True:
+        chunk = stream.read(256)
+
+        if not chunk:
+            break
+
+        pending += chunk
+
+        while True:
+            end = pending.find(b"\0")
+
+            if end < 0:
+                break
+
+            frame = bytes(pending[:end])
+            del pending[:end + 1]
+
+            if frame:
+                yield frame
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--elf", help="firmware ELF the records were produced by")
+    source.add_argument("--table", help="JSON table of string addresses")
+    parser.add_argument("--input", help="captured byte stream, default stdin")
+    parser.add_argument("--port", help="serial port to read from (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--clock-hz", type=int, default=100000000, help="core clock driving the DWT cycle counter")
+    arguments = parser.parse_args()
+
+    strings = ElfStrings(arguments.elf) if arguments.elf else TableStrings(arguments.table)
+    clock = Clock(arguments.clock_hz)
+
+    if arguments.port:
+        import serial
+
+        stream = serial.Serial(arguments.port, arguments.baud, timeout=None)
+    elif arguments.input:
+        stream = open(arguments.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    for frame in frames(stream):
+        try:
+            sys.stdout.write(decode_record(cobs_decode(frame), strings, clock))
+        except ValueError as error:
+            sys.stdout.write("<%s: %s>\n" % (error, frame.hex()))
+
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()